@@ -0,0 +1,58 @@
+/**
+ * @file boot_profile.c
+ * @brief TSC timestamps of the kernel initialization stages.
+ */
+
+#include <boot_profile.h>
+#include <devices.h>
+#include <utils.h>
+
+struct boot_mark {
+    const char *stage;
+    unsigned long long tsc;
+};
+
+static struct boot_mark boot_marks[BOOT_STAGES_MAX];
+static int boot_nr_marks = 0;
+
+void boot_stage(const char *stage) {
+#if BOOT_PROFILE
+    if (boot_nr_marks == BOOT_STAGES_MAX) return;
+
+    unsigned int low, high;
+    rdtsc(low, high);
+    boot_marks[boot_nr_marks].stage = stage;
+    boot_marks[boot_nr_marks].tsc = ((unsigned long long)high << 32) | low;
+    boot_nr_marks++;
+#else
+    (void)stage;
+#endif
+}
+
+static void debug_puts(const char *s) {
+    int len = 0;
+    while (s[len]) len++;
+    sys_write_debug((char *)s, len);
+}
+
+/* Print a cycle count, saturated to 32 bits */
+static void debug_cycles(unsigned long long cycles) {
+    char buffer[12];
+    utoa((cycles >> 32) ? 0xffffffff : (unsigned int)cycles, buffer);
+    debug_puts(buffer);
+}
+
+void boot_profile_dump(void) {
+    unsigned long long prev = 0;
+
+    for (int i = 0; i < boot_nr_marks; i++) {
+        debug_puts("@boot ");
+        debug_cycles(boot_marks[i].tsc);
+        debug_puts(" ");
+        debug_cycles(boot_marks[i].tsc - prev);
+        debug_puts(" ");
+        debug_puts(boot_marks[i].stage);
+        debug_puts("\n");
+        prev = boot_marks[i].tsc;
+    }
+}
@@ -0,0 +1,262 @@
+/**
+ * @file clock.c
+ * @brief TSC calibration, clock interrupt rate and the monotonic clock.
+ */
+
+#include <clock.h>
+#include <errno.h>
+#include <hardware.h>
+#include <interrupt.h>
+#include <io.h>
+#include <lapic.h>
+#include <pit.h>
+#include <sched.h>
+#include <spinlock.h>
+#include <times.h>
+#include <utils.h>
+#include <vdso.h>
+
+unsigned int tsc_khz = CYCLESPERTICK;
+
+/* Clock interrupts per second */
+static int tick_hz = BASE_TICKS_PER_SECOND;
+
+/* Monotonic time of the last rate change, the tick it happened at, and the last value read */
+static unsigned long long base_us = 0;
+static unsigned int base_ticks = 0;
+static unsigned long long last_us = 0;
+
+/* One-shot mode: APIC timer clocks per ms and TSC cycles per tick */
+static int oneshot = 0;
+static unsigned int lapic_khz = 0;
+static unsigned int tick_cycles = 0;
+
+/* TSC time at which the next tick is due, and the one the timer is armed for */
+static unsigned long long next_tick_tsc = 0;
+static unsigned long long armed_tsc = 0;
+
+/* 1 while the idle task has the timer armed beyond the next tick */
+static int tick_stopped = 0;
+
+static struct clock_stats stats;
+
+static spinlock_t clock_lock = SPINLOCK_INIT;
+
+static unsigned long long read_tsc(void) {
+    unsigned int low, high;
+    rdtsc(low, high);
+    return ((unsigned long long)high << 32) | low;
+}
+
+/* Arm the APIC timer to fire at TSC time deadline */
+static void arm(unsigned long long deadline) {
+    unsigned long long now = read_tsc();
+    unsigned long long count = (deadline > now) ? deadline - now : 1;
+
+    /* Round up: an early interrupt only re-arms, a late one delays the tick */
+    count = count * lapic_khz + tsc_khz - 1;
+    do_div(count, tsc_khz);
+
+    armed_tsc = deadline;
+    lapic_timer_oneshot((count >> 32) ? 0xffffffff : (count == 0) ? 1 : (unsigned int)count);
+}
+
+/* Whole ticks due at TSC time now; moves next_tick_tsc past them */
+static unsigned int catch_up(unsigned long long now) {
+    if (now < next_tick_tsc) return 0;
+
+    unsigned long long late = now - next_tick_tsc;
+    do_div(late, tick_cycles);
+    unsigned int ticks = 1 + (unsigned int)late;
+    next_tick_tsc += (unsigned long long)ticks * tick_cycles;
+    return ticks;
+}
+
+/* TSC cycles in a tick at hz ticks per second */
+static unsigned int cycles_per_tick(int hz) {
+    unsigned long long cycles = (unsigned long long)tsc_khz * 1000;
+    do_div(cycles, hz);
+    return (unsigned int)cycles;
+}
+
+/* APIC timer clocks in CLOCK_CALIBRATE_MS, timed with the calibrated TSC */
+static unsigned int calibrate_lapic(void) {
+    unsigned long long end = read_tsc() + (unsigned long long)tsc_khz * CLOCK_CALIBRATE_MS;
+
+    lapic_timer_oneshot(0xffffffff);
+    while (read_tsc() < end) {
+    }
+    unsigned int left = lapic_timer_count();
+    lapic_timer_oneshot(0);
+
+    return (0xffffffff - left) / CLOCK_CALIBRATE_MS;
+}
+
+void init_clock(void) {
+    unsigned int khz = pit_calibrate_tsc(CLOCK_CALIBRATE_MS);
+    if (khz != 0) tsc_khz = khz;
+
+    pit_set_rate(BASE_TICKS_PER_SECOND);
+    tick_hz = (PIT_INPUT_HZ + pit_reload / 2) / pit_reload;
+}
+
+void clock_start_oneshot(void) {
+#if CLOCK_ONESHOT
+    if (!init_lapic()) return;
+
+    unsigned int khz = calibrate_lapic();
+    if (khz == 0) return;
+
+    lapic_khz = khz;
+    tick_cycles = cycles_per_tick(tick_hz);
+    oneshot = 1;
+
+    /* The PIT keeps counting but no longer interrupts */
+    pic_mask |= PIC_IRQ_TIMER;
+
+    next_tick_tsc = read_tsc() + tick_cycles;
+    arm(next_tick_tsc);
+
+    printk_color_fmt(INFO_COLOR, "CLOCK: local APIC timer at %d kHz, one-shot ticks\n", lapic_khz);
+#endif
+}
+
+int ticks_per_second(void) {
+    return tick_hz;
+}
+
+/* Microseconds since boot; the caller holds clock_lock or runs with interrupts off */
+static unsigned long long monotonic_us(void) {
+    unsigned int ticks = zeos_ticks - base_ticks, low, high;
+    unsigned int tick_us = 1000000 / tick_hz;
+
+    rdtsc(low, high);
+    (void)high;
+
+    /* Whole ticks since the last rate change, then the TSC cycles since the last one */
+    unsigned long long us = (unsigned long long)ticks * 1000000;
+    do_div(us, tick_hz);
+
+    if (vdso_page.data.tsc_last_tick != 0) {
+        unsigned long long since = (unsigned long long)(low - vdso_page.data.tsc_last_tick) * 1000;
+        do_div(since, tsc_khz);
+        us += (since < tick_us) ? since : tick_us - 1;
+    }
+
+    /* Shortening the tick also shortens the interpolation cap: never go back */
+    us += base_us;
+    if (us < last_us) us = last_us;
+    last_us = us;
+    return us;
+}
+
+int clock_set_rate(int hz) {
+    if (hz < CLOCK_MIN_HZ || hz > CLOCK_MAX_HZ) return -EINVAL;
+
+    unsigned long flags = spin_lock_irqsave(&clock_lock);
+    int old = tick_hz;
+
+    /* Count the following ticks from now, at the new length */
+    base_us = monotonic_us();
+    base_ticks = zeos_ticks;
+
+    if (oneshot) {
+        tick_hz = hz;
+        tick_cycles = cycles_per_tick(hz);
+        next_tick_tsc = read_tsc() + tick_cycles;
+        tick_stopped = 0;
+        arm(next_tick_tsc);
+    } else {
+        pit_set_rate(hz);
+        tick_hz = (PIT_INPUT_HZ + pit_reload / 2) / pit_reload;
+    }
+    vdso_clock_update();
+
+    spin_unlock_irqrestore(&clock_lock, flags);
+    return old;
+}
+
+unsigned int clock_advance(void) {
+    unsigned int ticks = 1;
+
+    if (oneshot) {
+        ticks = catch_up(read_tsc());
+        tick_stopped = 0;
+        arm(next_tick_tsc);
+    }
+
+    stats.timer_irqs++;
+    if (ticks > 1) stats.ticks_skipped += ticks - 1;
+    return ticks;
+}
+
+void clock_timer_routine(unsigned long *regs) {
+    lapic_eoi();
+
+    /* Fired before its deadline (rounding, or re-armed while pending): wait for it */
+    if (read_tsc() < armed_tsc) {
+        arm(armed_tsc);
+        return;
+    }
+
+    clock_routine(regs);
+}
+
+void clock_nohz_idle(void) {
+    if (!oneshot) return;
+
+    unsigned long flags = spin_lock_irqsave(&clock_lock);
+
+    if (!tick_stopped) {
+        int ticks = sched_idle_ticks();
+        int max = tick_hz * CLOCK_NOHZ_MAX_MS / 1000;
+
+        if (ticks > max) ticks = max;
+        if (ticks > 1) {
+            tick_stopped = 1;
+            stats.idle_stops++;
+            arm(next_tick_tsc + (unsigned long long)(ticks - 1) * tick_cycles);
+        }
+    }
+
+    spin_unlock_irqrestore(&clock_lock, flags);
+}
+
+void clock_nohz_exit(void) {
+    if (!tick_stopped) return;
+    tick_stopped = 0;
+
+    unsigned int ticks = catch_up(read_tsc());
+    if (ticks != 0) {
+        zeos_ticks += ticks;
+        stats.ticks_skipped += ticks;
+        vdso_tick();
+    }
+    arm(next_tick_tsc);
+}
+
+unsigned int clock_irq_delay(void) {
+    if (!oneshot) return pit_elapsed();
+
+    unsigned long long late = read_tsc();
+    late = (late > armed_tsc) ? (late - armed_tsc) * (PIT_INPUT_HZ / 1000) : 0;
+    do_div(late, tsc_khz);
+    return (late >> 32) ? 0xffffffff : (unsigned int)late;
+}
+
+void clock_get_stats(struct clock_stats *out) {
+    stats.hz = tick_hz;
+    stats.oneshot = oneshot;
+    stats.lapic_khz = lapic_khz;
+    copy_data(&stats, out, sizeof(struct clock_stats));
+}
+
+void clock_monotonic(struct timespec *ts) {
+    unsigned long flags = spin_lock_irqsave(&clock_lock);
+    unsigned long long sec = monotonic_us();
+    spin_unlock_irqrestore(&clock_lock, flags);
+
+    unsigned int us = do_div(sec, 1000000);
+    ts->tv_sec = (long)sec;
+    ts->tv_nsec = us * 1000;
+}
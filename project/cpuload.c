@@ -0,0 +1,137 @@
+/**
+ * @file cpuload.c
+ * @brief Idle time, utilization windows and load averages.
+ */
+
+#include <clock.h>
+#include <cpuload.h>
+#include <sched.h>
+#include <spinlock.h>
+#include <utils.h>
+
+/* TSC time the CPU was halted at (0 while busy) */
+static unsigned long long idle_since = 0;
+
+/* Start of the current window and the idle cycles in it */
+static unsigned long long window_start = 0;
+static unsigned long long window_idle = 0;
+
+/* TSC time of the next load sample */
+static unsigned long long next_sample = 0;
+
+static struct cpu_stats stats;
+
+static spinlock_t cpuload_lock = SPINLOCK_INIT;
+
+static unsigned long long read_tsc(void) {
+    unsigned int low, high;
+    rdtsc(low, high);
+    return ((unsigned long long)high << 32) | low;
+}
+
+void cpuload_idle_enter(void) {
+    idle_since = read_tsc();
+    stats.halts++;
+}
+
+void cpuload_idle_exit(void) {
+    if (idle_since == 0) return;
+
+    unsigned long long idle = read_tsc() - idle_since;
+    idle_since = 0;
+    stats.idle_cycles += idle;
+    window_idle += idle;
+}
+
+/* Busy permille of a window of len cycles with idle of them halted */
+static unsigned int busy_permille(unsigned long long len, unsigned long long idle) {
+    /* do_div needs a 32-bit divisor: drop precision on windows stretched by a stopped tick */
+    while (len >> 32) {
+        len >>= 1;
+        idle >>= 1;
+    }
+    if (len == 0 || idle >= len) return 0;
+
+    idle *= 1000;
+    do_div(idle, (unsigned int)len);
+    return 1000 - (unsigned int)idle;
+}
+
+/* Fold active threads into a load average decayed by exp */
+static unsigned int calc_load(unsigned int load, unsigned int exp, unsigned int active) {
+    load = load * exp + active * LOAD_FIXED_1 * (LOAD_FIXED_1 - exp) + LOAD_FIXED_1 / 2;
+    return load >> LOAD_FSHIFT;
+}
+
+void cpuload_tick(void) {
+    unsigned long long now = read_tsc();
+    unsigned long long window = (unsigned long long)tsc_khz * CPULOAD_WINDOW_MS;
+    unsigned long long sample = (unsigned long long)tsc_khz * CPULOAD_SAMPLE_MS;
+
+    unsigned long flags = spin_lock_irqsave(&cpuload_lock);
+
+    if (window_start == 0) {
+        window_start = now;
+        next_sample = now + sample;
+    }
+
+    if (now - window_start >= window) {
+        for (int i = CPULOAD_HISTORY - 1; i > 0; i--) stats.util[i] = stats.util[i - 1];
+        stats.util[0] = busy_permille(now - window_start, window_idle);
+        stats.windows++;
+        window_start = now;
+        window_idle = 0;
+    }
+
+    /* A stopped tick can miss samples: the threads counted now were runnable through them */
+    if (now >= next_sample) {
+        unsigned int active = sched_nr_running();
+        while (now >= next_sample) {
+            stats.loadavg[0] = calc_load(stats.loadavg[0], LOAD_EXP_1, active);
+            stats.loadavg[1] = calc_load(stats.loadavg[1], LOAD_EXP_5, active);
+            stats.loadavg[2] = calc_load(stats.loadavg[2], LOAD_EXP_15, active);
+            next_sample += sample;
+        }
+    }
+
+    spin_unlock_irqrestore(&cpuload_lock, flags);
+}
+
+void cpuload_get(struct cpu_stats *out) {
+    unsigned long flags = spin_lock_irqsave(&cpuload_lock);
+
+    stats.window_ms = CPULOAD_WINDOW_MS;
+    stats.busy_cycles = read_tsc() - stats.idle_cycles;
+    copy_data(&stats, out, sizeof(struct cpu_stats));
+
+    spin_unlock_irqrestore(&cpuload_lock, flags);
+}
+
+/* Write a load average as "l.ll", saturating at 9.99 */
+static void format_load(char *buf, unsigned int load) {
+    unsigned int hundredths = (load * 100 + LOAD_FIXED_1 / 2) >> LOAD_FSHIFT;
+    if (hundredths > 999) hundredths = 999;
+
+    buf[0] = '0' + hundredths / 100;
+    buf[1] = '.';
+    buf[2] = '0' + (hundredths / 10) % 10;
+    buf[3] = '0' + hundredths % 10;
+}
+
+void cpuload_format(char *buf) {
+    unsigned int pct = (stats.util[0] + 5) / 10;
+
+    buf[0] = 'C';
+    buf[1] = 'P';
+    buf[2] = 'U';
+    buf[3] = ' ';
+    buf[4] = (pct >= 100) ? '1' : ' ';
+    buf[5] = (pct >= 10) ? '0' + (pct / 10) % 10 : ' ';
+    buf[6] = '0' + pct % 10;
+    buf[7] = '%';
+    for (int i = 0; i < 3; i++) {
+        buf[8 + 5 * i] = ' ';
+        format_load(&buf[9 + 5 * i], stats.loadavg[i]);
+    }
+    buf[CPULOAD_TEXT_LEN] = '\0';
+}
@@ -7,12 +7,17 @@
  */
 
 #include <io.h>
+#include <klog.h>
 #include <list.h>
+#include <serial.h>
 #include <utils.h>
 
 int sys_write_console(char *buffer, int size) {
     int i;
 
+    /* Kernel messages queued before this write come first */
+    klog_flush();
+
     for (i = 0; i < size; i++) {
         printc(buffer[i], DEFAULT_COLOR);
     }
@@ -23,7 +28,10 @@ int sys_write_console(char *buffer, int size) {
 int sys_write_debug(char *buffer, int size) {
     int i;
 
-    /* Write only to Bochs debug port (0xe9) - terminal only, not game screen */
+    /* Queued for COM1 if there is one: returns before the bytes are sent */
+    if (serial_present()) return serial_write(buffer, size);
+
+    /* Otherwise the Bochs debug port (0xe9) - terminal only, not game screen */
     for (i = 0; i < size; i++) {
         __asm__ __volatile__("movb %0, %%al; outb $0xe9" ::"a"(buffer[i]));
     }
@@ -0,0 +1,185 @@
+/**
+ * @file edf.c
+ * @brief Earliest-deadline-first scheduling class for ZeOS.
+ *
+ * This file implements admission control, job release at period
+ * boundaries, budget enforcement and deadline-miss accounting for EDF
+ * threads. The round-robin scheduler in sched.c asks this class first
+ * when choosing the next thread to run.
+ */
+
+#include <edf.h>
+#include <errno.h>
+#include <interrupt.h>
+#include <sched.h>
+
+struct list_head edf_readyqueue;
+struct list_head edf_sleepqueue;
+
+/* Sum of runtime/period of the admitted threads, in per mille */
+static int edf_total_util = 0;
+
+/* Tick comparison that survives counter wrap-around */
+#define TICK_BEFORE(a, b) ((int)((a) - (b)) < 0)
+
+static int edf_util(int period, int runtime) {
+    /* Round up so admitted threads never exceed the bound */
+    return (runtime * 1000 + period - 1) / period;
+}
+
+/* Start a new job released at tick 'release' */
+static void edf_new_job(struct task_struct *task, int release) {
+    /* A job that neither finished nor was counted yet missed its deadline */
+    if (task->edf_activations > 0 && !task->edf_job_done && !task->edf_job_missed) {
+        task->edf_misses++;
+    }
+
+    task->edf_abs_deadline = release + task->edf_deadline;
+    task->edf_next_release = release + task->edf_period;
+    task->edf_budget = task->edf_runtime;
+    task->edf_job_done = 0;
+    task->edf_job_missed = 0;
+    task->edf_activations++;
+}
+
+static void edf_check_miss(struct task_struct *task) {
+    if (!task->edf_job_missed && !TICK_BEFORE(zeos_ticks, task->edf_abs_deadline)) {
+        task->edf_job_missed = 1;
+        task->edf_misses++;
+    }
+}
+
+void init_edf(void) {
+    INIT_LIST_HEAD(&edf_readyqueue);
+    INIT_LIST_HEAD(&edf_sleepqueue);
+    edf_total_util = 0;
+}
+
+void edf_init_task(struct task_struct *task) {
+    task->sched_policy = SCHED_RR;
+    task->edf_period = 0;
+    task->edf_runtime = 0;
+    task->edf_deadline = 0;
+    task->edf_activations = 0;
+    task->edf_misses = 0;
+    task->edf_overruns = 0;
+}
+
+void edf_release(struct task_struct *task) {
+    if (task->sched_policy == SCHED_EDF) {
+        edf_total_util -= edf_util(task->edf_period, task->edf_runtime);
+    }
+    task->sched_policy = SCHED_RR;
+}
+
+void edf_enqueue(struct task_struct *task) {
+    struct list_head *pos;
+
+    /* Insert before the first task with a later deadline (FIFO among equals) */
+    list_for_each(pos, &edf_readyqueue) {
+        struct task_struct *other = list_head_to_task_struct(pos);
+        if (TICK_BEFORE(task->edf_abs_deadline, other->edf_abs_deadline)) break;
+    }
+    list_add_tail(&task->list, pos);
+}
+
+void edf_tick(void) {
+    struct list_head *pos, *tmp;
+
+    /* Release the jobs whose period started */
+    list_for_each_safe(pos, tmp, &edf_sleepqueue) {
+        struct task_struct *task = list_head_to_task_struct(pos);
+        if (!TICK_BEFORE(zeos_ticks, task->edf_next_release)) {
+            edf_new_job(task, task->edf_next_release);
+            update_process_state_rr(task, &readyqueue);
+        }
+    }
+
+    /* Count misses of jobs that are still waiting for the CPU */
+    list_for_each(pos, &edf_readyqueue) {
+        edf_check_miss(list_head_to_task_struct(pos));
+    }
+
+    if (current_task->sched_policy != SCHED_EDF || current_task->status != ST_RUN) return;
+
+    edf_check_miss(current_task);
+
+    /* Charge the running job; throttle it until its next release when out of budget */
+    if (--current_task->edf_budget <= 0) {
+        current_task->edf_overruns++;
+        update_process_state_rr(current_task, &edf_sleepqueue);
+    }
+}
+
+int edf_needs_preempt(void) {
+    if (list_empty(&edf_readyqueue)) return 0;
+    if (current_task->sched_policy != SCHED_EDF || current_task->status != ST_RUN) return 1;
+
+    struct task_struct *head = list_head_to_task_struct(list_first(&edf_readyqueue));
+    return TICK_BEFORE(head->edf_abs_deadline, current_task->edf_abs_deadline);
+}
+
+int edf_set_params(int period, int runtime, int deadline) {
+    struct task_struct *task = current_task;
+
+    if (period < 0 || runtime < 0 || deadline < 0) return -EINVAL;
+
+    /* Period 0: leave the EDF class */
+    if (period == 0) {
+        edf_release(task);
+        return 0;
+    }
+
+    if (deadline == 0) deadline = period;
+    if (runtime == 0 || runtime > deadline || deadline > period) return -EINVAL;
+
+    /* Admission control: the new reservation replaces the old one */
+    int old_util = (task->sched_policy == SCHED_EDF)
+                       ? edf_util(task->edf_period, task->edf_runtime)
+                       : 0;
+    int new_util = edf_util(period, runtime);
+    if (edf_total_util - old_util + new_util > EDF_MAX_UTILIZATION) return -EBUSY;
+
+    edf_total_util += new_util - old_util;
+    task->sched_policy = SCHED_EDF;
+    task->edf_period = period;
+    task->edf_runtime = runtime;
+    task->edf_deadline = deadline;
+    task->edf_activations = 0;
+    task->edf_misses = 0;
+    task->edf_overruns = 0;
+
+    /* The first job starts now */
+    edf_new_job(task, zeos_ticks);
+    return 0;
+}
+
+int edf_wait_period(void) {
+    struct task_struct *task = current_task;
+
+    if (task->sched_policy != SCHED_EDF) return -EINVAL;
+
+    edf_check_miss(task);
+    task->edf_job_done = 1;
+
+    /* Overran into the next period: start the next job right away */
+    if (!TICK_BEFORE(zeos_ticks, task->edf_next_release)) {
+        edf_new_job(task, task->edf_next_release);
+        return 0;
+    }
+
+    update_process_state_rr(task, &edf_sleepqueue);
+    sched_next_rr();
+    return 0;
+}
+
+void edf_get_stats(struct task_struct *task, struct sched_stats *stats) {
+    int is_edf = (task->sched_policy == SCHED_EDF);
+
+    stats->period = is_edf ? task->edf_period : 0;
+    stats->runtime = is_edf ? task->edf_runtime : 0;
+    stats->deadline = is_edf ? task->edf_deadline : 0;
+    stats->activations = task->edf_activations;
+    stats->deadline_misses = task->edf_misses;
+    stats->budget_overruns = task->edf_overruns;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file fpu.c
+ * @brief Lazy FPU/SSE context switching for ZeOS.
+ *
+ * This file implements FPU initialization, the device-not-available (#NM)
+ * handler and the helpers that keep one saved FPU/SSE area per thread.
+ * The FPU registers are only saved and restored when a thread that does
+ * not own them executes an FPU/SSE instruction.
+ */
+
+#include <fpu.h>
+#include <sched.h>
+#include <types.h>
+#include <utils.h>
+
+/* FPU save areas, one per task_union slot */
+union fpu_state fpu_states[NR_TASKS];
+
+/* Thread whose FPU state is loaded in the registers */
+struct task_struct *fpu_owner = NULL;
+
+/* Clean FPU state captured after FNINIT, loaded on a thread's first FPU use */
+static union fpu_state fpu_initial_state;
+
+/* 1 if the CPU supports FXSAVE/FXRSTOR, 0 to fall back to FSAVE/FRSTOR */
+static int fpu_has_fxsr = 0;
+
+// clang-format off
+static inline unsigned int read_cr0(void) {
+    unsigned int cr0;
+    __asm__ __volatile__("movl %%cr0, %0" : "=r"(cr0));
+    return cr0;
+}
+
+static inline void write_cr0(unsigned int cr0) {
+    __asm__ __volatile__("movl %0, %%cr0" : : "r"(cr0) : "memory");
+}
+
+static inline unsigned int read_cr4(void) {
+    unsigned int cr4;
+    __asm__ __volatile__("movl %%cr4, %0" : "=r"(cr4));
+    return cr4;
+}
+
+static inline void write_cr4(unsigned int cr4) {
+    __asm__ __volatile__("movl %0, %%cr4" : : "r"(cr4) : "memory");
+}
+
+static inline unsigned int cpuid_edx(unsigned int leaf) {
+    unsigned int eax, ebx, ecx, edx;
+    __asm__ __volatile__("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "a"(leaf));
+    return edx;
+}
+
+static inline void clts(void) {
+    __asm__ __volatile__("clts" : : : "memory");
+}
+
+static void fpu_save(union fpu_state *state) {
+    if (fpu_has_fxsr)
+        __asm__ __volatile__("fxsave %0" : "=m"(*state));
+    else
+        __asm__ __volatile__("fnsave %0\n\tfwait" : "=m"(*state));
+}
+
+static void fpu_restore(union fpu_state *state) {
+    if (fpu_has_fxsr)
+        __asm__ __volatile__("fxrstor %0" : : "m"(*state));
+    else
+        __asm__ __volatile__("frstor %0" : : "m"(*state));
+}
+// clang-format on
+
+static union fpu_state *fpu_area(struct task_struct *task) {
+    return &fpu_states[get_task_index(task)];
+}
+
+void init_fpu(void) {
+    unsigned int cr0 = read_cr0();
+    cr0 &= ~(CR0_EM | CR0_TS);
+    cr0 |= CR0_MP | CR0_NE;
+    write_cr0(cr0);
+
+    unsigned int features = cpuid_edx(1);
+    if (features & CPUID_EDX_FXSR) {
+        unsigned int cr4 = read_cr4() | CR4_OSFXSR;
+        if (features & CPUID_EDX_SSE) cr4 |= CR4_OSXMMEXCPT;
+        write_cr4(cr4);
+        fpu_has_fxsr = 1;
+    }
+
+    __asm__ __volatile__("fninit");
+    fpu_save(&fpu_initial_state);
+
+    /* Nobody owns the FPU yet: the first FPU instruction will trap */
+    fpu_owner = NULL;
+    write_cr0(cr0 | CR0_TS);
+}
+
+void fpu_switch_to(struct task_struct *next) {
+    unsigned int cr0 = read_cr0();
+
+    if (next == fpu_owner) {
+        if (cr0 & CR0_TS) clts();
+    } else if (!(cr0 & CR0_TS)) {
+        write_cr0(cr0 | CR0_TS);
+    }
+}
+
+void fpu_nm_routine(void) {
+    struct task_struct *task = current_task;
+
+    clts();
+
+    if (fpu_owner == task) return;
+
+    /* Save the live state of the previous owner */
+    if (fpu_owner != NULL) {
+        fpu_save(fpu_area(fpu_owner));
+    }
+
+    /* Load the state of the current thread (clean state on first use) */
+    if (task->fpu_used) {
+        fpu_restore(fpu_area(task));
+    } else {
+        fpu_restore(&fpu_initial_state);
+        task->fpu_used = 1;
+    }
+
+    fpu_owner = task;
+}
+
+void fpu_init_task(struct task_struct *task) {
+    task->fpu_used = 0;
+    if (fpu_owner == task) fpu_owner = NULL;
+}
+
+void fpu_fork(struct task_struct *parent, struct task_struct *child) {
+    fpu_init_task(child);
+
+    if (!parent->fpu_used) return;
+
+    /* The parent's live registers are newer than its save area */
+    if (fpu_owner == parent) {
+        clts();
+        fpu_save(fpu_area(parent));
+        /* FNSAVE reinitializes the FPU, so restore what the parent had */
+        if (!fpu_has_fxsr) fpu_restore(fpu_area(parent));
+    }
+
+    copy_data(fpu_area(parent), fpu_area(child), FPU_STATE_SIZE);
+    child->fpu_used = 1;
+}
+
+void fpu_release(struct task_struct *task) {
+    task->fpu_used = 0;
+    if (fpu_owner == task) fpu_owner = NULL;
+}
@@ -120,12 +120,12 @@ static void wait_for_next_frame(void) {
         ticks_per_frame = MIN_TICKS_PER_FRAME;
     }
 
-    int current_time = gettime();
+    int current_time = fast_gettime();
     int elapsed = current_time - g_last_frame_time;
 
     /* If not enough time has passed, busy-wait */
     while (elapsed < ticks_per_frame) {
-        current_time = gettime();
+        current_time = fast_gettime();
         elapsed = current_time - g_last_frame_time;
     }
 
@@ -138,7 +138,8 @@ static void wait_for_next_frame(void) {
  * ============================================================================ */
 
 void game_init(void) {
-    /* 1. Initialize render system (buffers) */
+    /* 1. Initialize render system (buffers); frames are flipped at the vertical retrace */
+    set_present_mode(10, SCREEN_PRESENT_VSYNC);
     render_init();
 
     /* 2. Initialize input system */
@@ -171,6 +172,7 @@ void game_init(void) {
 void game_cleanup(void) {
     g_running = 0;
     render_cleanup();
+    set_present_mode(10, SCREEN_PRESENT_DIRECT);
 }
 
 /* ============================================================================
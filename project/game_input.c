@@ -12,6 +12,9 @@
 /* Global input state */
 volatile InputState g_input;
 
+/* Kernel-maintained key state (NULL if it could not be mapped) */
+static const volatile struct kbd_state *g_kbd_state = NULL;
+
 /* Ticks to hold before continuous movement starts */
 #define HOLD_THRESHOLD (EIGHTH_SECOND)
 
@@ -23,6 +26,9 @@ void input_init(void) {
     /* Clear all input state */
     input_reset();
 
+    /* Held keys are read from the shared state page when available */
+    g_kbd_state = KeyboardState();
+
     /* Register keyboard event handler */
     int result = KeyboardEvent(input_keyboard_handler);
     if (result < 0) {
@@ -174,7 +180,9 @@ int input_is_attack_pressed(void) {
 }
 
 int input_is_attack_held(void) {
-    return g_input.attack_held; /* Don't consume - held state */
+    /* Don't consume - held state */
+    if (g_kbd_state != NULL) return KBD_KEY_HELD(g_kbd_state, KEY_SPACE);
+    return g_input.attack_held;
 }
 
 int input_is_pause_pressed(void) {
@@ -255,16 +255,9 @@ void render_present_buffer(void) {
         }
     }
 
-    /* Write entire buffer to screen using fd=10 */
+    /* Write entire buffer to screen using fd=10; the kernel keeps the shown page */
     write(10, g_vga_buffer, SCREEN_SIZE);
 
-    /* Copy back to front buffer for change tracking */
-    for (int y = 0; y < SCREEN_HEIGHT; y++) {
-        for (int x = 0; x < SCREEN_WIDTH; x++) {
-            g_front_buffer.cells[y][x] = g_back_buffer.cells[y][x];
-        }
-    }
-
     /* Clear dirty flag */
     g_back_buffer.dirty = 0;
 }
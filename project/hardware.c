@@ -10,6 +10,9 @@
 
 extern unsigned int *p_rdtr;
 
+/* Master PIC mask written by enable_int: timer and keyboard enabled */
+Byte pic_mask = 0xfc;
+
 // clang-format off
 DWord get_eflags(void){
     register DWord flags;
@@ -99,7 +102,7 @@ void enable_int(void){
         "call delay\n\t"
         "sti"
         :
-        : "i"(0xfc)
+        : "m"(pic_mask)
         : "%al");
 }
 
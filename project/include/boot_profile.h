@@ -0,0 +1,37 @@
+/**
+ * @file boot_profile.h
+ * @brief Boot-time profiler for ZeOS.
+ *
+ * main() timestamps the end of every initialization stage with the TSC.
+ * The TSC starts counting at power-on, so the first stage covers the
+ * firmware and the boot loader. Before entering user mode the profile
+ * is printed to the debug terminal (COM1, or the Bochs port 0xe9), one
+ * line per stage:
+ *
+ *     @boot <cycles since power-on> <cycles in the stage> <stage>
+ */
+
+#ifndef __BOOT_PROFILE_H__
+#define __BOOT_PROFILE_H__
+
+/** Set to 0 to skip the stage timestamps and the profile */
+#define BOOT_PROFILE 1
+
+/** Stages recorded; further marks are ignored */
+#define BOOT_STAGES_MAX 16
+
+/**
+ * @brief Mark the end of an initialization stage.
+ *
+ * @param stage Name of the stage that just finished (a string constant).
+ */
+void boot_stage(const char *stage);
+
+/**
+ * @brief Print the recorded stages to the debug port.
+ *
+ * The print itself is not part of any stage.
+ */
+void boot_profile_dump(void);
+
+#endif /* __BOOT_PROFILE_H__ */
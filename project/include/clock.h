@@ -0,0 +1,118 @@
+/**
+ * @file clock.h
+ * @brief Calibrated time keeping for ZeOS.
+ *
+ * At boot the TSC is measured against PIT channel 2, and channel 0 is
+ * programmed to raise IRQ 0 BASE_TICKS_PER_SECOND times per second.
+ * Both rates are published in the shared page, so TICKS_PER_SECOND and
+ * the millisecond conversions of times.h hold on any emulator speed.
+ * clock_gettime() interpolates between ticks with the TSC.
+ *
+ * When the CPU has a local APIC, its timer replaces IRQ 0: it is armed
+ * in one-shot mode for every tick, so the rate can be changed at run
+ * time without rounding to PIT clocks, and the idle task can stop the
+ * tick until the next timed event. Ticks that pass without an interrupt
+ * are counted when the next one arrives, from the TSC.
+ */
+
+#ifndef __CLOCK_H__
+#define __CLOCK_H__
+
+#include <clock_data.h>
+
+/** 1 to drive the tick with the local APIC timer when there is one */
+#define CLOCK_ONESHOT 1
+
+/** Length of the TSC and APIC timer calibrations in milliseconds */
+#define CLOCK_CALIBRATE_MS 10
+
+/** Longest time the idle task stops the tick, in milliseconds */
+#define CLOCK_NOHZ_MAX_MS 1000
+
+/** TSC cycles per millisecond (CYCLESPERTICK until calibrated) */
+extern unsigned int tsc_khz;
+
+/**
+ * @brief Calibrate the TSC and program the clock interrupt rate.
+ *
+ * Called first in main, before anything waits on time.
+ */
+void init_clock(void);
+
+/**
+ * @brief Move the tick to the local APIC timer in one-shot mode.
+ *
+ * Called once the CPU features are known (after init_smp) and before
+ * interrupts are enabled. Calibrates the APIC timer against the TSC and
+ * masks IRQ 0. Without an APIC the PIT keeps driving the tick.
+ */
+void clock_start_oneshot(void);
+
+/**
+ * @brief Change the tick rate.
+ *
+ * The monotonic clock continues from the current time; tick counts
+ * taken before the change keep the old length.
+ *
+ * @param hz New ticks per second (CLOCK_MIN_HZ to CLOCK_MAX_HZ).
+ * @return Previous rate, or -EINVAL for a rate out of range.
+ */
+int clock_set_rate(int hz);
+
+/**
+ * @brief Account the ticks of the current clock interrupt.
+ *
+ * Called by clock_routine. In one-shot mode it also arms the timer for
+ * the next tick, restarting a stopped tick.
+ *
+ * @return Ticks elapsed since the previous clock interrupt (1 in PIT mode).
+ */
+unsigned int clock_advance(void);
+
+/**
+ * @brief Local APIC timer interrupt routine.
+ *
+ * @param regs Saved context of the interrupted code.
+ */
+void clock_timer_routine(unsigned long *regs);
+
+/**
+ * @brief Stop the tick while the CPU is idle.
+ *
+ * Called in the idle loop. If nothing needs the next ticks (see
+ * sched_idle_ticks), arms the timer for the next timed event instead,
+ * at most CLOCK_NOHZ_MAX_MS away.
+ */
+void clock_nohz_idle(void);
+
+/**
+ * @brief Restart a stopped tick from a device interrupt.
+ *
+ * Brings zeos_ticks up to date, so the event is timestamped correctly,
+ * and arms the timer for the next tick.
+ */
+void clock_nohz_exit(void);
+
+/**
+ * @brief Delay of the current clock interrupt.
+ *
+ * @return PIT input clocks since the interrupt was due.
+ */
+unsigned int clock_irq_delay(void);
+
+/**
+ * @brief Copy the clock configuration and interrupt counters.
+ *
+ * @param stats Kernel buffer receiving the statistics.
+ */
+void clock_get_stats(struct clock_stats *stats);
+
+/**
+ * @brief Read the monotonic clock.
+ *
+ * @param ts Kernel buffer receiving the time since boot, with
+ *           microsecond resolution.
+ */
+void clock_monotonic(struct timespec *ts);
+
+#endif /* __CLOCK_H__ */
@@ -0,0 +1,32 @@
+/**
+ * @file clock_data.h
+ * @brief Time values and clock statistics shared by the kernel and user space.
+ */
+
+#ifndef __CLOCK_DATA_H__
+#define __CLOCK_DATA_H__
+
+/** Clocks accepted by clock_gettime() */
+#define CLOCK_MONOTONIC 1 /**< Time since boot */
+
+/** Point in time: seconds and nanoseconds (0-999999999) */
+struct timespec {
+    long tv_sec;  /**< Seconds */
+    long tv_nsec; /**< Nanoseconds; ZeOS clocks are microsecond-accurate */
+};
+
+/** Tick rates accepted by set_tick_rate() */
+#define CLOCK_MIN_HZ 20    /**< Slowest rate the PIT can generate */
+#define CLOCK_MAX_HZ 10000 /**< 100 microsecond ticks */
+
+/** Clock interrupt source and activity (see clock_getstats) */
+struct clock_stats {
+    int hz;                     /**< Clock ticks per second */
+    int oneshot;                /**< 1 if the local APIC timer drives the tick, 0 for the PIT */
+    unsigned int lapic_khz;     /**< APIC timer clocks per millisecond (0 without the APIC) */
+    unsigned int timer_irqs;    /**< Clock interrupts that advanced the tick */
+    unsigned int idle_stops;    /**< Times the idle task stopped the tick */
+    unsigned int ticks_skipped; /**< Ticks that passed without an interrupt */
+};
+
+#endif /* __CLOCK_DATA_H__ */
@@ -0,0 +1,74 @@
+/**
+ * @file cpuload.h
+ * @brief CPU utilization and load average accounting for ZeOS.
+ *
+ * The idle task halts the CPU until the next interrupt. The time from
+ * the halt to that interrupt is idle time, measured with the TSC; the
+ * rest is busy time. The clock bottom half closes a utilization window
+ * every CPULOAD_WINDOW_MS and keeps the last CPULOAD_HISTORY of them.
+ *
+ * Every CPULOAD_SAMPLE_MS the number of runnable threads (ready, or
+ * running other than idle) is folded into 1, 5 and 15 minute load
+ * averages, exponentially decayed in LOAD_FSHIFT-bit fixed point as
+ * classic Unix kernels do.
+ */
+
+#ifndef __CPULOAD_H__
+#define __CPULOAD_H__
+
+#include <stats.h>
+
+/** Length of a utilization window in milliseconds */
+#define CPULOAD_WINDOW_MS 250
+
+/** Interval between load average samples in milliseconds */
+#define CPULOAD_SAMPLE_MS 5000
+
+/** Decay factors per sample: LOAD_FIXED_1 / e^(5 s / 1, 5 and 15 min) */
+#define LOAD_EXP_1 1884
+#define LOAD_EXP_5 2014
+#define LOAD_EXP_15 2037
+
+/**
+ * @brief Start an idle period.
+ *
+ * Called by the idle task with interrupts disabled, right before it
+ * halts the CPU.
+ */
+void cpuload_idle_enter(void);
+
+/**
+ * @brief End the idle period, if any.
+ *
+ * Called on entry of the device interrupts, which may switch away from
+ * the idle task, and by the idle task when the halt returns.
+ */
+void cpuload_idle_exit(void);
+
+/**
+ * @brief Close the utilization window and sample the load when due.
+ *
+ * Called from the clock bottom half (SOFTIRQ_CLOCK).
+ */
+void cpuload_tick(void);
+
+/**
+ * @brief Copy the utilization history and load averages.
+ *
+ * @param stats Kernel buffer receiving the statistics.
+ */
+void cpuload_get(struct cpu_stats *stats);
+
+/**
+ * @brief Format the utilization overlay.
+ *
+ * @param buf Receives "CPU xxx% l.ll l.ll l.ll" (CPULOAD_TEXT_LEN
+ *            characters and a NUL): the last window's utilization and
+ *            the three load averages.
+ */
+void cpuload_format(char *buf);
+
+/** Characters of the cpuload_format() text */
+#define CPULOAD_TEXT_LEN 23
+
+#endif /* __CPULOAD_H__ */
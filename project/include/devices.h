@@ -21,11 +21,13 @@
 int sys_write_console(char *buffer, int size);
 
 /**
- * @brief Write data to debug terminal only (Bochs port 0xe9).
+ * @brief Write data to debug terminal only (COM1, or Bochs port 0xe9).
  *
- * This function writes output only to the Bochs debug terminal without
+ * This function writes output only to the debug terminal without
  * affecting the game screen. Used for debug messages that shouldn't
- * appear on the VGA screen.
+ * appear on the VGA screen. With a UART the bytes are queued and sent
+ * by its interrupt (see serial.h); otherwise they go to port 0xe9 one
+ * by one.
  * @param buffer Character buffer to write.
  * @param size Number of bytes to write.
  * @return Number of bytes written.
@@ -0,0 +1,100 @@
+/**
+ * @file edf.h
+ * @brief Earliest-deadline-first scheduling class for ZeOS.
+ *
+ * Threads that declare (period, runtime, deadline) with sched_setdeadline
+ * run before every round-robin thread, ordered by absolute deadline. A
+ * new job is released at each period boundary with a fresh budget of
+ * runtime ticks; a job that exhausts its budget is throttled until its
+ * next release. Admission keeps the total EDF utilization under
+ * EDF_MAX_UTILIZATION so the deadlines remain feasible.
+ */
+
+#ifndef __EDF_H__
+#define __EDF_H__
+
+#include <list.h>
+#include <sched.h>
+#include <stats.h>
+
+/** Scheduling policies */
+#define SCHED_RR 0  /**< Round robin (default) */
+#define SCHED_EDF 1 /**< Earliest deadline first */
+
+/** Maximum total EDF utilization in per mille, leaving CPU time for round robin */
+#define EDF_MAX_UTILIZATION 900
+
+/** EDF threads ready to run, sorted by absolute deadline */
+extern struct list_head edf_readyqueue;
+
+/** EDF threads waiting for their next release (job finished or throttled) */
+extern struct list_head edf_sleepqueue;
+
+/**
+ * @brief Initialize the EDF queues.
+ */
+void init_edf(void);
+
+/**
+ * @brief Reset the scheduling class of a new task to round robin.
+ *
+ * @param task Pointer to the new task.
+ */
+void edf_init_task(struct task_struct *task);
+
+/**
+ * @brief Give back the reserved utilization of a terminating task.
+ *
+ * @param task Task being released.
+ */
+void edf_release(struct task_struct *task);
+
+/**
+ * @brief Insert a ready EDF task in deadline order.
+ *
+ * @param task EDF task that becomes ready.
+ */
+void edf_enqueue(struct task_struct *task);
+
+/**
+ * @brief Per-tick EDF bookkeeping.
+ *
+ * Releases the jobs whose period started, charges the running job's
+ * budget (throttling it when exhausted) and counts deadline misses.
+ */
+void edf_tick(void);
+
+/**
+ * @brief Check whether a ready EDF task must preempt the current one.
+ *
+ * @return 1 if the EDF queue head has priority over current_task, 0 otherwise.
+ */
+int edf_needs_preempt(void);
+
+/**
+ * @brief Admit the current thread into the EDF class.
+ *
+ * @param period Period in ticks (0 returns the thread to round robin).
+ * @param runtime Budget per period in ticks.
+ * @param deadline Relative deadline in ticks (0 means equal to period).
+ * @return 0 on success, -EINVAL for inconsistent parameters, -EBUSY if
+ *         the utilization bound would be exceeded.
+ */
+int edf_set_params(int period, int runtime, int deadline);
+
+/**
+ * @brief Finish the current job and sleep until the next release.
+ *
+ * @return 0 on success, -EINVAL if the current thread is not EDF.
+ */
+int edf_wait_period(void);
+
+/**
+ * @brief Fill the deadline statistics of a task.
+ *
+ * @param task Task to report.
+ * @param stats Kernel copy of the statistics.
+ */
+void edf_get_stats(struct task_struct *task, struct sched_stats *stats);
+
+#endif /* __EDF_H__ */
@@ -29,6 +29,23 @@ extern void syscall_handler_sysenter();
  */
 extern void clock_handler();
 
+/**
+ * @brief Local APIC timer interrupt handler
+ *
+ * Replaces clock_handler when the tick runs in one-shot mode. Saves all
+ * registers and calls clock_timer_routine, which sends the APIC EOI and
+ * runs clock_routine once the tick is due. Implemented in entry.S.
+ */
+extern void lapic_timer_handler();
+
+/**
+ * @brief Local APIC spurious interrupt handler
+ *
+ * Returns at once: spurious interrupts must not be acknowledged.
+ * Implemented in entry.S.
+ */
+extern void lapic_spurious_handler();
+
 /**
  * @brief Assembly keyboard interrupt handler
  *
@@ -49,15 +66,37 @@ extern void keyboard_handler();
  */
 extern void pageFault_handler();
 
+/**
+ * @brief Device-not-available (#NM) exception handler.
+ *
+ * Low-level handler for exception 7, raised by the first FPU/SSE
+ * instruction executed while CR0.TS is set. Saves context, calls
+ * fpu_nm_routine to switch the lazy FPU state, and restores context.
+ * Implemented in entry.S.
+ */
+extern void fpu_nm_handler();
+
 /**
  * @brief Keyboard IRQ entry point for user keyboard events.
  *
- * Low-level keyboard interrupt handler that saves context, calls
- * kbd_irq_handler to dispatch to user callback if registered,
- * sends EOI, and restores context. Implemented in entry.S.
+ * Low-level keyboard interrupt handler that saves context, sends EOI,
+ * calls kbd_irq_handler to dispatch to user callback if registered,
+ * and restores context. The EOI comes first because the softirqs run
+ * at the end of kbd_irq_handler with interrupts enabled. Implemented
+ * in entry.S.
  */
 extern void kbd_irq_entry();
 
+/**
+ * @brief COM1 interrupt handler (IRQ 4)
+ *
+ * Saves all registers, sends EOI, calls serial_routine to move bytes
+ * between the UART and its rings and restores registers. The EOI comes
+ * first because serial_routine ends by running the softirqs with
+ * interrupts enabled. Implemented in entry.S.
+ */
+extern void serial_handler();
+
 /**
  * @brief Int 0x2b entry point to resume from keyboard handler.
  *
@@ -0,0 +1,101 @@
+/**
+ * @file fpu.h
+ * @brief Lazy FPU/SSE context management for ZeOS.
+ *
+ * This header defines the per-thread FPU save areas and the interface used
+ * to switch FPU/SSE state lazily. The kernel sets CR0.TS on every context
+ * switch; the first FPU/SSE instruction executed by a thread that does not
+ * own the FPU raises #NM (exception 7), whose handler saves the previous
+ * owner's state and restores the current thread's state.
+ * Threads that never touch the FPU pay nothing.
+ */
+
+#ifndef __FPU_H__
+#define __FPU_H__
+
+#include <sched.h>
+#include <types.h>
+
+/** Size of the FXSAVE/FXRSTOR area in bytes (FSAVE uses the first 108) */
+#define FPU_STATE_SIZE 512
+
+/** CR0 flag bits used by the FPU management */
+#define CR0_MP (1 << 1) /**< Monitor coprocessor: WAIT honours TS */
+#define CR0_EM (1 << 2) /**< Emulation: must be clear to execute FPU code */
+#define CR0_TS (1 << 3) /**< Task switched: next FPU instruction raises #NM */
+#define CR0_NE (1 << 5) /**< Native x87 error reporting */
+
+/** CR4 flag bits used by the FPU management */
+#define CR4_OSFXSR (1 << 9)      /**< OS supports FXSAVE/FXRSTOR and SSE */
+#define CR4_OSXMMEXCPT (1 << 10) /**< OS handles unmasked SSE exceptions */
+
+/** CPUID.1:EDX feature bits */
+#define CPUID_EDX_FXSR (1 << 24) /**< FXSAVE/FXRSTOR available */
+#define CPUID_EDX_SSE (1 << 25)  /**< SSE available */
+
+/** Per-thread FPU save area (16-byte aligned as FXSAVE requires) */
+union fpu_state {
+    Byte bytes[FPU_STATE_SIZE];
+} __attribute__((aligned(16)));
+
+/** FPU save areas, indexed like tasks[] */
+extern union fpu_state fpu_states[NR_TASKS];
+
+/** Thread whose state is currently loaded in the FPU registers (NULL if none) */
+extern struct task_struct *fpu_owner;
+
+/**
+ * @brief Initialize the FPU at boot.
+ *
+ * Clears CR0.EM, sets CR0.MP/NE, enables OSFXSR/OSXMMEXCPT in CR4 when the
+ * CPU supports FXSR, resets the FPU and captures the clean initial state
+ * that is loaded the first time each thread uses the FPU.
+ */
+void init_fpu(void);
+
+/**
+ * @brief Arm the lazy FPU switch for the next task.
+ *
+ * Called from inner_task_switch. Clears CR0.TS if the next task already
+ * owns the FPU, sets it otherwise so its first FPU instruction traps.
+ *
+ * @param next Task that is about to run.
+ */
+void fpu_switch_to(struct task_struct *next);
+
+/**
+ * @brief Device-not-available (#NM) exception routine.
+ *
+ * Saves the owner's FPU state into its area, restores (or initializes)
+ * the current thread's state and makes it the new owner.
+ */
+void fpu_nm_routine(void);
+
+/**
+ * @brief Initialize the FPU fields of a new thread.
+ *
+ * New threads start with a clean FPU state on first use.
+ *
+ * @param task Pointer to the new task.
+ */
+void fpu_init_task(struct task_struct *task);
+
+/**
+ * @brief Copy the FPU state of a parent into a forked child.
+ *
+ * If the parent has used the FPU, its live state is saved and copied
+ * so the child starts with identical FPU/SSE registers.
+ *
+ * @param parent Forking task.
+ * @param child New child task.
+ */
+void fpu_fork(struct task_struct *parent, struct task_struct *child);
+
+/**
+ * @brief Drop the FPU ownership of a terminating task.
+ *
+ * @param task Task being released.
+ */
+void fpu_release(struct task_struct *task);
+
+#endif /* __FPU_H__ */
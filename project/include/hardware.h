@@ -84,12 +84,22 @@ void set_task_reg(Selector tr);
  */
 void return_gate(Word ds, Word ss, DWord esp, Word cs, DWord eip);
 
+/** Master PIC mask bit of the timer (IRQ 0) */
+#define PIC_IRQ_TIMER 0x01
+
+/** Master PIC mask bit of the first serial port (IRQ 4) */
+#define PIC_IRQ_COM1 0x10
+
+/** Master PIC mask loaded by enable_int (timer and keyboard enabled by default) */
+extern Byte pic_mask;
+
 /**
  * @brief Enable hardware interrupts
  *
  * Configures the Programmable Interrupt Controller (PIC) mask register
  * to enable specific hardware interrupts. The 8259 PIC uses register 0x21
- * to control which interrupts are enabled/disabled.
+ * to control which interrupts are enabled/disabled; enable_int writes
+ * pic_mask to it.
  *
  * Register 0x21 bit mapping:
  * - bit 0: Timer interrupt
@@ -24,12 +24,25 @@
 #define FPS_DISPLAY_X (NUM_COLUMNS - 9)
 #define FPS_DISPLAY_Y 0
 
+/** Time between overlay refreshes in milliseconds (at most one per tick) */
+#define OVERLAY_REFRESH_MS 50
+
+/** Set to 0 to hide the CPU utilization and load display */
+#define LOAD_DISPLAY 1
+
+/** Screen position for the load display (centered, "CPU xxx% l.ll l.ll l.ll" = 23 chars) */
+#define LOAD_DISPLAY_X ((NUM_COLUMNS - 23) / 2)
+#define LOAD_DISPLAY_Y 0
+
 /** Color for time display */
 #define TIME_DISPLAY_COLOR MAKE_COLOR(BLACK, LIGHT_CYAN)
 
 /** Color for FPS display */
 #define FPS_DISPLAY_COLOR MAKE_COLOR(BLACK, YELLOW)
 
+/** Color for load display */
+#define LOAD_DISPLAY_COLOR MAKE_COLOR(BLACK, LIGHT_GREEN)
+
 /** Interrupt Descriptor Table - array of interrupt/trap gates */
 extern Gate idt[IDT_ENTRIES];
 
@@ -90,9 +103,13 @@ void keyboard_routine(void);
  * @brief Clock interrupt routine.
  *
  * Called on each timer tick (IRQ 0). Increments the global tick counter,
- * updates the clock display, and invokes the scheduler.
+ * lets the profiler sample and raises SOFTIRQ_CLOCK, whose handler
+ * refreshes the clock display with interrupts enabled. Then it invokes
+ * the scheduler, unless the tick interrupted the bottom halves.
+ *
+ * @param regs Context saved by clock_handler (SAVE_ALL layout).
  */
-void clock_routine(void);
+void clock_routine(unsigned long *regs);
 
 /**
  * @brief Page fault exception routine.
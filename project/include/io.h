@@ -44,6 +44,26 @@
 #define SCREEN_BUFFER_SIZE (NUM_COLUMNS * NUM_ROWS * 2) /** Screen buffer size in bytes */
 
 #define VIDEO_MEMORY_BASE 0xb8000 /** Base address of VGA text mode video memory */
+#define VIDEO_MEMORY_SIZE 0x8000  /** Bytes of text mode video memory (up to 0xbffff) */
+
+/** Screens at the end of video memory used by the screen fd to flip pages */
+#define SCREEN_PAGES 2
+
+/** Rows of video memory used by the console: the screen and its scrollback */
+#define CONSOLE_ROWS ((VIDEO_MEMORY_SIZE / 2 - SCREEN_PAGES * NUM_ROWS * NUM_COLUMNS) / NUM_COLUMNS)
+
+/** Scrollback rows kept when the screen goes back to the start of video memory */
+#define CONSOLE_SCROLLBACK 50
+
+/** VGA CRTC registers: index port, data port, and start address (in cells) */
+#define VGA_CRTC_INDEX 0x3D4
+#define VGA_CRTC_DATA 0x3D5
+#define VGA_CRTC_START_HIGH 0x0C
+#define VGA_CRTC_START_LOW 0x0D
+
+/** VGA input status register and its vertical retrace bit */
+#define VGA_INPUT_STATUS 0x3DA
+#define VGA_STATUS_RETRACE 0x08
 
 #define FD_CONSOLE 1 /**< File descriptor for console output (stdout) */
 #define FD_DEBUG 2   /**< File descriptor for debug output (terminal only, not game screen) */
@@ -69,6 +89,14 @@ extern Byte y;
  */
 Byte inb(unsigned short port);
 
+/**
+ * @brief Write byte to I/O port.
+ *
+ * @param port I/O port number to write to.
+ * @param value Byte value to write.
+ */
+void outb(unsigned short port, Byte value);
+
 /**
  * @brief Write character to specific screen position.
  *
@@ -85,11 +113,47 @@ void write_char_to_screen(Byte x, Byte y, char c, Word color);
 /**
  * @brief Scroll the screen content up by one line.
  *
- * This function moves all screen content up by one line, clearing
- * the bottom line. Used when cursor reaches the last row.
+ * This function moves the screen one row down video memory, clearing
+ * the new bottom line, and reprograms the CRTC start address, so the
+ * top line goes to the scrollback without copying the screen. Used
+ * when cursor reaches the last row.
  */
 void scroll_screen(void);
 
+/**
+ * @brief First cell of the screen in video memory.
+ *
+ * Screen row 0 moves as the console scrolls; code that draws at fixed
+ * screen positions starts from here.
+ *
+ * @return Address of the cell at column 0, row 0.
+ */
+Word *console_screen(void);
+
+/**
+ * @brief Move the view through the scrollback.
+ *
+ * Bound to Shift+Page Up and Shift+Page Down. While the view is in the
+ * scrollback, new output does not move it; scrolling back down to the
+ * screen follows the output again.
+ *
+ * @param rows Rows to move the view (negative: back in time). The view
+ *             stops at the oldest row kept and at the screen.
+ */
+void console_scroll_view(int rows);
+
+/**
+ * @brief Show a screen fd page instead of the console.
+ *
+ * The console keeps printing and scrolling in its rows without moving
+ * the display, until it is shown again (page NULL) or the scrollback
+ * keys are pressed. print_string_xy draws on the page shown.
+ *
+ * @param page First cell of a page past the console rows, or NULL to
+ *             show the console.
+ */
+void console_show_page(Word *page);
+
 /**
  * @brief Handle newline character.
  *
@@ -128,7 +192,9 @@ void printc_xy(Byte x, Byte y, char c, Word color);
  * @brief Print string to screen.
  *
  * This function prints a null-terminated string to the screen at the
- * current cursor position using the default color.
+ * current cursor position using the default color. The string goes
+ * through the kernel log (klog.h), which is printed before returning,
+ * so messages printed just before a halt are still seen.
  *
  * @param string Null-terminated string to print.
  */
@@ -137,8 +203,9 @@ void printk(char *string);
 /**
  * @brief Print string with color.
  *
- * This function prints a null-terminated string to the screen with
- * the specified color.
+ * This function appends a null-terminated string to the kernel log
+ * (klog.h); a bottom half prints it to the screen with the specified
+ * color shortly after.
  *
  * @param string Null-terminated string to print.
  * @param color Color attribute for the text.
@@ -156,8 +223,8 @@ void clear_screen(void);
 /**
  * @brief Print formatted string with color.
  *
- * This function prints a formatted string to the screen with
- * the specified color. Supports format specifiers:
+ * This function appends a formatted string to the kernel log, like
+ * printk_color. Supports format specifiers:
  *   - %d: Integer (decimal)
  *   - %x: Hexadecimal
  *   - %s: String
@@ -174,7 +241,8 @@ void printk_color_fmt(Word color, char *fmt, ...);
  * @brief Print string at specific screen position.
  *
  * Prints a null-terminated string starting at the given (x, y)
- * coordinates with the specified color. Does not affect cursor position.
+ * coordinates with the specified color, on the screen being displayed
+ * (the console's, or a screen fd page). Does not affect cursor position.
  *
  * @param x Starting column (0-79).
  * @param y Row (0-24).
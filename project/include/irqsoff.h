@@ -0,0 +1,112 @@
+/**
+ * @file irqsoff.h
+ * @brief Interrupts-off latency tracer for ZeOS.
+ *
+ * Every interrupt gate and the SYSENTER entry run with interrupts
+ * disabled, and the kernel only enables them again at a few points
+ * (preemption points, the idle loop, spin_unlock_irqrestore) or when it
+ * returns. The tracer timestamps each transition with the TSC: a window
+ * opens when interrupts get disabled and closes when they are enabled
+ * again, and the longest window is kept with the code addresses that
+ * opened and closed it.
+ *
+ * The clock interrupt also measures how long it waited for its handler
+ * (from the PIT counter, or from the TSC deadline of the one-shot APIC
+ * timer), which is how long interrupts were off when it was raised
+ * plus the entry cost.
+ *
+ * This header is also included by entry.S for the entry/exit hooks.
+ */
+
+#ifndef __IRQSOFF_H__
+#define __IRQSOFF_H__
+
+/** Set to 0 to compile the tracer out */
+#define IRQSOFF_TRACER 1
+
+/** Interrupt enable flag of EFLAGS */
+#define EFLAGS_IF 0x200
+
+#ifdef __ASSEMBLER__
+
+#if IRQSOFF_TRACER
+/* Open a window on entry; tag is an immediate or a register */
+#define IRQSOFF_ENTER(tag) \
+    pushl tag; \
+    call irqsoff_enter; \
+    addl $4, %esp
+
+/* Close the window if the return re-enables interrupts; eflags is the EFLAGS to restore */
+#define IRQSOFF_EXIT(eflags) \
+    pushl eflags; \
+    call irqsoff_exit; \
+    addl $4, %esp
+#else
+#define IRQSOFF_ENTER(tag)
+#define IRQSOFF_EXIT(eflags)
+#endif
+
+#else /* !__ASSEMBLER__ */
+
+#include <stats.h>
+
+#if IRQSOFF_TRACER
+
+/**
+ * @brief Entry hook of the interrupt gates and SYSENTER.
+ *
+ * Opens a window unless interrupts were already off.
+ *
+ * @param tag Vector of the interrupt, or IRQSOFF_TAG_SYSCALL + syscall number.
+ */
+void irqsoff_enter(int tag);
+
+/**
+ * @brief Exit hook of the interrupt gates and SYSENTER.
+ *
+ * @param eflags EFLAGS the return restores: the window only closes if
+ *               its IF flag is set.
+ */
+void irqsoff_exit(unsigned long eflags);
+
+/**
+ * @brief Hook for kernel code that has just disabled interrupts.
+ */
+void irqsoff_disabled(void);
+
+/**
+ * @brief Hook for kernel code that is about to enable interrupts.
+ */
+void irqsoff_enabled(void);
+
+/**
+ * @brief Record the latency of the current clock interrupt.
+ *
+ * Called first thing in clock_routine.
+ */
+void irq_latency_sample(void);
+
+#else
+
+static inline void irqsoff_disabled(void) {
+}
+
+static inline void irqsoff_enabled(void) {
+}
+
+static inline void irq_latency_sample(void) {
+}
+
+#endif /* IRQSOFF_TRACER */
+
+/**
+ * @brief Copy the tracer statistics.
+ *
+ * @param stats Kernel buffer receiving the statistics.
+ * @param reset If nonzero, clear the statistics after copying them.
+ */
+void irqsoff_get(struct irqsoff_stats *stats, int reset);
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* __IRQSOFF_H__ */
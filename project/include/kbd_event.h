@@ -0,0 +1,44 @@
+/**
+ * @file kbd_event.h
+ * @brief Keyboard event record shared by the kernel and user space.
+ *
+ * The kernel stores every keyboard interrupt as a timestamped event in
+ * the event ring of each process that reads keys with read_keys().
+ */
+
+#ifndef __KBD_EVENT_H__
+#define __KBD_EVENT_H__
+
+/** Events buffered per process; further events are dropped until it reads */
+#define KBD_RING_SIZE 64
+
+/** Events queued per thread for its upcall handler; also the largest batch */
+#define KBD_BATCH_MAX 16
+
+/** read_keys() timeout that waits until an event arrives */
+#define KBD_WAIT_FOREVER -1
+
+/** Keys tracked by the shared keyboard state (scancodes 0-127) */
+#define KBD_KEYS 128
+
+/** 1 if key is held down according to a shared keyboard state */
+#define KBD_KEY_HELD(state, key) (((state)->pressed[(key) >> 5] >> ((key)&31)) & 1)
+
+/**
+ * @brief Keyboard state kept by the kernel in a page mapped read-only
+ *        into the processes that call KeyboardState().
+ */
+struct kbd_state {
+    unsigned int seq;                    /**< Incremented on every press or release */
+    unsigned int pressed[KBD_KEYS / 32]; /**< Bit k set while key k is held */
+    unsigned int last_change[KBD_KEYS];  /**< Tick of the last press/release of each key */
+};
+
+/** Timestamped keyboard event */
+struct kbd_event {
+    unsigned int time; /**< Tick (gettime) at which the interrupt arrived */
+    char key;          /**< Scancode without the release bit (0-127) */
+    char pressed;      /**< 1 if pressed, 0 if released */
+};
+
+#endif /* __KBD_EVENT_H__ */
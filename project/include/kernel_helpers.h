@@ -87,7 +87,8 @@ int stack_region_in_use(struct task_struct *master, unsigned int start, unsigned
 /**
  * @brief Find a free region for thread stack allocation.
  *
- * Searches for an available memory region that can be used for a new thread's stack.
+ * Searches the MAX_TIDS_PER_PROCESS regions below THREAD_STACK_END_PAGE for one
+ * that no thread of the process uses for its stack.
  *
  * @param master Pointer to the master thread of the process.
  * @return Starting page number of free region, or -1 if no space available.
@@ -117,10 +118,33 @@ int map_stack_pages(struct task_struct *master, unsigned int first_page, unsigne
  */
 void release_thread_stack(struct task_struct *thread);
 
+/**
+ * @brief Move all children of a task to a new parent.
+ *
+ * Used when a thread or process terminates so that its children are not
+ * left with a dangling parent pointer. When the new parent is the idle
+ * task nobody will ever wait for them, so children that are already
+ * zombies are reaped immediately.
+ *
+ * @param from Task whose children list is emptied.
+ * @param to New parent for the children.
+ */
+void reparent_children(struct task_struct *from, struct task_struct *to);
+
+/**
+ * @brief Release a zombie task structure.
+ *
+ * Removes the zombie from its parent's children list and returns its
+ * task_struct to the free queue.
+ *
+ * @param zombie Pointer to the zombie task to release.
+ */
+void release_zombie(struct task_struct *zombie);
+
 /**
  * @brief Update time and FPS counters.
  *
- * Called by the clock interrupt to update internal time and FPS state.
+ * Called by the clock bottom half to update internal time and FPS state.
  * This function recalculates seconds, milliseconds, and FPS values
  * but does NOT write to video memory.
  */
@@ -131,7 +155,7 @@ void update_time_and_fps(void);
  *
  * Writes the current cached time (SS:MMM) and FPS (XXXX FPS) values
  * to their respective screen positions. Call after update_time_and_fps()
- * in the clock interrupt, or standalone after screen buffer writes.
+ * in the clock bottom half, or standalone after screen buffer writes.
  */
 void draw_time_and_fps(void);
 
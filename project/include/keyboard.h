@@ -11,6 +11,9 @@
 #ifndef __KEYBOARD_H__
 #define __KEYBOARD_H__
 
+#include <kbd_event.h>
+#include <list.h>
+#include <mm_address.h>
 #include <types.h>
 
 /* Forward declaration */
@@ -20,6 +23,12 @@ struct task_struct;
 #define KEYBOARD_DATA_PORT 0x60
 #define KEYBOARD_STATUS_PORT 0x64
 
+/* Scancodes of the console scrollback binding (Shift+Page Up/Down) */
+#define KBD_LEFT_SHIFT 0x2A
+#define KBD_RIGHT_SHIFT 0x36
+#define KBD_PAGE_UP 0x49
+#define KBD_PAGE_DOWN 0x51
+
 /* Number of registers to save (SW context + HW context) */
 #define KBD_CTX_SIZE 16
 
@@ -30,6 +39,37 @@ struct task_struct;
 /* Virtual page for auxiliary keyboard stack (near end of address space) */
 #define KBD_AUX_STACK_PAGE (TOTAL_PAGES - 3)
 
+/**
+ * @brief Per-process keyboard event ring.
+ *
+ * Filled by the keyboard IRQ and drained by read_keys(). head and tail
+ * are free-running counters; the ring is full when they differ by
+ * KBD_RING_SIZE.
+ */
+struct kbd_ring {
+    int used;                                /**< 1 while owned by a process */
+    unsigned int head;                       /**< Next event to read */
+    unsigned int tail;                       /**< Next slot to fill */
+    struct kbd_event events[KBD_RING_SIZE]; /**< Buffered events */
+};
+
+/** Shared keyboard state, page-aligned so it can be mapped into user space */
+union kbd_state_page {
+    struct kbd_state state;
+    Byte bytes[PAGE_SIZE];
+} __attribute__((aligned(PAGE_SIZE)));
+
+/** Keyboard state updated by the IRQ and mapped read-only at KBD_STATE_PAGE */
+extern union kbd_state_page kbd_state_page;
+
+/** Threads blocked in read_keys() */
+extern struct list_head kbd_waitqueue;
+
+/**
+ * @brief Initialize the event rings and the read_keys() wait queue.
+ */
+void init_kbd_rings(void);
+
 /**
  * @brief Initialize keyboard fields in a task structure.
  *
@@ -72,25 +112,80 @@ void free_kbd_aux_stack(struct task_struct *task);
  */
 void cleanup_kbd_handler(struct task_struct *task);
 
+/**
+ * @brief Map the shared keyboard state into the current process.
+ *
+ * @return User address of the read-only struct kbd_state.
+ */
+unsigned long kbd_state_map(void);
+
+/**
+ * @brief Remove the shared keyboard state mapping of a terminating process.
+ *
+ * @param master Master thread of the process.
+ */
+void kbd_state_unmap(struct task_struct *master);
+
+/**
+ * @brief Release the event ring of a terminating process.
+ *
+ * @param master Master thread of the process.
+ */
+void kbd_ring_release(struct task_struct *master);
+
+/**
+ * @brief Read buffered keyboard events of the current process.
+ *
+ * Allocates the process ring on first use. Blocks the calling thread on
+ * kbd_waitqueue while the ring is empty, for at most timeout ticks.
+ *
+ * @param buf User buffer receiving the events (already validated).
+ * @param n Maximum number of events to copy.
+ * @param timeout Ticks to wait, 0 to poll, KBD_WAIT_FOREVER to wait forever.
+ * @return Number of events copied (0 on timeout), -ENOMEM if no ring is free.
+ */
+int kbd_read_events(struct kbd_event *buf, int n, int timeout);
+
+/**
+ * @brief Expire read_keys() timeouts.
+ *
+ * Called from the scheduler on every clock tick.
+ */
+void kbd_tick(void);
+
 /**
  * @brief Handle keyboard IRQ and dispatch to user handler.
  *
  * Called from the keyboard interrupt handler (IRQ 1). Reads the scancode,
- * determines if a key was pressed or released, and if the current task
- * has a registered handler, modifies the saved context to execute the
- * user's callback function on the auxiliary stack.
+ * determines if a key was pressed or released, updates the shared
+ * keyboard state, appends the event to every process event ring, waking blocked readers. Then, if the current
+ * task has a registered handler, queues the event and, unless the handler
+ * is already running, modifies the saved context to execute the user's
+ * callback function on the auxiliary stack.
  *
- * The user function receives: key scancode (0-127) and pressed flag (1=pressed, 0=released).
+ * A single-event handler receives the key scancode (0-127) and pressed
+ * flag (1=pressed, 0=released); a batch handler receives every queued
+ * event at once.
  */
 void kbd_irq_handler(void);
 
+/**
+ * @brief Deliver keyboard events queued during a syscall.
+ *
+ * Called on the sysenter return path once the syscall result is stored
+ * in the saved context, so the upcall preserves it.
+ */
+void kbd_syscall_exit(void);
+
 /**
  * @brief Handle int 0x2b to resume normal execution.
  *
  * Called when user code executes int 0x2b. If we are currently in a
- * keyboard handler context, restores the complete saved context (all
- * registers from SW and HW context) so execution continues exactly
- * where it was interrupted with all register values preserved.
+ * keyboard handler context and more events were queued while the handler
+ * ran, re-enters the handler with them, keeping the saved context.
+ * Otherwise restores the complete saved context (all registers from SW
+ * and HW context) so execution continues exactly where it was interrupted
+ * with all register values preserved.
  * If called outside keyboard context, does nothing.
  */
 void kbd_resume_handler(void);
@@ -0,0 +1,81 @@
+/**
+ * @file klog.h
+ * @brief Kernel log ring for ZeOS.
+ *
+ * printk_color and printk_color_fmt append their text to a ring of
+ * KLOG_SIZE bytes instead of writing it to the screen. Appending costs
+ * a compare-and-swap to reserve the record and a copy of the text, with
+ * no lock, so it works from any context, including an interrupt that
+ * arrives while another message is being appended. The SOFTIRQ_KLOG
+ * bottom half then prints the new records to the console (and the debug
+ * port) with interrupts enabled.
+ *
+ * Each record starts with a header holding its position in the log,
+ * written last: a record whose header does not hold its own position
+ * is still being written, and the console waits for it. Writers reuse
+ * the oldest records once the console has printed them; if the console
+ * is too far behind, new messages are dropped, and the console says how
+ * many once it catches up.
+ *
+ * Console writes and printk() print the pending records first, so the
+ * screen keeps the order in which things happened.
+ */
+
+#ifndef __KLOG_H__
+#define __KLOG_H__
+
+#include <types.h>
+
+/** Set to 0 to print synchronously, as before the log existed */
+#define KLOG_ASYNC 1
+
+/** Size of the ring in bytes (a power of two) */
+#define KLOG_SIZE 16384
+
+/** Longest record; longer messages are split */
+#define KLOG_RECORD_MAX 256
+
+/** Record header (records are 8-byte aligned) */
+struct klog_header {
+    volatile unsigned int pos; /**< Position of the record once it is complete */
+    unsigned short len;        /**< Bytes of text that follow */
+    Word color;                /**< Console color, or KLOG_PAD */
+};
+
+/** Color of a record that only fills the end of the ring */
+#define KLOG_PAD 0xFFFF
+
+/**
+ * @brief Register the log's bottom half.
+ *
+ * Messages appended before are kept and printed once interrupts are on.
+ */
+void init_klog(void);
+
+/**
+ * @brief Append a message to the log.
+ *
+ * @param text Text to append (need not be NUL-terminated).
+ * @param len Bytes of text.
+ * @param color Console color.
+ */
+void klog_write(const char *text, int len, Word color);
+
+/**
+ * @brief Print the records the console has not shown yet.
+ *
+ * Called by the log's bottom half and before anything else writes to
+ * the console. Does nothing if called while already printing.
+ */
+void klog_flush(void);
+
+/**
+ * @brief Copy the most recent text of the log.
+ *
+ * @param buffer Kernel or user buffer (the caller has checked it).
+ * @param size Room in buffer.
+ * @return Bytes copied: the newest text that fits, oldest first.
+ */
+int klog_read(char *buffer, int size);
+
+#endif /* __KLOG_H__ */
@@ -0,0 +1,75 @@
+/**
+ * @file lapic.h
+ * @brief Local APIC access and timer for ZeOS.
+ *
+ * The local APIC registers are memory mapped at LAPIC_PHYS_BASE. Every
+ * page table maps that frame at LAPIC_PAGE (kernel only, uncached), so
+ * the registers can be reached whatever task is running. ZeOS keeps
+ * the 8259 PIC for device interrupts (LINT0 in virtual wire mode) and
+ * uses the APIC only for its timer, in one-shot mode.
+ */
+
+#ifndef __LAPIC_H__
+#define __LAPIC_H__
+
+#include <mm_address.h>
+
+/** Physical address of the local APIC registers after reset */
+#define LAPIC_PHYS_BASE 0xFEE00000
+
+/** Virtual address of the registers (LAPIC_PAGE of every page table) */
+#define LAPIC_BASE (LAPIC_PAGE << 12)
+
+/** Register offsets */
+#define LAPIC_VERSION 0x030       /**< Version and number of LVT entries */
+#define LAPIC_TPR 0x080           /**< Task priority */
+#define LAPIC_EOI 0x0B0           /**< End of interrupt (write 0) */
+#define LAPIC_SVR 0x0F0           /**< Spurious vector and software enable */
+#define LAPIC_LVT_TIMER 0x320     /**< Timer local vector */
+#define LAPIC_LVT_LINT0 0x350     /**< LINT0 pin (8259 INTR) */
+#define LAPIC_LVT_LINT1 0x360     /**< LINT1 pin (NMI) */
+#define LAPIC_TIMER_INITIAL 0x380 /**< Timer initial count: writing it starts the timer */
+#define LAPIC_TIMER_CURRENT 0x390 /**< Timer current count */
+#define LAPIC_TIMER_DIVIDE 0x3E0  /**< Timer divide configuration */
+
+/** Register bits */
+#define LAPIC_SVR_ENABLE 0x100    /**< APIC software enable */
+#define LAPIC_LVT_MASKED 0x10000  /**< Local vector masked */
+#define LAPIC_DM_NMI 0x400        /**< Delivery mode NMI */
+#define LAPIC_DM_EXTINT 0x700     /**< Delivery mode ExtINT: vector from the 8259 */
+#define LAPIC_DIVIDE_16 0x3       /**< Timer counts at the bus clock / 16 */
+
+/** Interrupt vectors */
+#define LAPIC_TIMER_VECTOR 0x30    /**< One-shot timer expiry */
+#define LAPIC_SPURIOUS_VECTOR 0x3F /**< Spurious interrupt (no EOI) */
+
+/**
+ * @brief Enable the local APIC of the bootstrap processor.
+ *
+ * Sets up virtual wire mode so PIC interrupts keep arriving and leaves
+ * the timer masked.
+ *
+ * @return 1 if the APIC responds at LAPIC_PAGE, 0 otherwise.
+ */
+int init_lapic(void);
+
+/**
+ * @brief Signal the end of a local APIC interrupt.
+ */
+void lapic_eoi(void);
+
+/**
+ * @brief Start the timer in one-shot mode.
+ *
+ * @param count Timer clocks until the interrupt (0 stops the timer).
+ */
+void lapic_timer_oneshot(unsigned int count);
+
+/**
+ * @brief Read the timer's current count.
+ *
+ * @return Timer clocks left before the next interrupt.
+ */
+unsigned int lapic_timer_count(void);
+
+#endif /* __LAPIC_H__ */
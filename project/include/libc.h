@@ -9,11 +9,20 @@
 #ifndef __LIBC_H__
 #define __LIBC_H__
 
+#include <clock_data.h>
+#include <kbd_event.h>
+#include <prof_data.h>
+#include <screen_data.h>
 #include <stats.h>
+#include <trace_data.h>
+#include <uring_data.h>
 
 /** Buffer size for prints() formatting */
 #define PRINTF_BUFFER_SIZE 256
 
+/** waitpid() option: return immediately if no child has exited */
+#define WNOHANG 1
+
 /** Global errno variable for error handling */
 extern int errno;
 
@@ -62,7 +71,8 @@ void perror(void);
  *
  * This function formats a string with variable arguments and writes
  * it to stdout. Similar to printf but simplified for ZeOS user space.
- * Supports format specifiers: %d (int), %s (string), %c (char), %% (literal %).
+ * Supports format specifiers: %d (int), %u (unsigned), %x (unsigned, hex),
+ * %s (string), %c (char), %% (literal %).
  *
  * @param fmt Format string with optional format specifiers.
  * @param ... Variable arguments matching format specifiers.
@@ -97,6 +107,164 @@ void printd(const char *fmt, ...);
  */
 int gettime(void);
 
+/**
+ * @brief Read the tick counter without entering the kernel.
+ *
+ * Reads the value the clock interrupt publishes in the page the kernel
+ * maps read-only into every process. Returns the same count as gettime()
+ * but costs a memory load instead of a SYSENTER round trip. Unlike
+ * gettime(), it also works inside keyboard handlers.
+ *
+ * @return Current system time in timer ticks.
+ */
+int fast_gettime(void);
+
+/**
+ * @brief Read the tick counter with sub-tick resolution.
+ *
+ * Combines the published tick count with the TSC cycles elapsed since
+ * that tick, scaled by the kernel's cycles-per-tick estimate.
+ *
+ * @param subtick If not NULL, receives the elapsed fraction of the current
+ *                tick in thousandths (0-999; 0 until the kernel has an estimate).
+ * @return Current system time in timer ticks.
+ */
+int fast_gettime_precise(int *subtick);
+
+/**
+ * @brief Read a clock with microsecond resolution.
+ *
+ * The kernel counts clock ticks at the rate measured at boot and adds
+ * the TSC cycles elapsed since the last tick, converted with the TSC
+ * frequency calibrated against the PIT.
+ *
+ * @param clock_id CLOCK_MONOTONIC (time since boot).
+ * @param tp Structure receiving the time.
+ * @return 0 on success, -1 on error with errno set to:
+ *         - EINVAL: unknown clock_id
+ *         - EFAULT: tp is not a valid user pointer
+ */
+int clock_gettime(int clock_id, struct timespec *tp);
+
+/**
+ * @brief TSC frequency measured by the kernel at boot.
+ *
+ * Read from the shared page; use it to convert rdtsc differences.
+ *
+ * @return TSC cycles per millisecond.
+ */
+unsigned int get_tsc_khz(void);
+
+/**
+ * @brief Change the clock tick rate.
+ *
+ * Faster ticks give finer sleeps and frame deadlines (TICKS_PER_SECOND
+ * and the conversions of times.h follow the new rate); tick counts
+ * taken before the change keep the old length. With a local APIC the
+ * tick is a one-shot timer and the idle CPU skips the ticks nobody
+ * waits for (see clock_getstats).
+ *
+ * @param hz Ticks per second, CLOCK_MIN_HZ to CLOCK_MAX_HZ, or 0 to only
+ *           read the current rate.
+ * @return Previous rate (the current one for 0), or -1 on error with
+ *         errno set to:
+ *         - EINVAL: hz out of range
+ *         - EINPROGRESS: called from within a keyboard handler
+ */
+int set_tick_rate(int hz);
+
+/**
+ * @brief Read the clock configuration and interrupt counters.
+ *
+ * @param stats Structure receiving the statistics.
+ * @return 0 on success, -1 on error with errno set to:
+ *         - EFAULT: stats is not a valid user pointer
+ *         - EINPROGRESS: called from within a keyboard handler
+ */
+int clock_getstats(struct clock_stats *stats);
+
+/**
+ * @brief Read the CPU utilization and load averages.
+ *
+ * Utilization is the share of each window (window_ms long) the CPU was
+ * not halted in the idle task, in permille, newest first. The load
+ * averages count the runnable threads over 1, 5 and 15 minutes, in
+ * fixed point with LOAD_FIXED_1 standing for 1.0.
+ *
+ * @param stats Structure receiving the statistics.
+ * @return 0 on success, -1 on error with errno set to:
+ *         - EFAULT: stats is not a valid user pointer
+ *         - EINPROGRESS: called from within a keyboard handler
+ */
+int get_cpu_stats(struct cpu_stats *stats);
+
+/**
+ * @brief Read the bytes a host sent to the first serial port.
+ *
+ * Does not wait: the kernel buffers what arrives (up to 256 bytes) and
+ * returns what it has, so a test program can poll for host commands.
+ * Debug output (fd 2) leaves through the same port.
+ *
+ * @param buffer Buffer receiving the bytes.
+ * @param size Room in buffer.
+ * @return Bytes read (0 if nothing arrived), or -1 on error with errno
+ *         set to:
+ *         - EINVAL: negative size
+ *         - EFAULT: buffer is not a valid user pointer
+ *         - ENODEV: the machine has no UART at COM1
+ *         - EINPROGRESS: called from within a keyboard handler
+ */
+int serial_read(char *buffer, int size);
+
+/**
+ * @brief Read the kernel log.
+ *
+ * Copies the text of the kernel messages still in the log (the last
+ * 16 KB or so), oldest first. If they do not fit, the newest size bytes
+ * are returned. Messages not yet shown on the console are included.
+ *
+ * @param buffer Buffer receiving the text (not NUL terminated).
+ * @param size Room in buffer.
+ * @return Bytes read, or -1 on error with errno set to:
+ *         - EINVAL: negative size
+ *         - EFAULT: buffer is not a valid user pointer
+ *         - EINPROGRESS: called from within a keyboard handler
+ */
+int dmesg(char *buffer, int size);
+
+/**
+ * @brief Choose how frames written to the screen fd are presented.
+ *
+ * SCREEN_PRESENT_DIRECT (the default) copies each frame into the
+ * visible screen. SCREEN_PRESENT_FLIP writes it to a hidden page of
+ * video memory and then shows that page, so a frame is never seen half
+ * drawn; SCREEN_PRESENT_VSYNC also waits for the vertical retrace, so
+ * the display switches between two refreshes. The console is shown
+ * again when the mode goes back to direct or the process exits.
+ *
+ * @param fd File descriptor (FD_SCREEN).
+ * @param mode SCREEN_PRESENT_* mode.
+ * @return Previous mode, or -1 on error with errno set to:
+ *         - EBADF: fd is not the screen fd
+ *         - EINVAL: unknown mode
+ *         - EINPROGRESS: called from within a keyboard handler
+ */
+int set_present_mode(int fd, int mode);
+
+/**
+ * @brief Read the PID of the calling thread without entering the kernel.
+ *
+ * @return Process identifier, as returned by getpid().
+ */
+int fast_getpid(void);
+
+/**
+ * @brief Read the TID of the calling thread without entering the kernel.
+ *
+ * @return Thread identifier, as returned by gettid().
+ */
+int fast_gettid(void);
+
 /**
  * @brief User-space wrapper for write system call.
  *
@@ -166,9 +334,32 @@ int fork(void);
 /**
  * @brief Terminate process.
  *
- * This function terminates the current process.
+ * This function terminates the current process. The exit code is kept
+ * by the kernel until the parent collects it with waitpid().
+ *
+ * @param status Exit code reported to the parent.
  */
-void exit(void);
+void exit(int status);
+
+/**
+ * @brief Wait for a child process to terminate.
+ *
+ * Blocks until the child identified by pid (or any child if pid is -1)
+ * exits, then reaps it and stores its exit code in *status. With
+ * WNOHANG, returns 0 immediately if no matching child has exited yet.
+ *
+ * @see sys_waitpid (defined in sys.h)
+ * @param pid PID of the child to wait for, or -1 for any child.
+ * @param status Pointer where the exit code is stored (may be NULL).
+ * @param options 0 or WNOHANG.
+ * @return PID of the reaped child, 0 with WNOHANG if none has exited,
+ *         or -1 on error with errno set to:
+ *         - ECHILD: no matching child
+ *         - EINVAL: invalid pid or options
+ *         - EFAULT: status is not a valid user address
+ *         - EINPROGRESS: called from within a keyboard handler
+ */
+int waitpid(int pid, int *status, int options);
 
 /****************************************/
 /**    Process Synchronization         **/
@@ -208,6 +399,57 @@ int unblock(int pid);
  */
 int WaitForTick(void);
 
+/**
+ * @brief Yield the CPU to the next ready thread.
+ *
+ * The calling thread goes to the tail of the ready queue. If no other
+ * thread is ready, the call returns immediately.
+ *
+ * @return 0 on success, -1 on error with errno set to:
+ *         - EINPROGRESS: called from within a keyboard handler
+ */
+int yield(void);
+
+/**
+ * @brief Run the calling thread under earliest-deadline-first scheduling.
+ *
+ * Every period ticks a new job is released with a budget of runtime
+ * ticks that must complete within deadline ticks. EDF threads always run
+ * before round robin threads. A job that exhausts its budget is
+ * throttled until the next period. Call sched_waitperiod() at the end
+ * of each job.
+ *
+ * @param period Period in ticks (0 returns the thread to round robin).
+ * @param runtime Budget per period in ticks.
+ * @param deadline Relative deadline in ticks (0 means equal to period).
+ * @return 0 on success, -1 on error with errno set to:
+ *         - EINVAL: runtime > deadline, deadline > period or negative values
+ *         - EBUSY: the total EDF utilization would exceed the admission bound
+ *         - EINPROGRESS: called from within a keyboard handler
+ */
+int sched_setdeadline(int period, int runtime, int deadline);
+
+/**
+ * @brief Finish the current EDF job and sleep until the next period.
+ *
+ * @return 0 on success, -1 on error with errno set to:
+ *         - EINVAL: the calling thread is not EDF
+ *         - EINPROGRESS: called from within a keyboard handler
+ */
+int sched_waitperiod(void);
+
+/**
+ * @brief Read the deadline statistics of a thread.
+ *
+ * @param tid Thread of the calling process, or 0 for the calling thread.
+ * @param stats Pointer receiving the statistics.
+ * @return 0 on success, -1 on error with errno set to:
+ *         - ESRCH: tid is not a thread of this process
+ *         - EFAULT: invalid stats pointer
+ *         - EINPROGRESS: called from within a keyboard handler
+ */
+int sched_getstats(int tid, struct sched_stats *stats);
+
 /****************************************/
 /**    Thread Functions                **/
 /****************************************/
@@ -289,6 +531,250 @@ void thread_entry_wrapper(void);
  */
 int KeyboardEvent(void (*func)(char key, int pressed));
 
+/**
+ * @brief Register a callback that receives keyboard events in batches.
+ *
+ * Like KeyboardEvent, but func receives every event queued for the thread
+ * (up to KBD_BATCH_MAX) in one call. Keys that arrive while func runs are
+ * delivered in the next batch without leaving the handler context, so a
+ * burst costs one upcall instead of one per key.
+ *
+ * @param func Callback function, or NULL to disable keyboard events.
+ * @return 0 on success, -1 on error with errno set to:
+ *         - EFAULT: func is not a valid user address
+ *         - ENOMEM: cannot allocate auxiliary stack
+ *         - EINPROGRESS: called from within a keyboard handler
+ */
+int KeyboardEventBatch(void (*func)(struct kbd_event *events, int count));
+
+/**
+ * @brief Register the process's submission/completion rings.
+ *
+ * The ring lives in the caller's memory and must stay valid while
+ * registered. Threads of the process share it; a forked child must
+ * register its own.
+ *
+ * @param ring Ring to register, or NULL to unregister.
+ * @return 0 on success, -1 on error with errno set to:
+ *         - EFAULT: ring is not writable user memory
+ *         - EINPROGRESS: called from within a keyboard handler
+ */
+int ring_setup(struct uring *ring);
+
+/**
+ * @brief Run queued operations with a single system call.
+ *
+ * Consumes up to to_submit entries of the submission ring in order. Each
+ * runs like the matching call (write, gettime, WaitForTick or a sleep of
+ * len ticks) and posts its result to the completion ring, which can be
+ * read without further system calls (see uring_get_sqe, uring_peek_cqe).
+ * Stops early if the completion ring is full.
+ *
+ * @param to_submit Maximum number of submissions to run.
+ * @return Number of submissions consumed, -1 on error with errno set to:
+ *         - EINVAL: to_submit is negative
+ *         - ENXIO: no ring registered
+ *         - EINPROGRESS: called from within a keyboard handler
+ */
+int ring_enter(int to_submit);
+
+/**
+ * @brief Reserve the next submission entry.
+ *
+ * @param ring Registered ring.
+ * @return Entry to fill, or NULL if the submission ring is full.
+ *         The entry runs on the next ring_enter() or uring_submit().
+ */
+struct uring_sqe *uring_get_sqe(struct uring *ring);
+
+/**
+ * @brief Run every queued submission.
+ *
+ * @param ring Registered ring.
+ * @return As ring_enter().
+ */
+int uring_submit(struct uring *ring);
+
+/**
+ * @brief Return the oldest unread completion without a system call.
+ *
+ * @param ring Registered ring.
+ * @return Completion, or NULL if none is pending. Release it with
+ *         uring_cqe_seen().
+ */
+struct uring_cqe *uring_peek_cqe(struct uring *ring);
+
+/**
+ * @brief Mark the completion returned by uring_peek_cqe as read.
+ *
+ * @param ring Registered ring.
+ */
+void uring_cqe_seen(struct uring *ring);
+
+/**
+ * @brief Read the counters and latency figures of one system call.
+ *
+ * Latencies are TSC cycles from kernel entry to return, including the
+ * time the caller spent blocked.
+ *
+ * @param nr System call number (0 to NR_SYSCALLS-1).
+ * @param pid 0 for system-wide figures, otherwise the PID whose threads'
+ *            figures are summed (the histogram is only kept system-wide).
+ * @param stats Structure receiving the statistics.
+ * @return 0 on success, -1 on error with errno set to:
+ *         - EINVAL: nr out of range or negative pid
+ *         - ESRCH: no calls recorded for pid
+ *         - EFAULT: stats is not a valid user pointer
+ *         - EINPROGRESS: called from within a keyboard handler
+ */
+int get_syscall_stats(int nr, int pid, struct syscall_stats *stats);
+
+/**
+ * @brief Print the statistics of every system call that has been called.
+ *
+ * One line per syscall with its call count, average and maximum cycles;
+ * for pid 0 it is followed by the non-empty buckets of its histogram.
+ *
+ * @param pid 0 for the whole system, otherwise the PID to report.
+ */
+void dump_syscall_stats(int pid);
+
+/**
+ * @brief Start the system-wide sampling profiler.
+ *
+ * Every period ticks the clock interrupt records the interrupted EIP,
+ * PROF_CALLERS return addresses, and the running PID and TID, whatever
+ * process is running. Samples of a previous run are discarded.
+ *
+ * @param period Ticks between samples.
+ * @return 0 on success, -1 on error with errno set to:
+ *         - EINVAL: period is not positive
+ *         - EINPROGRESS: called from within a keyboard handler
+ */
+int prof_start(int period);
+
+/**
+ * @brief Stop the sampling profiler. Buffered samples remain readable.
+ *
+ * @return Number of samples dropped because the kernel ring was full,
+ *         or -1 with errno set to EINPROGRESS from a keyboard handler.
+ */
+int prof_stop(void);
+
+/**
+ * @brief Read buffered profiler samples, oldest first.
+ *
+ * The kernel buffers PROF_RING_SIZE samples; read them often enough or
+ * use a longer period to avoid drops.
+ *
+ * @param buf Array receiving the samples.
+ * @param n Maximum number of samples to read.
+ * @return Number of samples read, -1 on error with errno set to:
+ *         - EINVAL: n is negative
+ *         - EFAULT: buf is not a valid user buffer
+ *         - EINPROGRESS: called from within a keyboard handler
+ */
+int prof_read(struct prof_sample *buf, int n);
+
+/**
+ * @brief Drain the profiler samples to the debug port.
+ *
+ * Prints one "@prof" line per sample to FD_DEBUG, the format read by
+ * the host tool: ./prof system user < debug-output.
+ *
+ * @return Number of samples printed.
+ */
+int prof_dump(void);
+
+/**
+ * @brief Select the kernel tracepoint categories that record events.
+ *
+ * @param mask TRACE_CAT_* bits; 0 stops tracing.
+ * @return Previous mask, -1 on error with errno set to:
+ *         - EINVAL: mask has unknown bits
+ *         - EINPROGRESS: called from within a keyboard handler
+ */
+int trace_ctl(int mask);
+
+/**
+ * @brief Read kernel trace records, oldest first.
+ *
+ * The kernel ring holds TRACE_RING_SIZE records; the lost field of a
+ * record counts those dropped before it while the ring was full.
+ *
+ * @param buf Array receiving the records.
+ * @param n Maximum number of records to read.
+ * @return Number of records read, -1 on error with errno set to:
+ *         - EINVAL: n is negative
+ *         - EFAULT: buf is not a valid user buffer
+ *         - EINPROGRESS: called from within a keyboard handler
+ */
+int trace_read(struct trace_record *buf, int n);
+
+/**
+ * @brief Drain the kernel trace to the debug port.
+ *
+ * Prints an "@trace-clock" calibration line and one "@trace" line per
+ * record to FD_DEBUG, the format read by the host tool:
+ * ./trace2json < debug-output > trace.json (open in chrome://tracing or
+ * Perfetto). Disable tracing first, or the dump traces itself.
+ *
+ * @return Number of records printed.
+ */
+int trace_dump(void);
+
+/**
+ * @brief Read the interrupts-off tracer statistics.
+ *
+ * The kernel measures every window during which interrupts are disabled
+ * (each syscall, interrupt and exception handler, and the sections
+ * between cli and sti) in TSC cycles, and keeps the longest with the
+ * kernel addresses that opened and closed it. Each clock interrupt also
+ * records how many PIT clocks (1193182 Hz) it waited for its handler.
+ *
+ * @param stats Structure receiving the statistics.
+ * @param reset If nonzero, clear the statistics after reading them.
+ * @return 0 on success, -1 on error with errno set to:
+ *         - EFAULT: stats is not a valid user pointer
+ *         - EINPROGRESS: called from within a keyboard handler
+ */
+int irqsoff_read(struct irqsoff_stats *stats, int reset);
+
+/**
+ * @brief Map the kernel's keyboard state into the process.
+ *
+ * Returns a read-only view that the kernel updates on every key press
+ * and release, so held keys can be checked with a memory load
+ * (KBD_KEY_HELD) instead of tracking edges in a keyboard handler.
+ * Writing to it raises a page fault, and system calls reject pointers
+ * into it with EFAULT.
+ *
+ * @return Pointer to the shared state, or NULL on error with errno set to:
+ *         - EINPROGRESS: called from within a keyboard handler
+ */
+const volatile struct kbd_state *KeyboardState(void);
+
+/**
+ * @brief Read buffered keyboard events.
+ *
+ * From its first call, the process receives every key event in a kernel
+ * ring of KBD_RING_SIZE events, whichever thread was running when the
+ * key was pressed. The call copies up to n events, oldest first, and
+ * blocks while none are buffered.
+ *
+ * @param buf Array receiving the events.
+ * @param n Maximum number of events to read.
+ * @param timeout Ticks to wait for the first event, 0 to return at once,
+ *                KBD_WAIT_FOREVER to wait without limit.
+ * @return Number of events read (0 if the timeout expired), -1 on error
+ *         with errno set to:
+ *         - EINVAL: n is negative or timeout is below KBD_WAIT_FOREVER
+ *         - EFAULT: buf is not a valid user buffer
+ *         - ENOMEM: no event ring available
+ *         - EINPROGRESS: called from within a keyboard handler
+ */
+int read_keys(struct kbd_event *buf, int n, int timeout);
+
 /****************************************/
 /**    Math Functions                  **/
 /****************************************/
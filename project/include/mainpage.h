@@ -231,7 +231,9 @@
  * - 80x25 character display with color attributes
  * - 16 foreground colors and 8 background colors
  * - Hardware cursor positioning and visibility control
- * - Automatic screen scrolling when buffer full
+ * - Hardware scrolling: the screen moves through the 32 KB of video memory
+ *   by CRTC start address, leaving a scrollback (Shift+Page Up/Down)
+ * - Screen fd page flipping, optionally at the vertical retrace (set_present_mode)
  *
  * **Color Management:**
  * ```cpp
@@ -244,6 +246,7 @@
  * - `printk_color()`: Colored kernel output with specified attributes
  * - `write_char_to_screen()`: Direct character placement with color
  * - `scroll_screen()`: Screen content scrolling and line management
+ * - `console_scroll_view()`: Scrollback view
  *
  * @section user_space User Space Components
  *
@@ -368,7 +371,7 @@
  * @subsection debugging Debugging Support
  * - **Bochs internal debugger**: `make emuldbg` for built-in debugging
  * - **GDB remote debugging**: `make gdb` with `.gdbcmd` configuration
- * - **Debug output**: Port 0xE9 output for emulator logging
+ * - **Debug output**: Interrupt-driven COM1 transmit ring (port 0xE9 without a UART)
  * - **Conditional debugging**: Configurable debug flags in `debug.h`
  *
  * @section documentation_structure Documentation Structure
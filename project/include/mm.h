@@ -13,6 +13,9 @@
 #include <sched.h>
 #include <types.h>
 
+/** Initialize each task slot's page table on first use instead of all at boot */
+#define FAST_BOOT 1
+
 /** Frame is available for allocation */
 #define FREE_FRAME 0
 
@@ -46,10 +49,21 @@ void init_dir_pages(void);
  * @brief Initialize page tables with kernel pages.
  *
  * Sets up the page tables for all tasks with kernel page mappings.
- * Initializes kernel pages as present and accessible.
+ * With FAST_BOOT this is left to init_task_table() when each task slot
+ * is first given a page directory.
  */
 void init_table_pages(void);
 
+/**
+ * @brief Initialize the page table of a task slot once.
+ *
+ * Clears the table and maps the kernel pages as present and accessible
+ * the first time it is called for a slot; later calls return at once.
+ *
+ * @param pos Index of the slot in tasks[].
+ */
+void init_task_table(int pos);
+
 /**
  * @brief Set up user page tables for a task.
  *
@@ -79,6 +93,25 @@ void set_cr3(page_table_entry *dir);
  */
 void set_pe_flag(void);
 
+/** CR0 write protect bit: read-only pages also stop kernel writes */
+#define CR0_WP 0x00010000
+
+/**
+ * @brief Make read-only pages apply to the kernel too.
+ *
+ * Set by init_mm, so a kernel write through a user pointer cannot
+ * modify the pages shared read-only with user space.
+ */
+void set_wp_flag(void);
+
+/**
+ * @brief Let the kernel write to read-only pages.
+ *
+ * Only used while the user image is copied to its read-only code pages
+ * at boot.
+ */
+void clear_wp_flag(void);
+
 /**
  * @brief Initialize memory management subsystem.
  *
@@ -167,6 +200,18 @@ void set_ss_pag(page_table_entry *PT, unsigned page, unsigned frame);
  */
 void del_ss_pag(page_table_entry *PT, unsigned page);
 
+/**
+ * @brief Map a physical frame read-only for user mode.
+ *
+ * Used to share kernel-maintained pages with user processes: user code
+ * can read them but any write raises a page fault.
+ *
+ * @param PT Pointer to the page table.
+ * @param page Virtual page number to map.
+ * @param frame Physical frame number to map to.
+ */
+void set_user_ro_pag(page_table_entry *PT, unsigned page, unsigned frame);
+
 /**
  * @brief Get physical frame from virtual page.
  *
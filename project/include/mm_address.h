@@ -31,7 +31,7 @@
 #define PAG_LOG_INIT_DATA (L_USER_START >> 12)
 
 /* Number of pages for user data segment */
-#define NUM_PAG_DATA 24
+#define NUM_PAG_DATA 32
 
 /* Size of a page in bytes (4KB) */
 #define PAGE_SIZE 0x1000
@@ -65,6 +65,13 @@
 
 /* Temporary mapping pages - use end of address space to avoid conflicts with thread stacks */
 #define TEMP_STACK_MAPPING_PAGE (TOTAL_PAGES - THREAD_STACK_INITIAL_PAGES - 1) /**< Page 1022 */
-#define FORK_TEMP_MAPPING_PAGE (TOTAL_PAGES - NUM_PAG_DATA - 2)                /**< Page 1002 */
+#define FORK_TEMP_MAPPING_PAGE (TOTAL_PAGES - NUM_PAG_DATA - 3)                /**< Page 989 */
+
+/* Kernel pages mapped read-only into user space, just below the fork temporary mapping */
+#define KBD_STATE_PAGE (FORK_TEMP_MAPPING_PAGE - 1) /**< Shared keyboard state, page 988 */
+#define VDSO_PAGE (KBD_STATE_PAGE - 1)              /**< Time and thread IDs, page 987 */
+
+/* Kernel-only mapping of the local APIC registers, page 986 */
+#define LAPIC_PAGE (VDSO_PAGE - 1)
 
 #endif /* __MM_ADDRESS_H__ */
@@ -0,0 +1,71 @@
+/**
+ * @file pit.h
+ * @brief 8253/8254 programmable interval timer (PIT) access for ZeOS.
+ *
+ * Channel 0 drives IRQ 0. ZeOS keeps the mode and reload value set by
+ * the BIOS and reads the counter back to know how long ago the last
+ * clock interrupt was raised.
+ */
+
+#ifndef __PIT_H__
+#define __PIT_H__
+
+/** I/O ports */
+#define PIT_CH0_PORT 0x40  /**< Channel 0 data port */
+#define PIT_CH2_PORT 0x42  /**< Channel 2 data port */
+#define PIT_CMD_PORT 0x43  /**< Mode/command register */
+#define PIT_GATE_PORT 0x61 /**< System control port B: channel 2 gate and OUT */
+
+/** PIT input clock in Hz (one input clock is about 838 ns) */
+#define PIT_INPUT_HZ 1193182
+
+/** Reload value left by the BIOS (a count of 0 means 65536) */
+#define PIT_BIOS_RELOAD 65536
+
+/** Read-back command: latch the status and the count of channel 0 */
+#define PIT_READBACK_CH0 0xC2
+
+/** Commands: lobyte/hibyte access, binary counting */
+#define PIT_CH0_RATE 0x34    /**< Channel 0, mode 2 (rate generator) */
+#define PIT_CH2_ONESHOT 0xB0 /**< Channel 2, mode 0 (interrupt on terminal count) */
+
+/** Port 0x61 bits */
+#define PIT_GATE_CH2 0x01    /**< Gate input of channel 2 */
+#define PIT_SPEAKER 0x02     /**< Connect channel 2 to the speaker */
+#define PIT_CH2_OUT 0x20     /**< OUT pin of channel 2 (read only) */
+
+/** Read-back status: level of the OUT pin */
+#define PIT_STATUS_OUT 0x80
+
+/** Counter reload value of channel 0 */
+extern unsigned int pit_reload;
+
+/**
+ * @brief Program channel 0 as a rate generator.
+ *
+ * @param hz Interrupt rate; rounded to the nearest reload value.
+ */
+void pit_set_rate(unsigned int hz);
+
+/**
+ * @brief Measure the TSC against channel 2.
+ *
+ * Runs channel 2 as a one-shot of ms milliseconds with the speaker
+ * disconnected and counts TSC cycles until its OUT pin rises.
+ *
+ * @param ms Length of the measurement in milliseconds (at most 54).
+ * @return TSC cycles per millisecond, or 0 if OUT never rose.
+ */
+unsigned int pit_calibrate_tsc(unsigned int ms);
+
+/**
+ * @brief Time since channel 0 last raised IRQ 0.
+ *
+ * Handles the rate generator (mode 2) and the square wave (mode 3),
+ * whose counter runs through the reload value twice per period.
+ *
+ * @return PIT input clocks elapsed since the start of the current period.
+ */
+unsigned int pit_elapsed(void);
+
+#endif /* __PIT_H__ */
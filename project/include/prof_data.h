@@ -0,0 +1,29 @@
+/**
+ * @file prof_data.h
+ * @brief Profiler sample record shared by user space and the kernel.
+ *
+ * While the sampling profiler runs, the clock interrupt records where
+ * the CPU was every few ticks. prof_read() copies the samples out and
+ * the host tool (prof) symbolizes them against the system and user ELF
+ * files.
+ */
+
+#ifndef __PROF_DATA_H__
+#define __PROF_DATA_H__
+
+/** Return addresses recorded above the sampled EIP (frame pointer walk) */
+#define PROF_CALLERS 2
+
+/** Sample flags */
+#define PROF_SAMPLE_KERNEL 1 /**< EIP is in the kernel (symbolize against system) */
+
+/** One sample taken by the clock interrupt */
+struct prof_sample {
+    unsigned int eip;                   /**< Interrupted instruction */
+    unsigned int callers[PROF_CALLERS]; /**< Return addresses, innermost first; 0 if unknown */
+    int pid;                            /**< Process running (0 for idle) */
+    int tid;                            /**< Thread running */
+    int flags;                          /**< PROF_SAMPLE_* */
+};
+
+#endif /* __PROF_DATA_H__ */
@@ -0,0 +1,60 @@
+/**
+ * @file profiler.h
+ * @brief Statistical sampling profiler for ZeOS.
+ *
+ * When started, the clock interrupt records every period ticks the
+ * interrupted EIP, the first PROF_CALLERS return addresses found by
+ * following the saved frame pointers, and the running PID and TID.
+ * Samples go to a ring of the CPU taking the interrupt; when a ring is
+ * full new samples are dropped until prof_read() drains it.
+ */
+
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#include <prof_data.h>
+
+/** Samples buffered per CPU */
+#define PROF_RING_SIZE 256
+
+/**
+ * @brief Take a sample if the profiler is due.
+ *
+ * Called from clock_routine.
+ *
+ * @param regs Context saved by SAVE_ALL on interrupt entry.
+ */
+void prof_tick(unsigned long *regs);
+
+/**
+ * @brief Start sampling, discarding samples left from a previous run.
+ *
+ * @param period Ticks between samples.
+ * @return 0 on success, -EINVAL if period is not positive.
+ */
+int prof_start(int period);
+
+/**
+ * @brief Check whether the profiler is sampling.
+ *
+ * @return 1 between prof_start and prof_stop, 0 otherwise.
+ */
+int prof_active(void);
+
+/**
+ * @brief Stop sampling; buffered samples can still be read.
+ *
+ * @return Number of samples dropped because a ring was full.
+ */
+int prof_stop(void);
+
+/**
+ * @brief Move buffered samples, oldest first, to a user buffer.
+ *
+ * @param buf User buffer, already checked for n samples.
+ * @param n Maximum number of samples.
+ * @return Number of samples copied.
+ */
+int prof_read(struct prof_sample *buf, int n);
+
+#endif /* __PROFILER_H__ */
@@ -25,9 +25,25 @@
 #define SCREEN_TEST             1   /**< Enable/disable screen functional tests */
 #define SCREEN_PERFORMANCE_TEST 1   /**< Enable/disable screen performance test */
 #define WAITFORTICK_TEST        1   /**< Enable/disable WaitForTick tests */
+#define FPU_TEST                1   /**< Enable/disable lazy FPU context tests */
+#define CTX_SWITCH_PERFORMANCE_TEST 1 /**< Enable/disable context switch benchmark */
+#define EDF_TEST                1   /**< Enable/disable EDF scheduler tests */
+#define PREEMPT_LATENCY_TEST    1   /**< Enable/disable syscall preemption latency test */
+#define VDSO_TEST               1   /**< Enable/disable shared time/ID page tests */
+#define URING_TEST              1   /**< Enable/disable submission/completion ring tests */
+#define SYSCALL_STATS_TEST      1   /**< Enable/disable per-syscall statistics tests */
+#define PROFILER_TEST           1   /**< Enable/disable sampling profiler tests */
+#define TRACE_TEST              1   /**< Enable/disable event tracing tests */
+#define IRQSOFF_TEST            1   /**< Enable/disable interrupts-off tracer tests */
+#define TICK_RATE_TEST          1   /**< Enable/disable tick rate and one-shot timer tests */
+#define CPU_LOAD_TEST           1   /**< Enable/disable CPU utilization and load tests */
+#define SERIAL_TEST             1   /**< Enable/disable serial port tests */
+#define KLOG_TEST               1   /**< Enable/disable kernel log tests */
+#define CONSOLE_SCROLL_TEST     1   /**< Enable/disable console hardware scrolling tests */
+#define PRESENT_TEST            1   /**< Enable/disable screen fd page flipping tests */
 
 /* FUNCTIONAL TESTS */
-#define TICK_CALIBRATION_TEST   0   /**< Enable/disable tick rate calibration test */
+#define TICK_CALIBRATION_TEST   1   /**< Enable/disable tick rate calibration test */
 #define FPS_TEST                1   /**< Enable/disable FPS visual test */
 #define IDLE_SWITCH_TEST        0   /**< Test idle switch (exits init) */
 // clang-format on
@@ -38,15 +54,63 @@
 /** Default Buffer size */
 #define BUFFER_SIZE 256
 
-#define MAX_THREADS_PER_PROCESS 10 /** Maximum threads per process (TIDs X0-X9) */
-#define MAX_SYNC_FLAGS 10          /** Synchronization flags for thread tests */
+#define MAX_THREADS_PER_PROCESS 16 /** Maximum threads per process (MAX_TIDS_PER_PROCESS) */
+#define MAX_SYNC_FLAGS 16          /** Synchronization flags for thread tests */
 
 #define KBD_MAX_KEYS 10 /* Maximum keys to track in keyboard test */
+#define KBD_READ_TIMEOUT 5 /* Ticks read_keys waits in the timeout subtest */
+#define KBD_HANDLER_WORK_TICKS 20 /* Ticks each handler call spends in the batch subtest */
 
 #define SCREEN_WRITE_ITERATIONS 1000 /** Number of iterations for screen write performance test */
 
 #define NUM_SYSCALLS_TO_TEST 10 /**< Number of syscalls to test for EINPROGRESS */
 
+#define FPU_TEST_THREADS 3         /**< Threads computing concurrently in the FPU test */
+#define FPU_TEST_ITERATIONS 200000 /**< Loop length, long enough to span several ticks */
+
+#define CTX_SWITCH_ITERATIONS 2000 /**< yield() calls per side in the context switch benchmark */
+
+#define PREEMPT_WRITE_SIZE 4096 /**< Bytes per write() in the preemption latency test */
+#define PREEMPT_WRITES 4        /**< write() calls issued by the writer thread */
+#define PREEMPT_MAX_LATENCY_US 500 /**< Worst clock interrupt delay allowed during the writes */
+#define PREEMPT_MAX_GAP_TICKS 4    /**< Longest the spinner may be kept off the CPU */
+
+#define VDSO_BENCH_ITERATIONS 10000 /**< Calls per variant in the shared page benchmark */
+
+#define URING_BENCH_FRAMES 2000 /**< Simulated frames per variant in the ring benchmark */
+#define URING_SLEEP_TICKS 2     /**< Ticks slept by the batched sleep operation */
+
+#define SYSCALL_STATS_NR 21     /**< Syscall counted by the statistics test (gettid) */
+#define SYSCALL_STATS_CALLS 100 /**< gettid() calls made by the statistics test */
+
+#define PROF_TEST_TICKS 40 /**< Ticks sampled by the profiler test */
+#define PROF_TEST_CHUNK 32 /**< Samples read per prof_read() call */
+
+#define TRACE_TEST_CALLS 4      /**< gettid() calls traced by the tracing test */
+#define TRACE_TEST_CHUNK 16     /**< Records read per trace_read() call */
+#define TRACE_TEST_DUMP_TICKS 3 /**< Ticks of full tracing dumped to the debug port */
+
+#define IRQSOFF_TEST_TICKS 10 /**< Clock interrupts measured while the system is idle */
+
+#define TICK_RATE_TEST_HZ 4000 /**< Fast tick rate set by the tick rate test */
+#define TICK_RATE_TEST_MS 200  /**< Time measured at the fast rate */
+#define TICK_RATE_IDLE_MS 500  /**< Time the tick rate test leaves the CPU idle */
+
+#define CPU_LOAD_TEST_MS 600 /**< Time the CPU load test sleeps, then spins (over two windows) */
+
+#define SERIAL_TEST_BYTES 2048 /**< Debug output queued by the serial test (fits the ring) */
+
+#define KLOG_TEST_BYTES 2048 /**< Kernel log text read by the kernel log test */
+#define KLOG_TEST_TAIL 16    /**< Size of the short read that must return the newest text */
+
+#define CONSOLE_TEST_LINES 250 /**< Lines printed by the console test (more than video memory holds) */
+
+#define PRESENT_TEST_FRAMES 10 /**< Frames presented in each flip mode by the page flipping test */
+
+#define EDF_TEST_PERIOD 8  /**< Period (and deadline) of the EDF test thread in ticks */
+#define EDF_TEST_RUNTIME 2 /**< Budget per job of the EDF test thread in ticks */
+#define EDF_TEST_JOBS 10   /**< Jobs run by the EDF test thread */
+
 /* Keyboard scancodes for FPS test navigation */
 #define FPS_SCANCODE_N 0x31   /**< Scancode for 'N' key (next scene) */
 #define FPS_SCANCODE_B 0x30   /**< Scancode for 'B' key (previous scene) */
@@ -201,7 +265,7 @@ void subtest_wrapper_calls_exit(int *passed);
  * @brief Main thread test suite.
  *
  * This function runs all thread tests:
- * - Subtest 1: Create threads up to max limit (10 per process)
+ * - Subtest 1: Create threads up to max limit (MAX_THREADS_PER_PROCESS per process)
  * - Subtest 2: Verify creation fails when limit reached
  * - Subtest 3: TID reuse after thread deletion
  * - Subtest 4: Process termination when last thread exits
@@ -251,6 +315,45 @@ void subtest_kbd_handler_called(int *passed);
  */
 void subtest_kbd_einprogress(int *passed);
 
+/**
+ * @brief Test read_keys argument checks, polling and timeout.
+ *
+ * @param passed Pointer to store result (1 = passed, 0 = failed).
+ */
+void subtest_kbd_read_keys_timeout(int *passed);
+
+/**
+ * @brief Test a thread blocked in read_keys while another thread runs.
+ *
+ * A reader thread sleeps in read_keys while the main thread spins; keys
+ * pressed meanwhile must reach the reader through the event ring.
+ *
+ * @param passed Pointer to store result (1 = passed, 0 = failed).
+ */
+void subtest_kbd_read_keys_blocking(int *passed);
+
+/**
+ * @brief Compare single-event and batched upcalls during key repeat.
+ *
+ * The user holds a key down twice: once with a KeyboardEvent handler and
+ * once with a KeyboardEventBatch handler. Both handlers spend
+ * KBD_HANDLER_WORK_TICKS per call, so repeats pile up while they run.
+ * Reports the number of upcalls (handler entries) per event in each mode.
+ *
+ * @param passed Pointer to store result (1 = passed, 0 = failed).
+ */
+void subtest_kbd_batch_upcalls(int *passed);
+
+/**
+ * @brief Test the read-only shared keyboard state page.
+ *
+ * Maps the state, checks that a second call returns the same address and
+ * that the bitmap and timestamps follow the keys the user holds down.
+ *
+ * @param passed Pointer to store result (1 = passed, 0 = failed).
+ */
+void subtest_kbd_shared_state(int *passed);
+
 /**
  * @brief Main keyboard test suite.
  *
@@ -259,6 +362,10 @@ void subtest_kbd_einprogress(int *passed);
  * - Subtest 2: Disable keyboard handler with NULL
  * - Subtest 3: Verify handler is called on key events
  * - Subtest 4: Verify syscalls return EINPROGRESS inside handler
+ * - Subtest 5: read_keys argument checks, polling and timeout
+ * - Subtest 6: Blocking read_keys from a reader thread
+ * - Subtest 7: Batched upcalls during key repeat
+ * - Subtest 8: Read-only shared keyboard state (syscalls cannot write it)
  */
 void keyboard_tests(void);
 
@@ -379,24 +486,331 @@ void subtest_waitfortick_timing(int *passed);
 void waitfortick_tests(void);
 
 /****************************************/
-/**    Tick Calibration Test Functions **/
+/**    FPU Test Functions              **/
+/****************************************/
+
+/**
+ * @brief Test that FPU state survives preemption between threads.
+ *
+ * Several threads run long floating point loops concurrently, each with
+ * a different seed, and compare their result with the value computed
+ * by the coordinator thread alone.
+ *
+ * @param passed Pointer to store result (1 = passed, 0 = failed).
+ */
+void subtest_fpu_threads(int *passed);
+
+/**
+ * @brief Test that a forked child can use the FPU.
+ *
+ * The child runs the same floating point loop as the parent and
+ * reports through its exit status whether the result matched.
+ *
+ * @param passed Pointer to store result (1 = passed, 0 = failed).
+ */
+void subtest_fpu_fork(int *passed);
+
+/**
+ * @brief Main FPU test suite.
+ *
+ * This function runs lazy FPU switching tests:
+ * - Subtest 1: Concurrent threads using the FPU
+ * - Subtest 2: FPU use in a forked child
+ */
+void fpu_tests(void);
+
+/****************************************/
+/**    EDF Test Functions              **/
+/****************************************/
+
+/**
+ * @brief Test EDF parameter validation and admission control.
+ *
+ * Checks EINVAL for inconsistent parameters, EBUSY when the utilization
+ * bound is exceeded and EINVAL for sched_waitperiod outside EDF.
+ *
+ * @param passed Pointer to store result (1 = passed, 0 = failed).
+ */
+void subtest_edf_admission(int *passed);
+
+/**
+ * @brief Test a periodic EDF thread.
+ *
+ * A thread runs EDF_TEST_JOBS jobs and checks that consecutive releases
+ * are at least one period apart and that no deadline was missed.
+ *
+ * @param passed Pointer to store result (1 = passed, 0 = failed).
+ */
+void subtest_edf_periodic(int *passed);
+
+/**
+ * @brief Main EDF test suite.
+ *
+ * This function runs EDF scheduler tests:
+ * - Subtest 1: Parameter validation and admission control
+ * - Subtest 2: Periodic thread releases and deadline statistics
+ */
+void edf_tests(void);
+
+/****************************************/
+/**    Context Switch Benchmark        **/
+/****************************************/
+
+/**
+ * @brief Context switch cost benchmark.
+ *
+ * Two threads of the same process, then a parent and a forked child,
+ * ping-pong with yield() for CTX_SWITCH_ITERATIONS rounds. Each side
+ * times only its yield() loop with the 64-bit TSC, so thread creation,
+ * fork, exit and waitpid are left out, and divides by the number of
+ * switches. The average cost in TSC cycles is reported for
+ * same-process switches (no CR3 reload) and for cross-process switches.
+ *
+ * @return 1 if both runs completed, 0 otherwise.
+ */
+int test_context_switch_performance(void);
+
+/****************************************/
+/**    Syscall Preemption Latency      **/
+/****************************************/
+
+/**
+ * @brief Syscall preemption latency test.
+ *
+ * A writer thread issues large write() calls to the debug console while
+ * the coordinator spins and records the longest gap (in TSC cycles and
+ * ticks) during which it could not run. Without preemption points the
+ * gap covers a whole write(); with them it stays near one quantum.
+ * Build with SYSCALL_PREEMPTION 0 to obtain the baseline.
+ *
+ * The test passes if the worst clock interrupt latency read back from
+ * the PIT by the interrupts-off tracer stays within
+ * PREEMPT_MAX_LATENCY_US and the longest gap within
+ * PREEMPT_MAX_GAP_TICKS.
+ *
+ * @return 1 if the test passed, 0 otherwise.
+ */
+int test_preempt_latency(void);
+
+/****************************************/
+/**    Shared Time/ID Page             **/
 /****************************************/
 
 /**
- * @brief Tick Calibration Test to measure actual tick rate.
+ * @brief Shared time/ID page tests and benchmark.
  *
- * This test runs for a specified number of "expected" seconds
- * (TICK_CALIBRATION_SECONDS) to measure the actual number of ticks
- * per second. This helps calibrate TICKS_PER_SECOND if the hardware
- * timer doesn't match the expected frequency.
+ * - Subtest 1: fast_getpid/fast_gettid/fast_gettime agree with the
+ *   syscalls, in the main thread and in a second thread
+ * - Subtest 2: cycles per call of gettime()/gettid() against their
+ *   shared page readers
  *
- * The test displays:
- * - Expected duration in seconds
- * - Actual elapsed ticks
- * - Calculated ticks per second
- * - Deviation from expected (1000 ticks/second)
+ * @return 1 if all subtests passed, 0 otherwise.
+ */
+int test_vdso(void);
+
+/****************************************/
+/**    Submission/Completion Rings     **/
+/****************************************/
+
+/**
+ * @brief Submission/completion ring tests and benchmark.
+ *
+ * - Subtest 1: ring_enter without a ring and ring_setup with a bad
+ *   pointer fail with ENXIO and EFAULT
+ * - Subtest 2: one ring_enter runs a mixed batch in order and posts the
+ *   expected completions
+ * - Subtest 3: simulated frames (gettime, debug write, gettime) issued as
+ *   separate syscalls and as one ring_enter: transitions and cycles per frame
+ *
+ * @return 1 if all subtests passed, 0 otherwise.
+ */
+int test_uring(void);
+
+/****************************************/
+/**    Syscall Statistics Tests        **/
+/****************************************/
+
+/**
+ * @brief Per-syscall statistics tests.
+ *
+ * - Subtest 1: SYSCALL_STATS_CALLS gettid() calls show up in the
+ *   system-wide and per-process counters, cycles and histogram
+ * - Subtest 2: invalid nr, unknown PID and bad pointer fail with EINVAL,
+ *   ESRCH and EFAULT; then prints this process's statistics
+ *
+ * @return 1 if all subtests passed, 0 otherwise.
+ */
+int test_syscall_stats(void);
+
+/****************************************/
+/**    Sampling Profiler Tests         **/
+/****************************************/
+
+/**
+ * @brief Sampling profiler tests.
+ *
+ * - Subtest 1: prof_start(0), a negative count and a bad buffer fail
+ *   with EINVAL and EFAULT
+ * - Subtest 2: sampling every tick while spinning in a small function
+ *   yields samples, most of them inside it, without drops; a short run
+ *   is then dumped to the debug port with prof_dump()
+ *
+ * @return 1 if all subtests passed, 0 otherwise.
+ */
+int test_profiler(void);
+
+/****************************************/
+/**    Event Tracing Tests             **/
+/****************************************/
+
+/**
+ * @brief Kernel event tracing tests.
+ *
+ * - Subtest 1: an unknown category and a bad buffer fail with EINVAL
+ *   and EFAULT
+ * - Subtest 2: with syscall tracing on, each gettid() leaves an entry
+ *   and an exit record, with ordered timestamps
+ * - Subtest 3: with scheduler/process tracing on, creating a thread
+ *   records its creation, a switch to it and its exit; a few ticks of
+ *   every category are then dumped with trace_dump()
+ *
+ * @return 1 if all subtests passed, 0 otherwise.
+ */
+int test_trace(void);
+
+/****************************************/
+/**    Interrupts-Off Tracer Tests     **/
+/****************************************/
+
+/**
+ * @brief Interrupts-off tracer and clock interrupt latency tests.
+ *
+ * - Subtest 1: a bad buffer fails with EFAULT
+ * - Subtest 2: while the test only yields, every tick is measured and
+ *   the interrupts-off windows are reported with their call sites
+ * - Subtest 3: the same figures while a thread writes large buffers to
+ *   the console, whose syscalls keep interrupts off longest
+ *
+ * @return 1 if all subtests passed, 0 otherwise.
+ */
+int test_irqsoff(void);
+
+/****************************************/
+/**    Tick Rate Tests                 **/
+/****************************************/
+
+/**
+ * @brief Programmable tick rate and tickless idle tests.
+ *
+ * - Subtest 1: out-of-range rates fail with EINVAL, a bad statistics
+ *   buffer with EFAULT, and rate 0 reports the current rate
+ * - Subtest 2: at TICK_RATE_TEST_HZ the ticks keep pace with the TSC
+ *   (5% tolerance), clock_gettime continues across the change and the
+ *   old rate is restored
+ * - Subtest 3: an EDF thread sleeps TICK_RATE_IDLE_MS with the CPU
+ *   idle; the ticks still advance, and with the one-shot APIC timer
+ *   less than a tenth of them raise an interrupt
+ *
+ * @return 1 if all subtests passed, 0 otherwise.
+ */
+int test_tick_rate(void);
+
+/****************************************/
+/**    CPU Load Tests                  **/
+/****************************************/
+
+/**
+ * @brief CPU utilization and load average tests.
+ *
+ * - Subtest 1: a bad buffer fails with EFAULT
+ * - Subtest 2: an EDF thread sleeps CPU_LOAD_TEST_MS; the CPU halts and
+ *   the last window is less than half busy
+ * - Subtest 3: the thread spins CPU_LOAD_TEST_MS; the last window is
+ *   more than 80% busy and the idle time barely grows
+ *
+ * @return 1 if all subtests passed, 0 otherwise.
+ */
+int test_cpu_load(void);
+
+/****************************************/
+/**    Serial Port Tests               **/
+/****************************************/
+
+/**
+ * @brief Serial port (COM1) tests.
+ *
+ * - Subtest 1: serial_read fails with EINVAL for a negative size and
+ *   EFAULT for a bad buffer; with nothing sent it returns 0 (or ENODEV
+ *   without a UART)
+ * - Subtest 2: SERIAL_TEST_BYTES written to FD_DEBUG are all accepted;
+ *   the cycles per byte are reported
+ *
+ * @return 1 if all subtests passed, 0 otherwise.
+ */
+int test_serial(void);
+
+/****************************************/
+/**    Kernel Log Tests                **/
+/****************************************/
+
+/**
+ * @brief Kernel log (dmesg) tests.
+ *
+ * - Subtest 1: dmesg fails with EINVAL for a negative size and EFAULT
+ *   for a bad buffer
+ * - Subtest 2: the boot messages are in the log, and a read of
+ *   KLOG_TEST_TAIL bytes returns the end of a full read
+ *
+ * @return 1 if all subtests passed, 0 otherwise.
+ */
+int test_klog(void);
+
+/****************************************/
+/**    Console Scrolling Tests         **/
+/****************************************/
+
+/**
+ * @brief Console hardware scrolling test.
+ *
+ * - Subtest 1: CONSOLE_TEST_LINES lines written to the console, enough
+ *   for the screen to reach the end of video memory and go back to the
+ *   start, are all accepted; the cycles per line are reported
+ *
+ * @return 1 if all subtests passed, 0 otherwise.
+ */
+int test_console_scroll(void);
+
+/****************************************/
+/**    Page Flipping Tests             **/
+/****************************************/
+
+/**
+ * @brief Screen fd presentation mode tests.
+ *
+ * - Subtest 1: set_present_mode fails with EBADF for the console fd and
+ *   EINVAL for an unknown mode
+ * - Subtest 2: PRESENT_TEST_FRAMES frames are accepted in the flip and
+ *   vsync modes, each switch returns the previous mode, and the console
+ *   is shown again; the cycles per frame are reported
+ *
+ * @return 1 if all subtests passed, 0 otherwise.
+ */
+int test_present(void);
+
+/****************************************/
+/**    Tick Calibration Test Functions **/
+/****************************************/
+
+/**
+ * @brief Tick Calibration Test to check the boot-time clock calibration.
  *
- * @note Use a stopwatch to time this test for accurate calibration.
+ * Runs for TIME_CALIBRATION_SECONDS and checks, without a stopwatch:
+ * - clock_gettime rejects an unknown clock and bad pointers (kernel
+ *   memory, the read-only vDSO page)
+ * - the TSC advanced at the rate calibrated against the PIT at boot
+ *   for the ticks counted (5% tolerance)
+ * - clock_gettime advanced like the tick counter, within one tick
+ * - consecutive clock_gettime reads never go backwards
  */
 void tick_calibration_test(void);
 
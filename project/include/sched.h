@@ -25,8 +25,31 @@
 /** Default quantum assigned to new processes (ticks) */
 #define DEFAULT_QUANTUM 1
 
-/** Maximum TIDs per process: 10 threads (slots 0-9) */
-#define MAX_TIDS_PER_PROCESS 10
+/** Open interrupt windows at preemption points of long syscalls (0 = IRQs masked throughout) */
+#define SYSCALL_PREEMPTION 1
+
+/** Run ready threads of the current process back-to-back (0 = plain round robin) */
+#define SCHED_SAME_PROCESS_BIAS 0
+
+/** Consecutive same-process picks allowed before the ready queue head must run */
+#define SCHED_SAME_PROCESS_MAX_RUN 4
+
+/** Maximum TIDs per process: 16 threads (slots 0-15). Also the TID stride: TID = PID*N + slot */
+#define MAX_TIDS_PER_PROCESS 16
+
+/** Words in the per-process TID bitmap */
+#define TID_BITMAP_WORDS ((MAX_TIDS_PER_PROCESS + 31) / 32)
+
+/** First page past the thread stack regions: one region per TID slot */
+#define THREAD_STACK_END_PAGE \
+    (THREAD_STACK_BASE_PAGE + MAX_TIDS_PER_PROCESS * THREAD_STACK_REGION_PAGES)
+
+#if THREAD_STACK_END_PAGE > LAPIC_PAGE
+#error "Thread stack regions overlap the pages shared with user space"
+#endif
+
+/** Buckets in the PID and TID hash tables (power of two) */
+#define ID_HASH_SIZE 32
 
 /** Calculate kernel stack pointer for a task */
 #define KERNEL_ESP(task) (DWord) & (task)->stack[KERNEL_STACK_SIZE]
@@ -38,7 +61,8 @@
 enum state_t {
     ST_RUN,    /**< Currently running */
     ST_READY,  /**< Ready to run, in ready queue */
-    ST_BLOCKED /**< Blocked waiting for an event */
+    ST_BLOCKED, /**< Blocked waiting for an event */
+    ST_ZOMBIE   /**< Exited, waiting to be reaped by its parent */
 };
 
 /** Process control block structure */
@@ -53,14 +77,18 @@ struct task_struct {
     struct list_head children;            /**< List of child processes */
     struct list_head child_list;          /**< Entry in parent's children list */
     int pending_unblocks;                 /**< Number of pending unblock operations */
+    int exit_code;                        /**< Exit code reported to the parent by waitpid */
+    int wait_pid;                         /**< PID waited for in waitpid (-1=any), 0 if not */
 
     /* Thread support fields */
-    int TID;                              /**< Thread identifier: PID*10 + slot (0-9). Idle=0 */
+    int TID;                              /**< Thread identifier: PID*MAX_TIDS_PER_PROCESS + slot. Idle=0 */
     int thread_count;                     /**< Number of threads in process */
     struct task_struct *master_thread;    /**< Pointer to master thread */
     struct list_head threads;             /**< List of threads in this process */
     struct list_head thread_list;         /**< Entry in master thread's threads list */
-    int tid_slots[MAX_TIDS_PER_PROCESS];  /**< TID slots: indices 0-9. 0=free, 1=used */
+    unsigned int tid_bitmap[TID_BITMAP_WORDS]; /**< TID slots in use (bit = slot), master only */
+    struct list_head tid_hash;            /**< Entry in the TID hash table */
+    struct list_head pid_hash;            /**< Entry in the PID hash table (master only) */
     int *user_stack_ptr;                  /**< Pointer to user stack for this thread */
     int user_stack_frames;                /**< Number of pages allocated for user stack */
     unsigned int user_stack_region_start; /**< First logical page reserved for the stack region */
@@ -69,12 +97,39 @@ struct task_struct {
     unsigned long user_entry;             /**< User entry point used on first dispatch */
 
     /* Keyboard support fields */
-    void (*kbd_handler)(char key, int pressed); /**< User callback function */
+    void *kbd_handler;                          /**< User callback, called by kbd_wrapper */
     void (*kbd_wrapper)(void);                  /**< User wrapper function address */
     void *kbd_aux_stack;                        /**< Auxiliary stack for keyboard handler */
     int in_kbd_context;                         /**< Flag: 1 if currently in keyboard context */
+    int kbd_batch;                              /**< 1 if kbd_handler takes event batches */
+    int kbd_queued;                             /**< Events queued for the handler */
+    struct kbd_ring *kbd_ring;                  /**< Event ring for read_keys (master only) */
+    int kbd_wait_ticks;                         /**< read_keys ticks left (-1: no limit) */
     unsigned long kbd_saved_ctx[SW_AND_HW_CONTEXT_SIZE]; /**< Saved full context (SW + HW) before
                                         handler (11 SW + 5 HW registers) */
+
+    /* FPU support fields */
+    int fpu_used; /**< 1 if fpu_states[] holds a valid saved FPU/SSE state */
+
+    /* Batched syscalls (see uring.h) */
+    struct uring *uring; /**< Registered submission/completion rings (master only) */
+
+    /* Syscall preemption */
+    int in_preempt_point; /**< 1 while the task has interrupts open inside a syscall */
+
+    /* Deadline scheduling fields (see edf.h) */
+    int sched_policy;        /**< SCHED_RR or SCHED_EDF */
+    int edf_period;          /**< Period in ticks */
+    int edf_runtime;         /**< Budget per job in ticks */
+    int edf_deadline;        /**< Relative deadline in ticks */
+    int edf_abs_deadline;    /**< Absolute deadline of the current job (tick) */
+    int edf_next_release;    /**< Tick at which the next job is released */
+    int edf_budget;          /**< Ticks left for the current job */
+    int edf_job_done;        /**< 1 once the current job called sched_waitperiod */
+    int edf_job_missed;      /**< 1 once the current job was counted as a miss */
+    int edf_activations;     /**< Jobs released */
+    int edf_misses;          /**< Deadline misses */
+    int edf_overruns;        /**< Jobs throttled for exhausting their budget */
 };
 
 /** Union for process data and stack */
@@ -118,6 +173,33 @@ extern struct list_head tick_blockedqueue;
  */
 struct task_struct *list_head_to_task_struct(struct list_head *l);
 
+/** Number of context switches performed since boot */
+extern unsigned long nr_context_switches;
+
+/**
+ * @brief Let pending interrupts run at a safe point of a long syscall.
+ *
+ * Briefly enables interrupts so the clock and keyboard IRQs are not held
+ * off for the whole syscall. The clock may preempt the caller here, so
+ * callers must not hold shared kernel state (buffers, temporary
+ * mappings, half-updated queues) across the call. Keyboard events that
+ * arrive in the window are deferred until the syscall returns.
+ *
+ * @return 1 if another task ran during the window, 0 otherwise.
+ */
+int preempt_point(void);
+
+/**
+ * @brief Get the index of a task in the tasks[] array.
+ *
+ * Used to locate per-task resources that live in arrays parallel to
+ * tasks[], such as page directories or FPU save areas.
+ *
+ * @param task Pointer to the task structure.
+ * @return Index of the task_union containing the task.
+ */
+int get_task_index(struct task_struct *task);
+
 /**
  * @brief Get page directory for a task.
  *
@@ -153,10 +235,35 @@ int allocate_DIR(struct task_struct *task);
  * @brief CPU idle function executed by the idle task.
  *
  * This function implements the idle process behavior - enables interrupts
- * and enters an infinite loop, consuming minimal CPU cycles.
+ * and enters an infinite loop that halts the CPU until the next
+ * interrupt. Each pass lets the clock stop the tick until the next timed
+ * event and accounts the halted time as idle (see cpuload.h).
  */
 void cpu_idle(void);
 
+/** sched_idle_ticks() result when no timed event is pending */
+#define SCHED_IDLE_FOREVER 0x7fffffff
+
+/**
+ * @brief Ticks the idle CPU can sleep before the scheduler needs a tick.
+ *
+ * Ready threads, threads waiting for the next tick, read_keys timeouts
+ * (counted down tick by tick), the profiler and unfinished bottom halves
+ * need every tick; EDF threads need the tick of their next release.
+ *
+ * @return Ticks until the next timed event (0 if the next tick is
+ *         needed), or SCHED_IDLE_FOREVER.
+ */
+int sched_idle_ticks(void);
+
+/**
+ * @brief Count the runnable threads.
+ *
+ * @return Threads in the ready queues, plus the running one unless it
+ *         is the idle task.
+ */
+int sched_nr_running(void);
+
 /**
  * @brief Initialize the idle task.
  *
@@ -223,7 +330,7 @@ int get_next_pid(void);
 /**
  * @brief Initialize TID slots for a process.
  *
- * This function initializes all TID slots as free except slot 0 (master).
+ * This function clears the TID bitmap and marks slot 0 (master) as used.
  *
  * @param master Pointer to the master thread of the process.
  */
@@ -232,7 +339,8 @@ void init_tid_slots(struct task_struct *master);
 /**
  * @brief Allocate next available TID for a process.
  *
- * This function finds the next available TID slot and returns TID = PID*10 + slot.
+ * This function finds the first clear bit of the TID bitmap, one word
+ * at a time, and returns TID = PID*MAX_TIDS_PER_PROCESS + slot.
  *
  * @param master Pointer to the master thread of the process.
  * @return The allocated TID, or -1 if no slots are available.
@@ -249,6 +357,41 @@ int allocate_tid(struct task_struct *master);
  */
 void free_tid(struct task_struct *master, int tid);
 
+/**
+ * @brief Initialize the PID and TID hash tables.
+ */
+void init_id_hash(void);
+
+/**
+ * @brief Make a task reachable by TID (and by PID if it is a master).
+ *
+ * @param task Task whose PID and TID are already assigned.
+ */
+void id_hash_add(struct task_struct *task);
+
+/**
+ * @brief Remove a task from the PID and TID hash tables.
+ *
+ * @param task Task being released.
+ */
+void id_hash_del(struct task_struct *task);
+
+/**
+ * @brief Find a live process by PID.
+ *
+ * @param pid Process identifier.
+ * @return Master thread of the process (zombies included), or NULL.
+ */
+struct task_struct *find_task_by_pid(int pid);
+
+/**
+ * @brief Find a live thread by TID.
+ *
+ * @param tid Thread identifier.
+ * @return Thread with that TID, or NULL.
+ */
+struct task_struct *find_task_by_tid(int tid);
+
 /**
  * @brief Get quantum value for a task.
  *
@@ -306,12 +449,23 @@ void update_process_state_rr(struct task_struct *task, struct list_head *dest_qu
  */
 void sched_next_rr(void);
 
+/**
+ * @brief Account a clock tick.
+ *
+ * Called by the clock interrupt once per interrupt, even when the
+ * switch is left to an interrupted bottom half: charges the quantum,
+ * releases EDF jobs, counts down read_keys timeouts and wakes the
+ * threads waiting for the tick.
+ */
+void sched_tick(void);
+
 /**
  * @brief Main scheduler function.
  *
  * This function implements the main scheduling logic, calling the
  * appropriate scheduling policy functions to determine if a context
- * switch is needed and performing it if necessary.
+ * switch is needed and performing it if necessary. It does no tick
+ * accounting, so blocking calls may use it too.
  */
 void scheduler(void);
 
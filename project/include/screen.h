@@ -5,12 +5,22 @@
  * This header provides direct screen buffer writing capability
  * through file descriptor 10, enabling efficient full-screen updates
  * for animations, games, and graphical text interfaces.
+ *
+ * By default frames are copied into the console screen while it is
+ * displayed, so the display may show half of a frame. The flip modes
+ * (set_present_mode) alternate between SCREEN_PAGES pages of video
+ * memory past the console rows: each frame is written to the page that
+ * is not shown, then shown by CRTC start address, optionally in step
+ * with the vertical retrace. Frames are presented one at a time.
  */
 
 #ifndef __SCREEN_H__
 #define __SCREEN_H__
 
 #include <io.h>
+#include <screen_data.h>
+
+struct task_struct;
 
 #define SCREEN_METHOD_WORD_LOOP 0xA      /**< Word-by-word C loop (slowest) */
 #define SCREEN_METHOD_COPY_FROM_USER 0xB /**< copy_from_user() (medium) */
@@ -19,6 +29,9 @@
 /** Selected copy method for screen buffer to video memory */
 #define SCREEN_COPY_METHOD SCREEN_METHOD_REP_MOVSL
 
+/** Longest wait for a vertical retrace edge in SCREEN_PRESENT_VSYNC mode */
+#define SCREEN_VSYNC_TIMEOUT_MS 50
+
 /** Global frame counter - incremented each time a full screen is written */
 extern int frame_count;
 
@@ -26,7 +39,10 @@ extern int frame_count;
  * @brief Write frame buffer directly to screen memory.
  *
  * This function copies a user-space frame buffer directly to VGA video
- * memory at 0xb8000. Unlike sys_write_console(), this function:
+ * memory: at the console's screen (see console_screen()), or in a flip
+ * mode to the hidden page, which is then shown. A frame shorter than
+ * SCREEN_BUFFER_SIZE leaves the rest of the page as it was two frames
+ * before. Unlike sys_write_console(), this function:
  *   - Does NOT update cursor position (x, y)
  *   - Does NOT handle newlines or special characters
  *   - Does NOT perform scrolling
@@ -42,4 +58,24 @@ extern int frame_count;
  */
 int sys_write_screen(char *buffer, int size);
 
+/**
+ * @brief Set the presentation mode of the screen fd.
+ *
+ * Switching to SCREEN_PRESENT_DIRECT shows the console again.
+ *
+ * @param mode SCREEN_PRESENT_* mode.
+ * @return Previous mode, or -EINVAL for an unknown mode.
+ */
+int screen_set_present(int mode);
+
+/**
+ * @brief Show the console again when the process that set a flip mode exits.
+ *
+ * Also ends a frame left unfinished by one of the process's threads,
+ * so other writers do not wait for it.
+ *
+ * @param master Master thread of the terminating process.
+ */
+void screen_release(struct task_struct *master);
+
 #endif /* __SCREEN_H__ */
@@ -0,0 +1,14 @@
+/**
+ * @file screen_data.h
+ * @brief Screen fd presentation modes shared by the kernel and user space.
+ */
+
+#ifndef __SCREEN_DATA_H__
+#define __SCREEN_DATA_H__
+
+/** Presentation modes of FD_SCREEN (see set_present_mode) */
+#define SCREEN_PRESENT_DIRECT 0 /**< Frames are copied into the visible console screen */
+#define SCREEN_PRESENT_FLIP 1   /**< Frames go to a hidden page that is then shown */
+#define SCREEN_PRESENT_VSYNC 2  /**< Like SCREEN_PRESENT_FLIP, the flip waits for vertical retrace */
+
+#endif /* __SCREEN_DATA_H__ */
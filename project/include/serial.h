@@ -0,0 +1,117 @@
+/**
+ * @file serial.h
+ * @brief 16550 UART (COM1) driver for ZeOS.
+ *
+ * Debug output (FD_DEBUG, the kernel log echo, boot and trace dumps) is
+ * queued in a transmit ring and returns at once. The UART interrupt
+ * (IRQ 4) refills the 16-byte transmit FIFO each time it empties, so
+ * the bytes leave while the CPU does something else. Only a full ring
+ * makes a writer wait, feeding the FIFO itself until there is room.
+ *
+ * Bytes received are buffered for serial_read(), so a host can drive
+ * test programs through the port. Point the emulator's COM1 at a file
+ * (see .bochsrc) to collect the output.
+ *
+ * Until init_serial() finds the UART, debug output goes to the Bochs
+ * debug port (0xe9) as before.
+ */
+
+#ifndef __SERIAL_H__
+#define __SERIAL_H__
+
+/** Set to 0 to keep debug output on port 0xe9 */
+#define SERIAL_DEBUG 1
+
+/** Set to 0 to leave the receiver interrupt off */
+#define SERIAL_RX 1
+
+/** Base I/O port of COM1 */
+#define SERIAL_COM1 0x3F8
+
+/** Register offsets from the base port */
+#define SERIAL_DATA 0    /**< Receive buffer / transmit holding (DLAB = 0) */
+#define SERIAL_IER 1     /**< Interrupt enable (DLAB = 0) */
+#define SERIAL_DLL 0     /**< Divisor latch, low byte (DLAB = 1) */
+#define SERIAL_DLM 1     /**< Divisor latch, high byte (DLAB = 1) */
+#define SERIAL_IIR 2     /**< Interrupt identification (read) */
+#define SERIAL_FCR 2     /**< FIFO control (write) */
+#define SERIAL_LCR 3     /**< Line control */
+#define SERIAL_MCR 4     /**< Modem control */
+#define SERIAL_LSR 5     /**< Line status */
+#define SERIAL_MSR 6     /**< Modem status */
+#define SERIAL_SCRATCH 7 /**< Scratch register, used to detect the UART */
+
+/** Register bits */
+#define SERIAL_IER_RX 0x01      /**< Interrupt on received data */
+#define SERIAL_IER_TX 0x02      /**< Interrupt when the transmit FIFO empties */
+#define SERIAL_IIR_NONE 0x01    /**< No interrupt pending */
+#define SERIAL_IIR_ID 0x0E      /**< Interrupt source field */
+#define SERIAL_IIR_MSR 0x00     /**< Modem status change */
+#define SERIAL_IIR_TX 0x02      /**< Transmit FIFO empty */
+#define SERIAL_IIR_RX 0x04      /**< Received data available */
+#define SERIAL_IIR_LSR 0x06     /**< Line status error */
+#define SERIAL_IIR_TIMEOUT 0x0C /**< Received data left in the FIFO */
+#define SERIAL_FCR_INIT 0xC7    /**< Enable and clear the FIFOs, 14-byte receive trigger */
+#define SERIAL_LCR_8N1 0x03     /**< 8 data bits, no parity, 1 stop bit */
+#define SERIAL_LCR_DLAB 0x80    /**< Divisor latch access */
+#define SERIAL_MCR_INIT 0x0B    /**< DTR, RTS and OUT2 (routes the interrupt to the PIC) */
+#define SERIAL_LSR_DR 0x01      /**< Received data ready */
+#define SERIAL_LSR_THRE 0x20    /**< Transmit FIFO empty */
+
+/** Divisor of the 115200 baud clock: 1 for 115200 baud */
+#define SERIAL_DIVISOR 1
+
+/** Bytes the transmitter takes per interrupt */
+#define SERIAL_FIFO_SIZE 16
+
+/** Ring sizes (powers of two) */
+#define SERIAL_TX_SIZE 8192
+#define SERIAL_RX_SIZE 256
+
+/** Interrupt vector of COM1 (IRQ 4) */
+#define SERIAL_VECTOR 0x24
+
+/**
+ * @brief Detect and program COM1.
+ *
+ * Sets 115200 baud 8N1 with FIFOs and unmasks IRQ 4 in pic_mask. Called
+ * before interrupts are enabled.
+ *
+ * @return 1 if the UART answered, 0 otherwise.
+ */
+int init_serial(void);
+
+/**
+ * @brief Queue bytes for transmission.
+ *
+ * Returns once the bytes are in the ring; waits only while it is full.
+ *
+ * @param buffer Kernel buffer.
+ * @param size Bytes to send.
+ * @return size, or 0 without a UART.
+ */
+int serial_write(const char *buffer, int size);
+
+/**
+ * @brief Take received bytes.
+ *
+ * @param buffer Kernel buffer.
+ * @param size Room in buffer.
+ * @return Bytes copied (0 if nothing arrived), or -ENODEV without a UART.
+ */
+int serial_read(char *buffer, int size);
+
+/**
+ * @brief Check whether init_serial() found the UART.
+ *
+ * @return 1 if debug output goes to COM1, 0 if it goes to port 0xe9.
+ */
+int serial_present(void);
+
+/**
+ * @brief COM1 interrupt routine: fills the transmit FIFO and drains the
+ *        receiver.
+ */
+void serial_routine(void);
+
+#endif /* __SERIAL_H__ */
@@ -0,0 +1,61 @@
+/**
+ * @file smp.h
+ * @brief Multiprocessor detection for ZeOS.
+ *
+ * This header defines the per-CPU descriptors filled from the Intel
+ * MultiProcessor configuration table at boot. Only detection is done:
+ * application processors are never started, and current_task, the TSS,
+ * the idle task and the ready queue all belong to the bootstrap
+ * processor. The local APIC page is mapped (see lapic.h), but starting
+ * an AP still needs a real-mode trampoline and a GDT/TSS per CPU, and
+ * the kernel must stop relying on IF=0 for mutual exclusion first.
+ */
+
+#ifndef __SMP_H__
+#define __SMP_H__
+
+/** Maximum number of CPUs tracked */
+#define NR_CPUS 8
+
+/** MP floating pointer structure signature "_MP_" */
+#define MP_FLOAT_SIGNATURE 0x5f504d5f
+
+/** MP configuration table signature "PCMP" */
+#define MP_CONFIG_SIGNATURE 0x504d4350
+
+/** MP configuration table entry types */
+#define MP_ENTRY_PROCESSOR 0 /**< Processor entry (20 bytes) */
+
+/** Processor entry flags */
+#define MP_CPU_ENABLED (1 << 0) /**< CPU usable */
+#define MP_CPU_BSP (1 << 1)     /**< Bootstrap processor */
+
+/** CPUID.1:EDX bit reporting an on-chip local APIC */
+#define CPUID_EDX_APIC (1 << 9)
+
+/** Per-CPU descriptor */
+struct cpu_info {
+    int apic_id; /**< Local APIC ID */
+    int is_bsp;  /**< 1 for the bootstrap processor */
+    int online;  /**< 1 if the CPU is running kernel code */
+};
+
+/** CPUs described by the MP table (cpus[0] is always the bootstrap processor) */
+extern struct cpu_info cpus[NR_CPUS];
+
+/** Number of valid entries in cpus[] */
+extern int nr_cpus;
+
+/** 1 if the bootstrap processor has a local APIC */
+extern int smp_has_apic;
+
+/**
+ * @brief Detect the CPUs of the machine.
+ *
+ * Checks CPUID for a local APIC and parses the MP configuration table
+ * found in the BIOS area. Without a table, a single CPU is assumed.
+ * Only the bootstrap processor is marked online.
+ */
+void init_smp(void);
+
+#endif /* __SMP_H__ */
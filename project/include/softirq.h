@@ -0,0 +1,93 @@
+/**
+ * @file softirq.h
+ * @brief Interrupt bottom halves (softirqs and tasklets) for ZeOS.
+ *
+ * Interrupt handlers run with interrupts disabled, so work that can wait
+ * a little is deferred: the handler raises a softirq, and do_softirq()
+ * runs the raised handlers with interrupts enabled when the interrupt
+ * routine finishes, before the scheduler may switch tasks. Interrupts
+ * that arrive meanwhile only raise more work; the outermost do_softirq()
+ * runs it, up to SOFTIRQ_MAX_RESTART passes, and leaves the rest to the
+ * next interrupt or to the idle task.
+ *
+ * Tasklets are one-off functions queued by any handler (tasklet_schedule)
+ * and run in order by the SOFTIRQ_TASKLET softirq. A tasklet is queued at
+ * most once until it has run.
+ */
+
+#ifndef __SOFTIRQ_H__
+#define __SOFTIRQ_H__
+
+/** Softirq numbers, in the order they run */
+#define SOFTIRQ_CLOCK 0   /**< Tick work that can wait (overlay, utilization windows) */
+#define SOFTIRQ_TASKLET 1 /**< Tasklets queued with tasklet_schedule() */
+#define SOFTIRQ_KLOG 2    /**< Kernel log records waiting for the console */
+#define NR_SOFTIRQS 3
+
+/** Passes of do_softirq() over newly raised work before it gives up */
+#define SOFTIRQ_MAX_RESTART 10
+
+/** Deferred function queued with tasklet_schedule() */
+struct tasklet {
+    struct tasklet *next;             /**< Next queued tasklet */
+    void (*func)(unsigned long data); /**< Function to run */
+    unsigned long data;               /**< Argument of func */
+    int scheduled;                    /**< 1 from tasklet_schedule until func starts */
+};
+
+/** Static initializer for a tasklet running func(data) */
+#define TASKLET_INIT(func, data) {0, (func), (data), 0}
+
+/**
+ * @brief Set the handler of a softirq.
+ *
+ * @param nr Softirq number (SOFTIRQ_*).
+ * @param handler Function run with interrupts enabled when nr is raised.
+ */
+void open_softirq(int nr, void (*handler)(void));
+
+/**
+ * @brief Mark a softirq for the next do_softirq().
+ *
+ * Safe from any context; the handler runs at the next do_softirq().
+ *
+ * @param nr Softirq number (SOFTIRQ_*).
+ */
+void raise_softirq(int nr);
+
+/**
+ * @brief Check for raised softirqs.
+ *
+ * @return Nonzero if a softirq waits to run.
+ */
+int softirq_pending(void);
+
+/**
+ * @brief Check whether bottom halves are running.
+ *
+ * An interrupt taken while they run must not switch tasks: the
+ * interrupted do_softirq() finishes first.
+ *
+ * @return 1 inside do_softirq(), 0 otherwise.
+ */
+int in_softirq(void);
+
+/**
+ * @brief Run the raised softirqs with interrupts enabled.
+ *
+ * Called with interrupts disabled at the end of interrupt routines and
+ * by the idle task; returns with interrupts disabled. Does nothing when
+ * called from an interrupt nested in bottom halves.
+ */
+void do_softirq(void);
+
+/**
+ * @brief Queue a tasklet and raise SOFTIRQ_TASKLET.
+ *
+ * Does nothing if the tasklet is queued already.
+ *
+ * @param t Tasklet to run.
+ */
+void tasklet_schedule(struct tasklet *t);
+
+#endif /* __SOFTIRQ_H__ */
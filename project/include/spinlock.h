@@ -0,0 +1,93 @@
+/**
+ * @file spinlock.h
+ * @brief Spinlock primitives for ZeOS kernel data structures.
+ *
+ * ZeOS runs on one CPU (application processors are detected but not
+ * started, see smp.h), where kernel code already executes with
+ * interrupts disabled. The locks are only taken by code that can also
+ * run with interrupts enabled (clock, console, serial port, tasklets,
+ * CPU load); hot paths that always run with IF=0, such as the frame
+ * allocator and the scheduler queue transitions, go without until a
+ * second CPU runs kernel code. The irqsave variants also make a
+ * critical section safe against local interrupts.
+ */
+
+#ifndef __SPINLOCK_H__
+#define __SPINLOCK_H__
+
+#include <irqsoff.h>
+
+/** Spinlock: 0 = free, 1 = held */
+typedef struct {
+    volatile unsigned int locked;
+} spinlock_t;
+
+/** Static initializer for an unlocked spinlock */
+#define SPINLOCK_INIT {0}
+
+// clang-format off
+/**
+ * @brief Initialize a spinlock as unlocked.
+ *
+ * @param lock Spinlock to initialize.
+ */
+static inline void spin_lock_init(spinlock_t *lock) {
+    lock->locked = 0;
+}
+
+/**
+ * @brief Acquire a spinlock, busy-waiting while it is held.
+ *
+ * Uses an atomic XCHG and spins on plain reads (with PAUSE) to avoid
+ * bouncing the cache line while waiting.
+ *
+ * @param lock Spinlock to acquire.
+ */
+static inline void spin_lock(spinlock_t *lock) {
+    unsigned int old;
+    for (;;) {
+        old = 1;
+        __asm__ __volatile__("xchgl %0, %1" : "+r"(old), "+m"(lock->locked) : : "memory");
+        if (old == 0) return;
+        while (lock->locked) __asm__ __volatile__("pause" : : : "memory");
+    }
+}
+
+/**
+ * @brief Release a spinlock.
+ *
+ * @param lock Spinlock to release.
+ */
+static inline void spin_unlock(spinlock_t *lock) {
+    __asm__ __volatile__("" : : : "memory");
+    lock->locked = 0;
+}
+
+/**
+ * @brief Disable local interrupts and acquire a spinlock.
+ *
+ * @param lock Spinlock to acquire.
+ * @return Previous EFLAGS, to be passed to spin_unlock_irqrestore.
+ */
+static inline unsigned long spin_lock_irqsave(spinlock_t *lock) {
+    unsigned long flags;
+    __asm__ __volatile__("pushfl; popl %0; cli" : "=r"(flags) : : "memory");
+    if (flags & EFLAGS_IF) irqsoff_disabled();
+    spin_lock(lock);
+    return flags;
+}
+
+/**
+ * @brief Release a spinlock and restore the saved interrupt state.
+ *
+ * @param lock Spinlock to release.
+ * @param flags EFLAGS returned by spin_lock_irqsave.
+ */
+static inline void spin_unlock_irqrestore(spinlock_t *lock, unsigned long flags) {
+    spin_unlock(lock);
+    if (flags & EFLAGS_IF) irqsoff_enabled();
+    __asm__ __volatile__("pushl %0; popfl" : : "r"(flags) : "memory", "cc");
+}
+// clang-format on
+
+#endif /* __SPINLOCK_H__ */
@@ -4,11 +4,18 @@
  *
  * This header defines structures for tracking process execution statistics,
  * timing information, and performance metrics in the ZeOS kernel.
+ *
+ * sys_call_table.S also includes it, to check NR_SYSCALLS.
  */
 
 #ifndef __STATS_H__
 #define __STATS_H__
 
+/* System calls in sys_call_table, and slots of the per-syscall statistics */
+#define NR_SYSCALLS 47
+
+#ifndef __ASSEMBLER__
+
 /* Process statistics structure for performance monitoring */
 struct stats {
     unsigned long user_ticks;          /* Time spent executing in user mode */
@@ -21,4 +28,67 @@ struct stats {
     unsigned long remaining_ticks; /* Remaining quantum ticks for current execution */
 };
 
+/* Deadline scheduling statistics of a thread (see sched_getstats) */
+struct sched_stats {
+    int period;          /* Period in ticks (0 if the thread is not EDF) */
+    int runtime;         /* Budget per period in ticks */
+    int deadline;        /* Relative deadline in ticks */
+    int activations;     /* Jobs released since sched_setdeadline */
+    int deadline_misses; /* Jobs that did not finish before their deadline */
+    int budget_overruns; /* Jobs throttled for exhausting their runtime */
+};
+
+/* log2 latency buckets: bucket b counts calls of 2^b to 2^(b+1)-1 cycles */
+#define SYSCALL_HIST_BUCKETS 32
+
+/* Per-syscall instrumentation (see get_syscall_stats) */
+struct syscall_stats {
+    unsigned int calls;                      /* Calls made */
+    unsigned long long cycles;               /* TSC cycles from entry to return, summed */
+    unsigned int max_cycles;                 /* Slowest call */
+    unsigned int hist[SYSCALL_HIST_BUCKETS]; /* Latency histogram (system-wide only) */
+};
+
+/* How an interrupts-off window was opened (irqsoff_stats.max_tag) */
+#define IRQSOFF_TAG_KERNEL -1    /* cli/irqsave in kernel code */
+#define IRQSOFF_TAG_SYSCALL 0x100 /* System call entry: 0x100 + syscall number */
+                                  /* Other tags: vector of the interrupt or exception */
+
+/* log2 buckets of the clock interrupt latency, in PIT input clocks */
+#define IRQ_LATENCY_BUCKETS 16
+
+/* Interrupts-off windows and clock interrupt latency (see irqsoff_read) */
+struct irqsoff_stats {
+    unsigned int windows;         /* Windows closed (interrupts enabled again) */
+    unsigned long long cycles;    /* TSC cycles spent with interrupts off, summed */
+    unsigned int max_cycles;      /* Longest window */
+    unsigned int max_start_site;  /* Kernel address that disabled interrupts */
+    unsigned int max_end_site;    /* Kernel address that enabled them again */
+    int max_tag;                  /* IRQSOFF_TAG_* or vector that opened the window */
+    int max_pid;                  /* PID running when the window opened */
+    unsigned int irq_samples;     /* Clock interrupts measured */
+    unsigned int irq_latency_max; /* Worst clock interrupt delay, in PIT clocks */
+    unsigned int irq_latency_hist[IRQ_LATENCY_BUCKETS]; /* Bucket b: 2^b to 2^(b+1)-1 clocks */
+};
+
+/* Utilization windows kept by the kernel (see get_cpu_stats) */
+#define CPULOAD_HISTORY 16
+
+/* Load averages are fixed point: LOAD_FIXED_1 is a load of 1.0 */
+#define LOAD_FSHIFT 11
+#define LOAD_FIXED_1 (1 << LOAD_FSHIFT)
+
+/* CPU utilization and load averages (see get_cpu_stats) */
+struct cpu_stats {
+    unsigned int loadavg[3];            /* 1, 5 and 15 minute load averages */
+    unsigned int window_ms;             /* Length of a utilization window */
+    unsigned int windows;               /* Windows closed since boot */
+    unsigned int util[CPULOAD_HISTORY]; /* Busy permille of the last windows, util[0] newest */
+    unsigned long long busy_cycles;     /* TSC cycles not spent halted, since boot */
+    unsigned long long idle_cycles;     /* TSC cycles halted in the idle task */
+    unsigned int halts;                 /* Times the idle task halted the CPU */
+};
+
+#endif /* __ASSEMBLER__ */
+
 #endif /* __STATS_H__ */
@@ -9,7 +9,13 @@
 #ifndef __SYS_H__
 #define __SYS_H__
 
+#include <clock_data.h>
+#include <kbd_event.h>
+#include <prof_data.h>
 #include <sched.h>
+#include <stats.h>
+#include <trace_data.h>
+#include <uring_data.h>
 
 /** System buffer size for kernel operations */
 #define SYS_BUFFER_SIZE 256
@@ -160,10 +166,40 @@ int sys_gettime(void);
 /**
  * @brief Terminate the current process.
  *
- * This function terminates the calling process, freeing its resources
- * and scheduling a new process to run.
+ * This function terminates the calling process, freeing its threads, user
+ * pages and keyboard resources, and schedules a new process to run.
+ * If the process has a parent other than idle, its master task_struct
+ * stays as a zombie (ST_ZOMBIE) holding the exit code until the parent
+ * reaps it with waitpid(). A parent blocked in waitpid() for this process
+ * is woken up directly. Children of the exiting process are reparented
+ * to idle, and zombie children are released immediately.
+ *
+ * @param status Exit code reported to the parent through waitpid().
+ */
+void sys_exit(int status);
+
+/**
+ * @brief Wait for a child process to terminate.
+ *
+ * Searches the children of the calling thread for one that matches pid.
+ * If a matching child is already a zombie, it is reaped: its task_struct
+ * is returned to the free queue and its exit code is stored in *status.
+ * Otherwise the caller blocks until a matching child exits, unless
+ * WNOHANG is given, in which case it returns 0 immediately.
+ *
+ * A thread blocked in waitpid() is not woken up by unblock().
+ *
+ * @param pid PID of the child to wait for, or -1 for any child.
+ * @param status User pointer where the exit code is stored (may be NULL).
+ * @param options 0 or WNOHANG.
+ * @return PID of the reaped child, 0 if WNOHANG and no child has exited,
+ *         or -1 on error with errno set to:
+ *         -ECHILD if there is no matching child
+ *         -EINVAL if pid or options are invalid
+ *         -EFAULT if status is not a valid user address
+ *         -EINPROGRESS if called from within a keyboard handler
  */
-void sys_exit(void);
+int sys_waitpid(int pid, int *status, int options);
 
 /**
  * @brief Block the current process.
@@ -179,7 +215,11 @@ int sys_block(void);
 /**
  * @brief Unblock a child process.
  *
- * This function unblocks a child process identified by its PID.
+ * This function unblocks a child process identified by its PID. Only
+ * a child sleeping in block() is woken up; otherwise the unblock is
+ * counted and consumed by the child's next block() call, so children
+ * waiting in waitpid, for a tick or for their next EDF release keep
+ * waiting.
  *
  * @param pid Process ID of the child to unblock.
  * @return 0 on success, -1 on error with errno set to:
@@ -200,6 +240,49 @@ int sys_unblock(int pid);
  */
 int sys_waitfortick(void);
 
+/**
+ * @brief Yield the CPU to the next ready thread.
+ *
+ * Moves the current thread to the tail of the ready queue and runs the
+ * next ready thread. Returns immediately if no other round robin thread
+ * is ready and no EDF job has priority over the caller.
+ *
+ * @return 0 on success, -EINPROGRESS if called from within a keyboard handler
+ */
+int sys_yield(void);
+
+/**
+ * @brief Move the current thread into the EDF scheduling class.
+ *
+ * The thread is admitted only if the total EDF utilization stays below
+ * EDF_MAX_UTILIZATION. Its first job is released immediately.
+ *
+ * @param period Period in ticks (0 returns the thread to round robin).
+ * @param runtime Budget per period in ticks.
+ * @param deadline Relative deadline in ticks (0 means equal to period).
+ * @return 0 on success, -EINVAL for inconsistent parameters, -EBUSY if
+ *         admission fails, -EINPROGRESS from a keyboard handler.
+ */
+int sys_sched_setdeadline(int period, int runtime, int deadline);
+
+/**
+ * @brief Finish the current EDF job and sleep until the next period.
+ *
+ * @return 0 on success, -EINVAL if the thread is not EDF,
+ *         -EINPROGRESS from a keyboard handler.
+ */
+int sys_sched_waitperiod(void);
+
+/**
+ * @brief Read the deadline statistics of a thread of the current process.
+ *
+ * @param tid Thread identifier, or 0 for the calling thread.
+ * @param stats User pointer receiving the statistics.
+ * @return 0 on success, -ESRCH if tid is not a thread of this process,
+ *         -EFAULT for an invalid pointer, -EINPROGRESS from a keyboard handler.
+ */
+int sys_sched_getstats(int tid, struct sched_stats *stats);
+
 /**
  * @brief Create a new thread in the current process.
  *
@@ -254,4 +337,208 @@ void sys_exit_thread(void);
  */
 int sys_keyboard_event(void (*func)(char key, int pressed), void (*wrapper)(void));
 
+/**
+ * @brief Register a keyboard handler that receives events in batches.
+ *
+ * Like sys_keyboard_event, but the handler is called as
+ * func(events, count) with every event queued for the thread (at most
+ * KBD_BATCH_MAX), copied to the auxiliary stack. Events arriving while
+ * the handler runs are delivered in the next batch on the same upcall.
+ *
+ * @param func User batch handler, or NULL to disable keyboard events.
+ * @param wrapper User wrapper function that calls func and int 0x2b.
+ * @return 0 on success, -EFAULT for an invalid func or wrapper, -ENOMEM
+ *         if the auxiliary stack cannot be allocated, -EINPROGRESS from a
+ *         keyboard handler.
+ */
+int sys_keyboard_event_batch(void (*func)(struct kbd_event *events, int count),
+                             void (*wrapper)(void));
+
+/**
+ * @brief Register the submission/completion rings of the current process.
+ *
+ * @param ring User address of a struct uring, or NULL to unregister.
+ * @return 0 on success, -EFAULT for an invalid ring, -EINPROGRESS from a
+ *         keyboard handler.
+ */
+int sys_ring_setup(struct uring *ring);
+
+/**
+ * @brief Run queued operations of the registered rings.
+ *
+ * Each submission is executed like its system call and its result is
+ * posted to the completion ring.
+ *
+ * @param to_submit Maximum number of submissions to run.
+ * @return Number of submissions consumed, -EINVAL for a negative count,
+ *         -ENXIO without a registered ring, -EINPROGRESS from a keyboard
+ *         handler.
+ */
+int sys_ring_enter(int to_submit);
+
+/**
+ * @brief Map the kernel keyboard state read-only into the current process.
+ *
+ * The page holds a struct kbd_state updated by the keyboard IRQ. Calling
+ * it again returns the same address.
+ *
+ * @return User address of the state, or -EINPROGRESS from a keyboard handler.
+ */
+int sys_keyboard_state(void);
+
+/**
+ * @brief Read keyboard events buffered for the current process.
+ *
+ * The first call attaches an event ring to the process; the keyboard IRQ
+ * fills it from then on. Blocks on kbd_waitqueue while the ring is empty.
+ *
+ * @param buf User buffer for up to n events.
+ * @param n Maximum number of events to copy.
+ * @param timeout Ticks to wait, 0 to poll, KBD_WAIT_FOREVER to wait forever.
+ * @return Number of events copied (0 on timeout), -EINVAL for a negative n
+ *         or timeout below KBD_WAIT_FOREVER, -EFAULT for an invalid buffer,
+ *         -ENOMEM if no ring is free, -EINPROGRESS from a keyboard handler.
+ */
+int sys_read_keys(struct kbd_event *buf, int n, int timeout);
+
+/**
+ * @brief Read the counters and latency figures of one system call.
+ *
+ * @param nr System call number (0 to NR_SYSCALLS-1).
+ * @param pid 0 for system-wide figures, otherwise a PID whose threads'
+ *            figures are summed (the histogram is left empty).
+ * @param stats User pointer receiving the statistics.
+ * @return 0 on success, -EINVAL for an invalid nr, -ESRCH if the PID made no
+ *         recorded calls, -EFAULT for an invalid pointer, -EINPROGRESS from a
+ *         keyboard handler.
+ */
+int sys_get_syscall_stats(int nr, int pid, struct syscall_stats *stats);
+
+/**
+ * @brief Start the sampling profiler for the whole system.
+ *
+ * Samples left from a previous run are discarded.
+ *
+ * @param period Ticks between samples.
+ * @return 0 on success, -EINVAL if period is not positive, -EINPROGRESS
+ *         from a keyboard handler.
+ */
+int sys_prof_start(int period);
+
+/**
+ * @brief Stop the sampling profiler.
+ *
+ * @return Number of samples dropped because the ring was full, or
+ *         -EINPROGRESS from a keyboard handler.
+ */
+int sys_prof_stop(void);
+
+/**
+ * @brief Move buffered profiler samples to user space, oldest first.
+ *
+ * @param buf User buffer for up to n samples.
+ * @param n Maximum number of samples.
+ * @return Number of samples copied, -EINVAL for a negative n, -EFAULT for an
+ *         invalid buffer, -EINPROGRESS from a keyboard handler.
+ */
+int sys_prof_read(struct prof_sample *buf, int n);
+
+/**
+ * @brief Select the tracepoint categories that record events.
+ *
+ * @param mask TRACE_CAT_* bits; 0 stops tracing.
+ * @return Previous mask, -EINVAL for unknown bits, -EINPROGRESS from a
+ *         keyboard handler.
+ */
+int sys_trace_ctl(int mask);
+
+/**
+ * @brief Move trace records to user space, oldest first.
+ *
+ * @param buf User buffer for up to n records.
+ * @param n Maximum number of records.
+ * @return Number of records copied, -EINVAL for a negative n, -EFAULT for an
+ *         invalid buffer, -EINPROGRESS from a keyboard handler.
+ */
+int sys_trace_read(struct trace_record *buf, int n);
+
+/**
+ * @brief Copy the interrupts-off tracer statistics to user space.
+ *
+ * @param stats User pointer receiving the statistics.
+ * @param reset If nonzero, clear the statistics after copying them.
+ * @return 0 on success, -EFAULT for an invalid pointer, -EINPROGRESS from
+ *         a keyboard handler.
+ */
+int sys_irqsoff_read(struct irqsoff_stats *stats, int reset);
+
+/**
+ * @brief Read a clock with microsecond resolution.
+ *
+ * @param clock_id CLOCK_MONOTONIC.
+ * @param tp User pointer receiving the time.
+ * @return 0 on success, -EINVAL for an unknown clock, -EFAULT for an
+ *         invalid pointer.
+ */
+int sys_clock_gettime(int clock_id, struct timespec *tp);
+
+/**
+ * @brief Change the clock tick rate.
+ *
+ * @param hz New ticks per second (CLOCK_MIN_HZ to CLOCK_MAX_HZ), or 0 to
+ *           only read the current rate.
+ * @return Previous rate, -EINVAL for a rate out of range, -EINPROGRESS
+ *         from a keyboard handler.
+ */
+int sys_set_tick_rate(int hz);
+
+/**
+ * @brief Copy the clock statistics to user space.
+ *
+ * @param stats User pointer receiving the statistics.
+ * @return 0 on success, -EFAULT for an invalid pointer, -EINPROGRESS from
+ *         a keyboard handler.
+ */
+int sys_clock_getstats(struct clock_stats *stats);
+
+/**
+ * @brief Copy the CPU utilization and load averages to user space.
+ *
+ * @param stats User pointer receiving the statistics.
+ * @return 0 on success, -EFAULT for an invalid pointer, -EINPROGRESS from
+ *         a keyboard handler.
+ */
+int sys_get_cpu_stats(struct cpu_stats *stats);
+
+/**
+ * @brief Take the bytes received on COM1 without waiting.
+ *
+ * @param buffer User buffer.
+ * @param size Room in buffer (at most SERIAL_RX_SIZE bytes are copied).
+ * @return Bytes copied (0 if nothing arrived), -EINVAL for a negative
+ *         size, -EFAULT for an invalid buffer, -ENODEV without a UART,
+ *         -EINPROGRESS from a keyboard handler.
+ */
+int sys_serial_read(char *buffer, int size);
+
+/**
+ * @brief Copy the newest kernel log text to user space.
+ *
+ * @param buffer User buffer.
+ * @param size Room in buffer.
+ * @return Bytes copied, -EINVAL for a negative size, -EFAULT for an
+ *         invalid buffer, -EINPROGRESS from a keyboard handler.
+ */
+int sys_dmesg(char *buffer, int size);
+
+/**
+ * @brief Choose how frames written to the screen fd are presented.
+ *
+ * @param fd File descriptor (only FD_SCREEN has presentation modes).
+ * @param mode SCREEN_PRESENT_* mode.
+ * @return Previous mode, -EBADF for another fd, -EINVAL for an unknown
+ *         mode, -EINPROGRESS from a keyboard handler.
+ */
+int sys_set_present_mode(int fd, int mode);
+
 #endif /* __SYS_H__ */
@@ -0,0 +1,56 @@
+/**
+ * @file syscall_stats.h
+ * @brief Per-syscall instrumentation for ZeOS.
+ *
+ * When SYSCALL_STATS is enabled the SYSENTER handler dispatches through
+ * syscall_dispatch(), which counts every call and measures its latency
+ * in TSC cycles from dispatch to return (time spent blocked included).
+ * Counts and cycles are kept system-wide, with a log2 histogram, and per
+ * thread slot tagged with its PID, so they can be summed per process.
+ * The dispatch also hosts the syscall entry/exit tracepoints.
+ *
+ * This header is also included by entry.S for SYSCALL_STATS.
+ */
+
+#ifndef __SYSCALL_STATS_H__
+#define __SYSCALL_STATS_H__
+
+/** Set to 0 to dispatch syscalls directly, without instrumentation */
+#define SYSCALL_STATS 1
+
+#ifndef __ASSEMBLER__
+
+#include <stats.h>
+
+/**
+ * @brief Instrumented syscall dispatch, called by the SYSENTER handler.
+ *
+ * The parameters are the registers saved by SAVE_ALL, read in place on
+ * the kernel stack: the first five are passed on to the system call.
+ *
+ * @param ebx First syscall argument.
+ * @param ecx Second syscall argument.
+ * @param edx Third syscall argument.
+ * @param esi Fourth syscall argument.
+ * @param edi Fifth syscall argument.
+ * @param ebp Saved user EBP (unused).
+ * @param nr System call number, already range-checked.
+ * @return The system call's return value.
+ */
+int syscall_dispatch(unsigned long ebx, unsigned long ecx, unsigned long edx, unsigned long esi,
+                     unsigned long edi, unsigned long ebp, int nr);
+
+/**
+ * @brief Read the statistics of one system call.
+ *
+ * @param nr System call number.
+ * @param pid 0 for system-wide figures, otherwise a PID whose threads'
+ *            figures are summed (the histogram is only kept system-wide).
+ * @param stats Kernel buffer receiving the statistics.
+ * @return 0 on success, -ESRCH if no thread with that PID has been recorded.
+ */
+int syscall_stats_get(int nr, int pid, struct syscall_stats *stats);
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* __SYSCALL_STATS_H__ */
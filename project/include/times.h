@@ -6,8 +6,8 @@
  * All time-related constants are defined here to facilitate easy adjustment
  * of timing behavior across the entire system.
  *
- * The TIME_ADJUSTMENT factor compensates for differences between expected
- * and actual timer behavior in the emulation environment.
+ * The tick rate is measured at boot (see clock.h): TICKS_PER_SECOND and
+ * every interval below are evaluated at run time from it.
  */
 
 #ifndef __TIMES_H__
@@ -18,62 +18,54 @@
  *============================================================================*/
 
 /**
- * @brief Time adjustment factor for emulation environment.
- *
- * This factor compensates for the difference between expected timer frequency
- * and actual timer behavior. Adjust this value based on calibration tests.
- *
- * - 1.0 = No adjustment (theoretical 1000 Hz timer)
- * - 0.8 = Timer runs 20% faster than expected
- * - 1.2 = Timer runs 20% slower than expected
+ * @brief Clock interrupt rate programmed into the PIT at boot.
  */
-#define TIME_ADJUSTMENT 0.32
+#define BASE_TICKS_PER_SECOND 1000
 
 /**
- * @brief Base ticks per second (theoretical value before adjustment).
+ * @brief Clock interrupts per second.
+ *
+ * Implemented by the kernel (from the PIT reload value) and by libc
+ * (from the shared page), so the same constants work on both sides.
  *
- * The PIT is configured to generate approximately 1000 interrupts per second.
- * This is the base value used for all time calculations.
+ * @return Ticks per second.
  */
-#define BASE_TICKS_PER_SECOND 1000
+int ticks_per_second(void);
 
 /**
- * @brief Effective ticks per second after adjustment.
- *
- * This is the actual number of ticks that represent one real second,
- * taking into account the TIME_ADJUSTMENT factor.
+ * @brief Ticks that make one real second.
  */
-#define TICKS_PER_SECOND ((int)(BASE_TICKS_PER_SECOND * TIME_ADJUSTMENT))
+#define TICKS_PER_SECOND (ticks_per_second())
 
 /**
- * @brief One second in ticks (adjusted).
+ * @brief One second in ticks.
  *
  * Use this constant when you need to wait or measure one second.
  */
 #define ONE_SECOND TICKS_PER_SECOND
 
 /**
- * @brief Half second in ticks (adjusted).
+ * @brief Half second in ticks.
  */
 #define HALF_SECOND (TICKS_PER_SECOND / 2)
 
 /**
- * @brief Quarter second in ticks (adjusted).
+ * @brief Quarter second in ticks.
  */
 #define QUARTER_SECOND (TICKS_PER_SECOND / 4)
 
 /**
- * @brief Eighth second in ticks (adjusted).
+ * @brief Eighth second in ticks.
  */
 #define EIGHTH_SECOND (TICKS_PER_SECOND / 8)
 
 /**
- * @brief Sixteenth second in ticks (adjusted).
+ * @brief Sixteenth second in ticks.
  */
 #define SIXTEENTH_SECOND (TICKS_PER_SECOND / 16)
 
 /**
- * @brief Thirty-second second in ticks (adjusted).
+ * @brief Thirty-second second in ticks.
  */
 #define THIRTY_SECOND (TICKS_PER_SECOND / 32)
 
@@ -84,14 +76,14 @@
 /**
  * @brief Convert milliseconds to ticks.
  * @param ms Milliseconds to convert.
- * @return Equivalent ticks after adjustment.
+ * @return Equivalent ticks, rounded down.
  */
-#define MS_TO_TICKS(ms) ((int)((ms)*TIME_ADJUSTMENT))
+#define MS_TO_TICKS(ms) ((int)((ms)*TICKS_PER_SECOND / 1000))
 
 /**
  * @brief Convert seconds to ticks.
  * @param s Seconds to convert.
- * @return Equivalent ticks after adjustment.
+ * @return Equivalent ticks.
  */
 #define SECONDS_TO_TICKS(s) ((s)*TICKS_PER_SECOND)
 
@@ -137,14 +129,11 @@
 #define TIME_FPS_TEST_DURATION SECONDS_TO_TICKS(60)
 
 /** @brief Tick calibration test duration in seconds */
-#define TIME_CALIBRATION_SECONDS 10
+#define TIME_CALIBRATION_SECONDS 2
 
 /** @brief Tick calibration expected ticks */
 #define TIME_CALIBRATION_TICKS SECONDS_TO_TICKS(TIME_CALIBRATION_SECONDS)
 
-/** @brief Countdown before calibration starts */
-#define TIME_CALIBRATION_COUNTDOWN SECONDS_TO_TICKS(3)
-
 /*============================================================================*
  *                    FPS DISPLAY CONFIGURATION                               *
  *============================================================================*/
@@ -153,11 +142,9 @@
  * @brief FPS display update interval.
  *
  * FPS is calculated as: frames_written_since_last_update
- * We use BASE_TICKS_PER_SECOND (1000) to get real FPS regardless of
- * TIME_ADJUSTMENT. This ensures the displayed FPS matches the actual
- * frames rendered per real second.
+ * over one second, so the displayed FPS is frames per real second.
  */
-#define FPS_UPDATE_INTERVAL BASE_TICKS_PER_SECOND
+#define FPS_UPDATE_INTERVAL TICKS_PER_SECOND
 
 /*============================================================================*
  *                    GAME FPS LIMITING                                       *
@@ -172,10 +159,9 @@
  * @brief Ticks per frame at target FPS.
  *
  * This is the minimum number of ticks that should pass between frames.
- * We use BASE_TICKS_PER_SECOND (1000) to get real 120 FPS timing regardless
- * of TIME_ADJUSTMENT. At 1000 Hz with TARGET_FPS=120, we wait ~8 ticks.
+ * At 1000 Hz with TARGET_FPS=120, we wait ~8 ticks.
  */
-#define TICKS_PER_FRAME (BASE_TICKS_PER_SECOND / TARGET_FPS)
+#define TICKS_PER_FRAME (TICKS_PER_SECOND / TARGET_FPS)
 
 /**
  * @brief Minimum ticks per frame (fallback if TICKS_PER_FRAME is 0).
@@ -0,0 +1,63 @@
+/**
+ * @file trace.h
+ * @brief Kernel event tracing for ZeOS.
+ *
+ * Tracepoints call trace_event(), which returns at once unless their
+ * category is enabled. Enabled tracepoints reserve a slot of a global
+ * ring with a compare-and-swap on its tail, fill it, and publish it by
+ * storing the record type last, so tracepoints nested in interrupts
+ * need no lock. When the ring is full, records are dropped and counted
+ * in the next stored record.
+ */
+
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+#include <trace_data.h>
+
+/** Records held by the ring */
+#define TRACE_RING_SIZE 1024
+
+/** Enabled categories (TRACE_CAT_* bits) */
+extern unsigned int trace_mask;
+
+/**
+ * @brief Store a record for the running thread. Use trace_event().
+ *
+ * @param event TRACE_* record type.
+ * @param arg0 First argument.
+ * @param arg1 Second argument.
+ */
+void trace_record(int event, unsigned int arg0, unsigned int arg1);
+
+/**
+ * @brief Tracepoint: record an event if its category is enabled.
+ *
+ * @param category TRACE_CAT_* bit of the tracepoint.
+ * @param event TRACE_* record type.
+ * @param arg0 First argument.
+ * @param arg1 Second argument.
+ */
+static inline void trace_event(unsigned int category, int event, unsigned int arg0,
+                               unsigned int arg1) {
+    if (trace_mask & category) trace_record(event, arg0, arg1);
+}
+
+/**
+ * @brief Set the enabled categories.
+ *
+ * @param mask TRACE_CAT_* bits; 0 stops tracing.
+ * @return Previous mask, or -EINVAL for unknown bits.
+ */
+int trace_ctl(int mask);
+
+/**
+ * @brief Move published records, oldest first, to a user buffer.
+ *
+ * @param buf User buffer, already checked for n records.
+ * @param n Maximum number of records.
+ * @return Number of records copied.
+ */
+int trace_read(struct trace_record *buf, int n);
+
+#endif /* __TRACE_H__ */
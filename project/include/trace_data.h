@@ -0,0 +1,46 @@
+/**
+ * @file trace_data.h
+ * @brief Binary trace records shared by user space and the kernel.
+ *
+ * Kernel tracepoints append fixed-size records, timestamped with the
+ * TSC, to a ring read with trace_read(). Each tracepoint belongs to a
+ * category that trace_ctl() enables at run time; a disabled tracepoint
+ * costs one test of the category mask. The host tool trace2json turns
+ * dumped records into Chrome trace JSON.
+ */
+
+#ifndef __TRACE_DATA_H__
+#define __TRACE_DATA_H__
+
+/** Tracepoint categories (trace_ctl mask bits) */
+#define TRACE_CAT_SCHED (1 << 0)   /**< Context switches and wakeups */
+#define TRACE_CAT_PROC (1 << 1)    /**< fork, thread creation, thread and process exit */
+#define TRACE_CAT_FAULT (1 << 2)   /**< Page faults */
+#define TRACE_CAT_IRQ (1 << 3)     /**< Hardware interrupt entry and exit */
+#define TRACE_CAT_SYSCALL (1 << 4) /**< System call entry and exit */
+#define TRACE_CAT_ALL 0x1f         /**< Every category */
+
+/** Record types and the meaning of their arguments */
+#define TRACE_SWITCH 1        /**< args: next PID, next TID */
+#define TRACE_WAKEUP 2        /**< args: woken PID, woken TID */
+#define TRACE_FORK 3          /**< args: child PID, child TID */
+#define TRACE_THREAD_CREATE 4 /**< args: new TID */
+#define TRACE_THREAD_EXIT 5   /**< args: exiting TID */
+#define TRACE_EXIT 6          /**< args: exit status */
+#define TRACE_PAGE_FAULT 7    /**< args: faulting EIP, faulting address */
+#define TRACE_IRQ_ENTRY 8     /**< args: IRQ line */
+#define TRACE_IRQ_EXIT 9      /**< args: IRQ line */
+#define TRACE_SYSCALL_ENTRY 10 /**< args: syscall number, first argument */
+#define TRACE_SYSCALL_EXIT 11  /**< args: syscall number, return value */
+
+/** One trace record (28 bytes) */
+struct trace_record {
+    unsigned long long tsc; /**< TSC when the tracepoint was hit */
+    unsigned short event;   /**< TRACE_* record type */
+    unsigned short lost;    /**< Records dropped just before this one (ring full) */
+    int pid;                /**< Process running */
+    int tid;                /**< Thread running */
+    unsigned int args[2];   /**< Event arguments */
+};
+
+#endif /* __TRACE_DATA_H__ */
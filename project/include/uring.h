@@ -0,0 +1,37 @@
+/**
+ * @file uring.h
+ * @brief Kernel side of the batched submission/completion rings.
+ *
+ * Each process may register one struct uring living in its user memory.
+ * ring_enter() consumes queued submissions in order, runs each through
+ * the same code as the corresponding system call and posts its result
+ * in the completion ring, so a batch of operations costs one SYSENTER.
+ */
+
+#ifndef __URING_H__
+#define __URING_H__
+
+#include <sched.h>
+#include <uring_data.h>
+
+/**
+ * @brief Register the ring of the current process.
+ *
+ * @param ring User address of the ring, or NULL to unregister.
+ * @return 0 on success, -EFAULT if the ring is not writable user memory.
+ */
+int uring_setup(struct uring *ring);
+
+/**
+ * @brief Run up to to_submit queued operations of the current process.
+ *
+ * Stops early when the submission ring is empty or the completion ring
+ * is full. Operations that block (WaitForTick, sleep) block the caller.
+ *
+ * @param to_submit Maximum number of submissions to consume.
+ * @return Number of submissions consumed, -EINVAL for a negative count,
+ *         -ENXIO if no ring is registered.
+ */
+int uring_enter(int to_submit);
+
+#endif /* __URING_H__ */
@@ -0,0 +1,56 @@
+/**
+ * @file uring_data.h
+ * @brief Submission/completion ring layout shared by user space and the kernel.
+ *
+ * A process places a struct uring in its own memory and registers it
+ * with ring_setup(). It queues operations in the submission ring and
+ * runs any number of them with a single ring_enter() call. The kernel
+ * posts one completion per operation, which user space reads directly
+ * from the completion ring, without a system call.
+ */
+
+#ifndef __URING_DATA_H__
+#define __URING_DATA_H__
+
+/** Entries of each ring (power of two) */
+#define URING_ENTRIES 32
+
+/** Operation codes */
+#define URING_OP_NOP 0         /**< Completes with 0 */
+#define URING_OP_WRITE 1       /**< write(fd, buf, len) */
+#define URING_OP_GETTIME 2     /**< gettime() */
+#define URING_OP_WAITFORTICK 3 /**< WaitForTick() */
+#define URING_OP_SLEEP 4       /**< Wait for len clock ticks */
+
+/** Submission queue entry */
+struct uring_sqe {
+    int opcode;             /**< URING_OP_* */
+    int fd;                 /**< File descriptor (URING_OP_WRITE) */
+    char *buf;              /**< Data (URING_OP_WRITE) */
+    int len;                /**< Bytes (URING_OP_WRITE) or ticks (URING_OP_SLEEP) */
+    unsigned int user_data; /**< Copied to the completion */
+};
+
+/** Completion queue entry */
+struct uring_cqe {
+    unsigned int user_data; /**< user_data of the submission */
+    int res;                /**< Result: what the syscall returns, or -errno */
+};
+
+/**
+ * @brief Submission and completion rings.
+ *
+ * head and tail are free-running counters; an entry lives at index
+ * (counter % URING_ENTRIES). User space owns sq_tail and cq_head, the
+ * kernel owns sq_head and cq_tail.
+ */
+struct uring {
+    unsigned int sq_head;                  /**< Next submission the kernel consumes */
+    unsigned int sq_tail;                  /**< Next free submission slot */
+    unsigned int cq_head;                  /**< Next completion user space reads */
+    unsigned int cq_tail;                  /**< Next completion slot the kernel fills */
+    struct uring_sqe sqes[URING_ENTRIES]; /**< Submission ring */
+    struct uring_cqe cqes[URING_ENTRIES]; /**< Completion ring */
+};
+
+#endif /* __URING_DATA_H__ */
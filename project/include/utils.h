@@ -9,7 +9,7 @@
 #ifndef UTILS_H
 #define UTILS_H
 
-/** Number of cycles per tick */
+/** TSC cycles per millisecond assumed until the TSC is calibrated (see clock.h) */
 #define CYCLESPERTICK 109000
 
 /** Read access verification type */
@@ -0,0 +1,73 @@
+/**
+ * @file vdso.h
+ * @brief Kernel side of the page shared read-only with user space.
+ *
+ * One kernel page holding a struct vdso_data is mapped read-only at
+ * VDSO_PAGE in every process. The clock interrupt refreshes the time
+ * fields and the context switch stores the IDs of the thread about to
+ * run. With a single CPU running user code, a thread reading the IDs
+ * always sees its own.
+ */
+
+#ifndef __VDSO_H__
+#define __VDSO_H__
+
+#include <mm_address.h>
+#include <sched.h>
+#include <types.h>
+#include <vdso_data.h>
+
+/** Shared page, page-aligned so its frame can be mapped into user space */
+union vdso_page {
+    struct vdso_data data;
+    Byte bytes[PAGE_SIZE];
+} __attribute__((aligned(PAGE_SIZE)));
+
+/** Data published to user space */
+extern union vdso_page vdso_page;
+
+/**
+ * @brief Clear the shared page at boot and publish the clock rates.
+ */
+void init_vdso(void);
+
+/**
+ * @brief Publish the TSC calibration and the clock interrupt rate.
+ *
+ * Called at boot and whenever the tick rate changes.
+ */
+void vdso_clock_update(void);
+
+/**
+ * @brief Map the shared page read-only into a process.
+ *
+ * Called for init and for every forked child; threads share the mapping.
+ *
+ * @param task Master thread of the process.
+ */
+void vdso_map(struct task_struct *task);
+
+/**
+ * @brief Remove the shared page mapping of a terminating process.
+ *
+ * @param master Master thread of the process.
+ */
+void vdso_unmap(struct task_struct *master);
+
+/**
+ * @brief Publish the new tick count and refresh the TSC calibration.
+ *
+ * Called from the clock interrupt after zeos_ticks is incremented.
+ */
+void vdso_tick(void);
+
+/**
+ * @brief Publish the IDs of the thread about to run.
+ *
+ * Called from inner_task_switch.
+ *
+ * @param next Task that is about to run.
+ */
+void vdso_switch_to(struct task_struct *next);
+
+#endif /* __VDSO_H__ */
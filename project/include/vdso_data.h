@@ -0,0 +1,32 @@
+/**
+ * @file vdso_data.h
+ * @brief Layout of the kernel page shared read-only with every process.
+ *
+ * The kernel publishes the tick counter, the clock calibration and the
+ * IDs of the running thread in this page, so libc can read them without
+ * a system call (see fast_gettime, fast_getpid, fast_gettid and
+ * TICKS_PER_SECOND).
+ */
+
+#ifndef __VDSO_DATA_H__
+#define __VDSO_DATA_H__
+
+/**
+ * @brief Data published by the kernel in the shared page.
+ *
+ * The time fields change together under a sequence counter: seq is odd
+ * while the clock interrupt updates them, so readers retry until they
+ * see the same even value before and after reading.
+ */
+struct vdso_data {
+    unsigned int seq;           /**< Sequence counter of the time fields */
+    unsigned int ticks;         /**< Clock ticks since boot (gettime) */
+    unsigned int tsc_last_tick; /**< Low 32 bits of the TSC at the last tick */
+    unsigned int tsc_per_tick;  /**< TSC cycles per tick (running average, 0 until known) */
+    int pid;                    /**< PID of the running thread */
+    int tid;                    /**< TID of the running thread */
+    unsigned int tsc_khz;       /**< TSC cycles per millisecond, measured at boot */
+    int ticks_per_second;       /**< Clock interrupt rate */
+};
+
+#endif /* __VDSO_DATA_H__ */
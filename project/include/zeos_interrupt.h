@@ -160,7 +160,7 @@ void keyboard_routine();
  *
  * This function handles timer/clock hardware interrupts for system scheduling.
  */
-void clock_routine();
+void clock_routine(unsigned long *regs);
 
 /**
  * @brief Set up interrupt handlers.
@@ -20,6 +20,7 @@
 #define FORK_TEST               1   /**< Enable fork syscall test */
 #define EXIT_TEST               1   /**< Enable exit syscall test */
 #define BLOCK_UNBLOCK_TEST      1   /**< Enable block/unblock syscall test */
+#define WAITPID_TEST            1   /**< Enable waitpid/exit code syscall test */
 #define PAGEFAULT_TEST          0   /**< Enable page fault exception test */
 // clang-format on
 
@@ -119,6 +120,14 @@ void test_exit_syscall(void);
  */
 void test_block_unblock_syscalls(void);
 
+/**
+ * @brief Test waitpid system call functionality.
+ *
+ * This function tests waitpid() with exit codes, WNOHANG and
+ * the ECHILD error for non-children and already reaped children.
+ */
+void test_waitpid_syscall(void);
+
 /****************************************/
 /**    Helper Functions                **/
 /****************************************/
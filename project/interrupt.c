@@ -6,19 +6,29 @@
  * keyboard processing, timer management, and system call entry points.
  */
 
+#include <clock.h>
+#include <cpuload.h>
 #include <entry.h>
+#include <errno.h>
 #include <hardware.h>
 #include <interrupt.h>
 #include <io.h>
+#include <irqsoff.h>
 #include <kernel_helpers.h>
+#include <lapic.h>
 #include <keyboard.h>
+#include <profiler.h>
 #include <sched.h>
 #include <screen.h>
 #include <segment.h>
+#include <serial.h>
+#include <softirq.h>
 #include <sys.h>
 #include <times.h>
+#include <trace.h>
 #include <types.h>
 #include <utils.h>
+#include <vdso.h>
 #include <zeos_interrupt.h>
 
 /* Interrupt Descriptor Table - array of interrupt/trap gates */
@@ -82,6 +92,21 @@ void setTrapHandler(int vector, void (*handler)(), int maxAccessibleFromPL) {
     idt[vector].highOffset = highWord((DWord)handler);
 }
 
+/* Tick of the last overlay refresh */
+static int last_overlay_tick = 0;
+
+/* SOFTIRQ_CLOCK: the tick work that can run with interrupts enabled */
+static void clock_softirq(void) {
+    cpuload_tick();
+
+    /* Formatting and VGA writes at OVERLAY_REFRESH_MS, whatever the tick rate */
+    if (zeos_ticks - last_overlay_tick >= MS_TO_TICKS(OVERLAY_REFRESH_MS)) {
+        last_overlay_tick = zeos_ticks;
+        update_time_and_fps();
+        draw_time_and_fps();
+    }
+}
+
 void setIdt(void) {
     /* Program interrups/exception service routines */
     idtR.base = (DWord)idt;
@@ -93,6 +118,17 @@ void setIdt(void) {
     setInterruptHandler(32, clock_handler, 0);     /* IRQ 0: Timer */
     setInterruptHandler(33, keyboard_handler, 0);  /* IRQ 1: Keyboard (basic) */
     setInterruptHandler(14, pageFault_handler, 0); /* Exception 14: Page Fault */
+    setInterruptHandler(7, fpu_nm_handler, 0);     /* Exception 7: Lazy FPU switch */
+
+    /* Local APIC timer (one-shot ticks) and its spurious vector */
+    setInterruptHandler(LAPIC_TIMER_VECTOR, lapic_timer_handler, 0);
+    setInterruptHandler(LAPIC_SPURIOUS_VECTOR, lapic_spurious_handler, 0);
+
+    /* IRQ 4: COM1, unmasked by init_serial if the UART is there */
+    setInterruptHandler(SERIAL_VECTOR, serial_handler, 0);
+
+    /* Bottom half of the clock interrupt */
+    open_softirq(SOFTIRQ_CLOCK, clock_softirq);
 
     /* Keyboard event support: use kbd_irq_entry for user callbacks */
     setInterruptHandler(0x21, kbd_irq_entry, 0); /* IRQ 1 = INT 0x21 */
@@ -101,7 +137,7 @@ void setIdt(void) {
     setTrapHandler(0x2b, kbd_resume_entry, 3); /* DPL=3 for user access */
 
     writeMSR(0x174, __KERNEL_CS); // Set SYSENTER CS register - kernel code segment
-    writeMSR(0x175, INITIAL_ESP); // Set SYSENTER ESP register - kernel stack pointer
+    writeMSR(0x175, INITIAL_ESP); // Set SYSENTER ESP register - replaced by tss.esp0 on entry
     writeMSR(0x176, (unsigned long)syscall_handler_sysenter);
 
     set_idt_reg(&idtR);
@@ -121,14 +157,25 @@ void keyboard_routine(void) {
     }
 }
 
-void clock_routine(void) {
-    zeos_ticks++;
-    update_time_and_fps();
-    draw_time_and_fps();
-    scheduler();
+void clock_routine(unsigned long *regs) {
+    irq_latency_sample();
+    cpuload_idle_exit();
+    trace_event(TRACE_CAT_IRQ, TRACE_IRQ_ENTRY, 0, 0);
+    zeos_ticks += clock_advance();
+    vdso_tick();
+    prof_tick(regs);
+    sched_tick();
+    raise_softirq(SOFTIRQ_CLOCK);
+    /* The interrupt ends here; what follows is traced as a context switch */
+    trace_event(TRACE_CAT_IRQ, TRACE_IRQ_EXIT, 0, 0);
+    do_softirq();
+
+    /* A tick nested in the bottom halves leaves the switch to the interrupted one */
+    if (!in_softirq()) scheduler();
 }
 
 void pageFault_routine(unsigned int eip, unsigned int fault_addr) {
+    trace_event(TRACE_CAT_FAULT, TRACE_PAGE_FAULT, eip, fault_addr);
     if (grow_user_stack(fault_addr) == 0) return;
 
     char buffer_eip[11];
@@ -148,7 +195,8 @@ void pageFault_routine(unsigned int eip, unsigned int fault_addr) {
     printk_color("  and will be terminated.\n", INFO_COLOR);
     printk_color("===============================================\n", ERROR_COLOR);
 
-    sys_exit();
+    /* Report the fault to a waiting parent as exit code -EFAULT */
+    sys_exit(-EFAULT);
     while (1) {
     }
 }
@@ -5,10 +5,18 @@
  * This file implements low-level I/O operations including port access,
  * VGA text mode screen management, character printing, and cursor control
  * for 80x25 character resolution display.
+ *
+ * The console uses all of text mode video memory: the screen is a
+ * window of CONSOLE_ROWS rows, shown by pointing the CRTC start address
+ * at its first row, so scrolling moves the window down instead of
+ * copying the screen. The rows it leaves behind are the scrollback.
  */
 
+#include <devices.h>
 #include <io.h>
+#include <klog.h>
 #include <libc.h>
+#include <spinlock.h>
 #include <types.h>
 #include <utils.h>
 
@@ -18,27 +26,103 @@ Byte x = 0;
 /* Current cursor row position (starts at row 19) */
 Byte y = 19;
 
+/* Row of video memory holding screen row 0, and first row shown */
+static unsigned int top = 0;
+static unsigned int view = 0;
+
+/* Screen fd page displayed instead of the console, or NULL */
+static Word *page_shown = NULL;
+
+/* Serializes scrolling with the scrollback keys (keyboard interrupt) */
+static spinlock_t console_lock = SPINLOCK_INIT;
+
 Byte inb(unsigned short port) {
     Byte v;
     __asm__ __volatile__("inb %w1,%0" : "=a"(v) : "Nd"(port));
     return v;
 }
 
+void outb(unsigned short port, Byte value) {
+    __asm__ __volatile__("outb %0,%w1" : : "a"(value), "Nd"(port));
+}
+
+/* First cell of a row of video memory */
+static inline Word *vram_row(unsigned int row) {
+    return (Word *)VIDEO_MEMORY_BASE + row * NUM_COLUMNS;
+}
+
+/* Show video memory from cell start on; the caller holds console_lock */
+static void crtc_set_start(unsigned int start) {
+    outb(VGA_CRTC_INDEX, VGA_CRTC_START_HIGH);
+    outb(VGA_CRTC_DATA, (start >> 8) & 0xFF);
+    outb(VGA_CRTC_INDEX, VGA_CRTC_START_LOW);
+    outb(VGA_CRTC_DATA, start & 0xFF);
+}
+
 void write_char_to_screen(Byte x, Byte y, char c, Word color) {
     Word ch = (Word)(c & 0x00FF) | color;
-    Word *screen = (Word *)VIDEO_MEMORY_BASE;
-    screen[(y * NUM_COLUMNS + x)] = ch;
+    vram_row(top + y)[x] = ch;
+}
+
+Word *console_screen(void) {
+    return vram_row(top);
 }
 
 void scroll_screen(void) {
-    Word *screen = (Word *)VIDEO_MEMORY_BASE;
-    for (int i = 0; i < (NUM_ROWS - 1) * NUM_COLUMNS; i++) {
-        screen[i] = screen[i + NUM_COLUMNS];
+    unsigned long flags = spin_lock_irqsave(&console_lock);
+    int following = (view == top);
+
+    /*
+     * The CRTC does not wrap around the end of video memory: when the
+     * screen reaches it, move the screen and CONSOLE_SCROLLBACK rows
+     * above it back to the start (once every eighty lines).
+     */
+    if (top + NUM_ROWS == CONSOLE_ROWS) {
+        unsigned int keep = CONSOLE_SCROLLBACK + NUM_ROWS;
+        unsigned int shift = CONSOLE_ROWS - keep;
+
+        copy_data(vram_row(shift), vram_row(0), keep * NUM_COLUMNS * sizeof(Word));
+        top -= shift;
+        view = (view > shift) ? view - shift : 0;
     }
-    for (int i = (NUM_ROWS - 1) * NUM_COLUMNS; i < NUM_ROWS * NUM_COLUMNS; i++) {
-        screen[i] = (Word)' ' | DEFAULT_COLOR;
+
+    top++;
+    Word *row = vram_row(top + NUM_ROWS - 1);
+    for (int i = 0; i < NUM_COLUMNS; i++) {
+        row[i] = (Word)' ' | DEFAULT_COLOR;
     }
     y = NUM_ROWS - 1;
+
+    /* A view in the scrollback stays on the lines being read */
+    if (following) view = top;
+    if (page_shown == NULL) crtc_set_start(view * NUM_COLUMNS);
+
+    spin_unlock_irqrestore(&console_lock, flags);
+}
+
+void console_scroll_view(int rows) {
+    unsigned long flags = spin_lock_irqsave(&console_lock);
+
+    int row = (int)view + rows;
+    if (row < 0) row = 0;
+    if (row > (int)top) row = top;
+    view = row;
+    page_shown = NULL;
+    crtc_set_start(view * NUM_COLUMNS);
+
+    spin_unlock_irqrestore(&console_lock, flags);
+}
+
+void console_show_page(Word *page) {
+    unsigned long flags = spin_lock_irqsave(&console_lock);
+
+    page_shown = page;
+    if (page != NULL)
+        crtc_set_start(page - (Word *)VIDEO_MEMORY_BASE);
+    else
+        crtc_set_start(view * NUM_COLUMNS);
+
+    spin_unlock_irqrestore(&console_lock, flags);
 }
 
 void handle_newline(void) {
@@ -47,8 +131,8 @@ void handle_newline(void) {
 }
 
 void printc(char c, Word color) {
-    __asm__ __volatile__(
-        "movb %0, %%al; outb $0xe9" ::"a"(c)); /* Magic BOCHS debug: writes 'c' to port 0xe9 */
+    /* Echo to the debug terminal (COM1 ring, or the Bochs port 0xe9) */
+    sys_write_debug(&c, 1);
 
     if (c == '\n')
         handle_newline();
@@ -70,19 +154,19 @@ void printc_xy(Byte mx, Byte my, char c, Word color) {
 }
 
 void printk(char *string) {
-    for (int i = 0; string[i]; i++) {
-        printc(string[i], DEFAULT_COLOR);
-    }
+    /* Written through: the prebuilt exception handlers halt right after printing */
+    printk_color(string, DEFAULT_COLOR);
+    klog_flush();
 }
 
 void printk_color(char *string, Word color) {
-    for (int i = 0; string[i]; i++) {
-        printc(string[i], color);
-    }
+    int len = 0;
+    while (string[len]) len++;
+    klog_write(string, len, color);
 }
 
 void clear_screen(void) {
-    Word *screen = (Word *)VIDEO_MEMORY_BASE;
+    Word *screen = console_screen();
     for (int i = 0; i < NUM_ROWS * NUM_COLUMNS; i++) {
         screen[i] = (Word)' ' | DEFAULT_COLOR;
     }
@@ -90,7 +174,7 @@ void clear_screen(void) {
 }
 
 void print_string_xy(Byte px, Byte py, const char *str, Word color) {
-    Word *screen = (Word *)VIDEO_MEMORY_BASE;
+    Word *screen = (page_shown != NULL) ? page_shown : console_screen();
     int pos = py * NUM_COLUMNS + px;
 
     for (int i = 0; str[i] != '\0' && (px + i) < NUM_COLUMNS; i++) {
@@ -98,10 +182,30 @@ void print_string_xy(Byte px, Byte py, const char *str, Word color) {
     }
 }
 
+/* printk_color_fmt output, appended to the log a buffer at a time */
+struct fmt_out {
+    char buf[128];
+    int len;
+    Word color;
+};
+
+static void fmt_putc(struct fmt_out *out, char c) {
+    if (out->len == sizeof(out->buf)) {
+        klog_write(out->buf, out->len, out->color);
+        out->len = 0;
+    }
+    out->buf[out->len++] = c;
+}
+
+static void fmt_puts(struct fmt_out *out, const char *s) {
+    while (*s) fmt_putc(out, *s++);
+}
+
 void printk_color_fmt(Word color, char *fmt, ...) {
     __builtin_va_list args;
     __builtin_va_start(args, fmt);
 
+    struct fmt_out out = {.len = 0, .color = color};
     char buffer[32];
     char *str;
     int num;
@@ -109,7 +213,7 @@ void printk_color_fmt(Word color, char *fmt, ...) {
 
     for (int i = 0; fmt[i] != '\0'; i++) {
         if (fmt[i] != '%') {
-            printc(fmt[i], color);
+            fmt_putc(&out, fmt[i]);
             continue;
         }
 
@@ -118,36 +222,37 @@ void printk_color_fmt(Word color, char *fmt, ...) {
         case 'd': // Integer
             num = __builtin_va_arg(args, int);
             if (num < 0) {
-                printc('-', color);
+                fmt_putc(&out, '-');
                 unum = -(unsigned int)num;
             } else {
                 unum = (unsigned int)num;
             }
             utoa(unum, buffer);
-            printk_color(buffer, color);
+            fmt_puts(&out, buffer);
             break;
         case 'x': // Hexadecimal
             num = __builtin_va_arg(args, int);
             itoa_hex(num, buffer);
-            printk_color(buffer, color);
+            fmt_puts(&out, buffer);
             break;
         case 's': // String
             str = __builtin_va_arg(args, char *);
-            printk_color(str, color);
+            fmt_puts(&out, str);
             break;
         case 'c':                              // Character
             num = __builtin_va_arg(args, int); // char is promoted to int
-            printc((char)num, color);
+            fmt_putc(&out, (char)num);
             break;
         case '%': // Escaped %
-            printc('%', color);
+            fmt_putc(&out, '%');
             break;
         default: // Unknown format, print as is
-            printc('%', color);
-            printc(fmt[i], color);
+            fmt_putc(&out, '%');
+            fmt_putc(&out, fmt[i]);
             break;
         }
     }
 
     __builtin_va_end(args);
+    klog_write(out.buf, out.len, color);
 }
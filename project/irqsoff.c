@@ -0,0 +1,102 @@
+/**
+ * @file irqsoff.c
+ * @brief Interrupts-off windows and clock interrupt latency.
+ *
+ * This file implements the hooks called where interrupts get disabled
+ * or enabled, the clock latency sampling and the copy behind the
+ * irqsoff_read system call.
+ */
+
+#include <clock.h>
+#include <irqsoff.h>
+#include <sched.h>
+#include <utils.h>
+
+static struct irqsoff_stats irqsoff;
+
+#if IRQSOFF_TRACER
+
+/* Window being measured */
+static int window_open = 0;
+static unsigned long long window_start;
+static unsigned int window_site;
+static int window_tag;
+static int window_pid;
+
+static inline unsigned long long read_tsc(void) {
+    unsigned int low, high;
+    rdtsc(low, high);
+    return ((unsigned long long)high << 32) | low;
+}
+
+/* Index of the highest set bit (0 for 0 and 1) */
+static int log2_floor(unsigned int v) {
+    int b = 0;
+    while (v >>= 1) b++;
+    return b;
+}
+
+static void open_window(int tag, unsigned int site) {
+    /* Entries nested in a window (faults in kernel code) do not restart it */
+    if (window_open) return;
+
+    window_open = 1;
+    window_site = site;
+    window_tag = tag;
+    window_pid = current()->PID;
+    window_start = read_tsc();
+}
+
+static void close_window(unsigned int site) {
+    if (!window_open) return;
+
+    unsigned long long length = read_tsc() - window_start;
+    unsigned int cycles = (length >> 32) ? 0xffffffff : (unsigned int)length;
+    window_open = 0;
+
+    irqsoff.windows++;
+    irqsoff.cycles += length;
+    if (cycles > irqsoff.max_cycles) {
+        irqsoff.max_cycles = cycles;
+        irqsoff.max_start_site = window_site;
+        irqsoff.max_end_site = site;
+        irqsoff.max_tag = window_tag;
+        irqsoff.max_pid = window_pid;
+    }
+}
+
+void irqsoff_enter(int tag) {
+    open_window(tag, (unsigned int)__builtin_return_address(0));
+}
+
+void irqsoff_exit(unsigned long eflags) {
+    if (eflags & EFLAGS_IF) close_window((unsigned int)__builtin_return_address(0));
+}
+
+void irqsoff_disabled(void) {
+    open_window(IRQSOFF_TAG_KERNEL, (unsigned int)__builtin_return_address(0));
+}
+
+void irqsoff_enabled(void) {
+    close_window((unsigned int)__builtin_return_address(0));
+}
+
+void irq_latency_sample(void) {
+    unsigned int clocks = clock_irq_delay();
+    int bucket = log2_floor(clocks);
+
+    if (bucket >= IRQ_LATENCY_BUCKETS) bucket = IRQ_LATENCY_BUCKETS - 1;
+    irqsoff.irq_samples++;
+    irqsoff.irq_latency_hist[bucket]++;
+    if (clocks > irqsoff.irq_latency_max) irqsoff.irq_latency_max = clocks;
+}
+
+#endif /* IRQSOFF_TRACER */
+
+void irqsoff_get(struct irqsoff_stats *stats, int reset) {
+    copy_data(&irqsoff, stats, sizeof(struct irqsoff_stats));
+    if (!reset) return;
+
+    unsigned char *p = (unsigned char *)&irqsoff;
+    for (unsigned int i = 0; i < sizeof(struct irqsoff_stats); i++) p[i] = 0;
+}
@@ -7,6 +7,8 @@
  * execution context checking, and time/FPS display management.
  */
 
+#include <clock.h>
+#include <cpuload.h>
 #include <errno.h>
 #include <interrupt.h>
 #include <io.h>
@@ -24,6 +26,9 @@ static int current_fps = 0;
 /* Cached display strings */
 static char cached_time[9] = "0000:000";
 static char cached_fps[10] = "    0 FPS"; /* 5 digits + space + FPS + null */
+#if LOAD_DISPLAY
+static char cached_load[CPULOAD_TEXT_LEN + 1] = "CPU   0% 0.00 0.00 0.00";
+#endif
 
 int ret_from_fork(void) {
     return 0;
@@ -91,8 +96,8 @@ int stack_region_in_use(struct task_struct *master, unsigned int start, unsigned
 }
 
 int find_free_stack_region(struct task_struct *master) {
-    for (unsigned int page = THREAD_STACK_BASE_PAGE;
-         page + THREAD_STACK_REGION_PAGES <= TOTAL_PAGES; page += THREAD_STACK_REGION_PAGES) {
+    for (unsigned int page = THREAD_STACK_BASE_PAGE; page < THREAD_STACK_END_PAGE;
+         page += THREAD_STACK_REGION_PAGES) {
         if (!stack_region_in_use(master, page, THREAD_STACK_REGION_PAGES)) return page;
     }
     return -1;
@@ -148,17 +153,43 @@ void release_thread_stack(struct task_struct *thread) {
     thread->user_entry = 0;
 }
 
+void reparent_children(struct task_struct *from, struct task_struct *to) {
+    struct list_head *pos, *tmp;
+
+    list_for_each_safe(pos, tmp, &from->children) {
+        struct task_struct *child = list_entry(pos, struct task_struct, child_list);
+        list_del(&child->child_list);
+
+        if (to == idle_task && child->status == ST_ZOMBIE) {
+            /* Idle never waits: reap the zombie right away */
+            id_hash_del(child);
+            list_add_tail(&child->list, &freequeue);
+            continue;
+        }
+
+        child->parent = to;
+        list_add_tail(&child->child_list, &to->children);
+    }
+}
+
+void release_zombie(struct task_struct *zombie) {
+    list_del(&zombie->child_list);
+    zombie->parent = NULL;
+    zombie->wait_pid = 0;
+    id_hash_del(zombie);
+    list_add_tail(&zombie->list, &freequeue);
+}
+
 /******************************************************************************/
 /*                         TIME AND FPS DISPLAY                               */
 /******************************************************************************/
 
 void update_time_and_fps(void) {
-    /* Calculate time components using adjusted ticks per second */
-    int total_ticks = zeos_ticks;
-    int total_seconds = total_ticks / TICKS_PER_SECOND;
-    int seconds = total_seconds % 10000; /* Wrap at 10000 seconds */
-    int remaining_ticks = total_ticks % TICKS_PER_SECOND;
-    int milliseconds = (remaining_ticks * 1000) / TICKS_PER_SECOND;
+    /* Time since boot: ticks alone are wrong after a tick rate change */
+    struct timespec now;
+    clock_monotonic(&now);
+    int seconds = now.tv_sec % 10000; /* Wrap at 10000 seconds */
+    int milliseconds = now.tv_nsec / 1000000;
 
     /* Format time as "SSSS:MMM" */
     cached_time[0] = '0' + (seconds / 1000) % 10;
@@ -193,9 +224,16 @@ void update_time_and_fps(void) {
     cached_fps[7] = 'P';
     cached_fps[8] = 'S';
     cached_fps[9] = '\0';
+
+#if LOAD_DISPLAY
+    cpuload_format(cached_load);
+#endif
 }
 
 void draw_time_and_fps(void) {
     print_string_xy(TIME_DISPLAY_X, TIME_DISPLAY_Y, cached_time, TIME_DISPLAY_COLOR);
     print_string_xy(FPS_DISPLAY_X, FPS_DISPLAY_Y, cached_fps, FPS_DISPLAY_COLOR);
+#if LOAD_DISPLAY
+    print_string_xy(LOAD_DISPLAY_X, LOAD_DISPLAY_Y, cached_load, LOAD_DISPLAY_COLOR);
+#endif
 }
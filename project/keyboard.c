@@ -6,20 +6,50 @@
  * auxiliary stack management, IRQ handling, and user callback dispatch.
  */
 
+#include <clock.h>
+#include <cpuload.h>
 #include <errno.h>
+#include <interrupt.h>
 #include <io.h>
 #include <keyboard.h>
 #include <mm.h>
 #include <mm_address.h>
 #include <sched.h>
 #include <segment.h>
+#include <softirq.h>
 #include <sys.h>
+#include <trace.h>
+#include <utils.h>
+
+/* Event rings, handed out to processes on their first read_keys() */
+static struct kbd_ring kbd_rings[NR_TASKS];
+
+struct list_head kbd_waitqueue;
+
+union kbd_state_page kbd_state_page;
+
+/* Events waiting for the upcall handler of each task, indexed like tasks[] */
+static struct kbd_event kbd_queues[NR_TASKS][KBD_BATCH_MAX];
+
+void init_kbd_rings(void) {
+    INIT_LIST_HEAD(&kbd_waitqueue);
+    for (int i = 0; i < PAGE_SIZE; i++) {
+        kbd_state_page.bytes[i] = 0;
+    }
+    for (int i = 0; i < NR_TASKS; i++) {
+        kbd_rings[i].used = 0;
+    }
+}
 
 void init_keyboard_fields(struct task_struct *task) {
     task->kbd_handler = NULL;
     task->kbd_wrapper = NULL;
     task->kbd_aux_stack = NULL;
     task->in_kbd_context = 0;
+    task->kbd_queued = 0;
+    task->kbd_batch = 0;
+    task->kbd_ring = NULL;
+    task->kbd_wait_ticks = 0;
     for (int i = 0; i < KBD_CTX_SIZE; i++) {
         task->kbd_saved_ctx[i] = 0;
     }
@@ -70,27 +100,206 @@ void free_kbd_aux_stack(struct task_struct *task) {
 void cleanup_kbd_handler(struct task_struct *task) {
     task->kbd_handler = NULL;
     task->in_kbd_context = 0;
+    task->kbd_queued = 0;
+    task->kbd_batch = 0;
     for (int i = 0; i < KBD_CTX_SIZE; i++) {
         task->kbd_saved_ctx[i] = 0;
     }
     free_kbd_aux_stack(task);
 }
 
-void kbd_irq_handler(void) {
-    /* Read scancode from keyboard data port */
-    unsigned char scancode = inb(KEYBOARD_DATA_PORT);
+unsigned long kbd_state_map(void) {
+    /* The kernel is identity mapped: the page's address gives its frame */
+    page_table_entry *PT = get_PT(current_task);
+    set_user_ro_pag(PT, KBD_STATE_PAGE, (unsigned long)&kbd_state_page >> 12);
+    set_cr3(get_DIR(current_task));
 
-    /* Determine if key was pressed (bit 7 = 0) or released (bit 7 = 1) */
-    int pressed = !(scancode & 0x80);
-    char key = scancode & 0x7F;
+    return KBD_STATE_PAGE << 12;
+}
 
-    struct task_struct *task = current_task;
+void kbd_state_unmap(struct task_struct *master) {
+    /* The frame belongs to the kernel: only drop the mapping */
+    del_ss_pag(get_PT(master), KBD_STATE_PAGE);
+}
 
-    /* Check if current task has a keyboard handler and is not already in handler */
-    if (task == NULL || task->kbd_handler == NULL || task->in_kbd_context) {
-        return;
+/* Record a press or release in the shared keyboard state */
+static void kbd_state_update(char key, int pressed) {
+    struct kbd_state *state = &kbd_state_page.state;
+    unsigned int bit = 1u << (key & 31);
+
+    if (pressed)
+        state->pressed[key >> 5] |= bit;
+    else
+        state->pressed[key >> 5] &= ~bit;
+    state->last_change[(int)key] = zeos_ticks;
+    state->seq++;
+}
+
+static int kbd_key_down(char key) {
+    return (kbd_state_page.state.pressed[key >> 5] >> (key & 31)) & 1;
+}
+
+/* Key whose presses the console took, so its release is not delivered either */
+static char kbd_bound_key = 0;
+
+/* Shift+Page Up/Down scroll the console a page; the key is not delivered */
+static int kbd_console_binding(char key, int pressed) {
+    if (!pressed) {
+        if (key != kbd_bound_key) return 0;
+        kbd_bound_key = 0;
+        return 1;
+    }
+
+    if (key != KBD_PAGE_UP && key != KBD_PAGE_DOWN) return 0;
+    if (!kbd_key_down(KBD_LEFT_SHIFT) && !kbd_key_down(KBD_RIGHT_SHIFT)) return 0;
+
+    kbd_bound_key = key;
+    console_scroll_view(key == KBD_PAGE_UP ? -(NUM_ROWS - 1) : NUM_ROWS - 1);
+    return 1;
+}
+
+static struct kbd_ring *kbd_ring_alloc(void) {
+    for (int i = 0; i < NR_TASKS; i++) {
+        if (!kbd_rings[i].used) {
+            kbd_rings[i].used = 1;
+            kbd_rings[i].head = 0;
+            kbd_rings[i].tail = 0;
+            return &kbd_rings[i];
+        }
+    }
+    return NULL;
+}
+
+void kbd_ring_release(struct task_struct *master) {
+    if (master->kbd_ring != NULL) {
+        master->kbd_ring->used = 0;
+        master->kbd_ring = NULL;
+    }
+}
+
+/* Append an event to every ring in use and wake the readers that can proceed */
+static void kbd_ring_push(char key, int pressed) {
+    struct list_head *pos, *tmp;
+
+    for (int i = 0; i < NR_TASKS; i++) {
+        struct kbd_ring *ring = &kbd_rings[i];
+        if (!ring->used || ring->tail - ring->head == KBD_RING_SIZE) continue;
+
+        struct kbd_event *event = &ring->events[ring->tail % KBD_RING_SIZE];
+        event->time = zeos_ticks;
+        event->key = key;
+        event->pressed = pressed;
+        ring->tail++;
+    }
+
+    list_for_each_safe(pos, tmp, &kbd_waitqueue) {
+        struct task_struct *task = list_head_to_task_struct(pos);
+        update_process_state_rr(task, &readyqueue);
+    }
+}
+
+int kbd_read_events(struct kbd_event *buf, int n, int timeout) {
+    struct task_struct *master = current_task->master_thread;
+
+    if (master->kbd_ring == NULL) {
+        master->kbd_ring = kbd_ring_alloc();
+        if (master->kbd_ring == NULL) return -ENOMEM;
+    }
+
+    while (master->kbd_ring->head == master->kbd_ring->tail) {
+        if (timeout == 0) return 0;
+
+        current_task->kbd_wait_ticks = timeout;
+        update_process_state_rr(current_task, &kbd_waitqueue);
+        sched_next_rr();
+
+        /* Woken by an event or by kbd_tick; the master may have changed meanwhile */
+        timeout = current_task->kbd_wait_ticks;
+        master = current_task->master_thread;
+    }
+
+    struct kbd_ring *ring = master->kbd_ring;
+    int count = 0;
+    while (count < n && ring->head != ring->tail) {
+        copy_to_user(&ring->events[ring->head % KBD_RING_SIZE], &buf[count],
+                     sizeof(struct kbd_event));
+        ring->head++;
+        count++;
+    }
+    return count;
+}
+
+void kbd_tick(void) {
+    struct list_head *pos, *tmp;
+
+    list_for_each_safe(pos, tmp, &kbd_waitqueue) {
+        struct task_struct *task = list_head_to_task_struct(pos);
+        if (task->kbd_wait_ticks > 0 && --task->kbd_wait_ticks == 0) {
+            update_process_state_rr(task, &readyqueue);
+        }
     }
+}
+
+/* Queue an event for the task's handler; drop it if the queue is full */
+static void kbd_queue_event(struct task_struct *task, char key, int pressed) {
+    if (task->kbd_queued == KBD_BATCH_MAX) return;
+
+    struct kbd_event *event = &kbd_queues[get_task_index(task)][task->kbd_queued++];
+    event->time = zeos_ticks;
+    event->key = key;
+    event->pressed = pressed;
+}
+
+/* Point the saved user context at the wrapper, passing the next queued event(s) */
+static void kbd_push_frame(struct task_struct *task) {
+    union task_union *task_union = (union task_union *)task;
+    struct kbd_event *queue = kbd_queues[get_task_index(task)];
+    unsigned long aux_stack_top = (unsigned long)task->kbd_aux_stack;
+    unsigned long *stack_ptr;
+
+    if (task->kbd_batch) {
+        /*
+         * Batch layout (growing downward):
+         *   aux_stack_top - KBD_BATCH_MAX events: copy of the queued events
+         *   below them: count, events pointer, kbd_handler, return address
+         *
+         * The same wrapper calls handler(events, count).
+         */
+        struct kbd_event *events = (struct kbd_event *)aux_stack_top - KBD_BATCH_MAX;
+        copy_data(queue, events, task->kbd_queued * sizeof(struct kbd_event));
+
+        stack_ptr = (unsigned long *)events - 4;
+        stack_ptr[2] = (unsigned long)events;          /* 2nd param: events */
+        stack_ptr[3] = (unsigned long)task->kbd_queued; /* 3rd param: count */
+        task->kbd_queued = 0;
+    } else {
+        /*
+         * Single event layout (growing downward):
+         *   aux_stack_top - 4:  pressed (3rd param for wrapper)
+         *   aux_stack_top - 8:  key (2nd param for wrapper)
+         *   aux_stack_top - 12: kbd_handler (1st param for wrapper)
+         *   aux_stack_top - 16: return address (unused, wrapper does int 0x2b)
+         */
+        stack_ptr = (unsigned long *)(aux_stack_top - 16);
+        stack_ptr[2] = (unsigned long)queue[0].key;     /* 2nd param: key scancode */
+        stack_ptr[3] = (unsigned long)queue[0].pressed; /* 3rd param: pressed flag */
+
+        task->kbd_queued--;
+        for (int i = 0; i < task->kbd_queued; i++) {
+            queue[i] = queue[i + 1];
+        }
+    }
+
+    stack_ptr[0] = 0;                                /* Return address (unused) */
+    stack_ptr[1] = (unsigned long)task->kbd_handler; /* 1st param: user handler */
 
+    /* Modify saved context to jump to wrapper function on auxiliary stack */
+    task_union->stack[STACK_USER_EIP] = (unsigned long)task->kbd_wrapper;
+    task_union->stack[STACK_USER_ESP] = (unsigned long)stack_ptr;
+}
+
+/* Save the task's user context and enter its keyboard handler */
+static void kbd_dispatch(struct task_struct *task) {
     /* Mark that we're entering keyboard handler context */
     task->in_kbd_context = 1;
 
@@ -118,27 +327,59 @@ void kbd_irq_handler(void) {
     task->kbd_saved_ctx[14] = task_union->stack[STACK_USER_ESP];
     task->kbd_saved_ctx[15] = task_union->stack[STACK_USER_SS];
 
+    kbd_push_frame(task);
+}
+
+/* Buffer the key and deliver it to the running thread's handler */
+static void kbd_irq_event(void) {
+    /* Read scancode from keyboard data port */
+    unsigned char scancode = inb(KEYBOARD_DATA_PORT);
+
+    /* Determine if key was pressed (bit 7 = 0) or released (bit 7 = 1) */
+    int pressed = !(scancode & 0x80);
+    char key = scancode & 0x7F;
+
+    if (kbd_console_binding(key, pressed)) return;
+
+    /* Publish the key state and buffer the event for read_keys() */
+    kbd_state_update(key, pressed);
+    kbd_ring_push(key, pressed);
+
+    struct task_struct *task = current_task;
+
+    /* Check if current task has a keyboard handler */
+    if (task == NULL || task->kbd_handler == NULL) {
+        return;
+    }
+
+    kbd_queue_event(task, key, pressed);
+
     /*
-     * Setup auxiliary stack for the wrapper function.
-     * Stack layout (growing downward):
-     *   aux_stack_top - 4:  pressed (3rd param for wrapper)
-     *   aux_stack_top - 8:  key (2nd param for wrapper)
-     *   aux_stack_top - 12: kbd_handler (1st param for wrapper)
-     *   aux_stack_top - 16: return address (unused, wrapper does int 0x2b)
-     *
-     * The wrapper will be called with these parameters on stack.
+     * A running handler picks the event up when it returns; inside a
+     * syscall the user context is not final yet, so deliver at syscall exit.
      */
-    unsigned long aux_stack_top = (unsigned long)task->kbd_aux_stack;
-    unsigned long *stack_ptr = (unsigned long *)(aux_stack_top - 16);
+    if (task->in_kbd_context || task->in_preempt_point) {
+        return;
+    }
 
-    stack_ptr[0] = 0;                                /* Return address (unused) */
-    stack_ptr[1] = (unsigned long)task->kbd_handler; /* 1st param: user handler */
-    stack_ptr[2] = (unsigned long)key;               /* 2nd param: key scancode */
-    stack_ptr[3] = (unsigned long)pressed;           /* 3rd param: pressed flag */
+    kbd_dispatch(task);
+}
 
-    /* Modify saved context to jump to wrapper function on auxiliary stack */
-    task_union->stack[STACK_USER_EIP] = (unsigned long)task->kbd_wrapper;
-    task_union->stack[STACK_USER_ESP] = (unsigned long)stack_ptr;
+void kbd_irq_handler(void) {
+    cpuload_idle_exit();
+    /* The tick may be stopped: bring the event timestamps up to date */
+    clock_nohz_exit();
+    trace_event(TRACE_CAT_IRQ, TRACE_IRQ_ENTRY, 1, 0);
+    kbd_irq_event();
+    trace_event(TRACE_CAT_IRQ, TRACE_IRQ_EXIT, 1, 0);
+    do_softirq();
+}
+
+void kbd_syscall_exit(void) {
+    struct task_struct *task = current_task;
+
+    if (task->kbd_queued == 0 || task->kbd_handler == NULL || task->in_kbd_context) return;
+    kbd_dispatch(task);
 }
 
 void kbd_resume_handler(void) {
@@ -149,6 +390,12 @@ void kbd_resume_handler(void) {
         return;
     }
 
+    /* Events arrived while the handler ran: re-enter it without a restore/save */
+    if (task->kbd_queued > 0 && task->kbd_handler != NULL) {
+        kbd_push_frame(task);
+        return;
+    }
+
     /* Get the task's kernel stack */
     union task_union *task_union = (union task_union *)task;
 
@@ -0,0 +1,169 @@
+/**
+ * @file klog.c
+ * @brief Lock-free kernel log ring drained by a bottom half.
+ */
+
+#include <io.h>
+#include <klog.h>
+#include <softirq.h>
+#include <utils.h>
+
+/* The ring; positions below count bytes since boot (modulo 2^32) */
+static char klog_ring[KLOG_SIZE] __attribute__((aligned(8)));
+
+/* End of the reserved records, oldest record kept, first record the console has not shown */
+static volatile unsigned int head = 0;
+static volatile unsigned int first = 0;
+static volatile unsigned int console = 0;
+
+/* Messages lost to a full ring, and how many of them the console has reported */
+static volatile unsigned int dropped = 0;
+static unsigned int reported = 0;
+
+/* 1 while klog_flush prints */
+static volatile unsigned int draining = 0;
+
+/* Replace *p with new if it still holds old; returns the value found */
+static inline unsigned int cmpxchg(volatile unsigned int *p, unsigned int old, unsigned int new) {
+    unsigned int prev;
+    __asm__ __volatile__("lock; cmpxchgl %2, %1"
+                         : "=a"(prev), "+m"(*p)
+                         : "r"(new), "0"(old)
+                         : "memory");
+    return prev;
+}
+
+static inline struct klog_header *header_at(unsigned int pos) {
+    return (struct klog_header *)&klog_ring[pos & (KLOG_SIZE - 1)];
+}
+
+/* Bytes taken by a record with len bytes of text */
+static inline unsigned int record_size(unsigned int len) {
+    return (sizeof(struct klog_header) + len + 7) & ~7;
+}
+
+/* Publish a record: the position goes last, after the text */
+static inline void commit(struct klog_header *h, unsigned int pos) {
+    __asm__ __volatile__("" : : : "memory");
+    h->pos = pos;
+}
+
+/* Drop the oldest record if the console has shown it; 0 if it has not */
+static int reclaim(void) {
+    unsigned int f = first;
+    if (f == console) return 0;
+
+    /* Losing the race means another writer dropped it: progress either way */
+    cmpxchg(&first, f, f + record_size(header_at(f)->len));
+    return 1;
+}
+
+static void append(const char *text, int len, Word color) {
+    unsigned int size = record_size(len);
+    unsigned int old, start, room;
+
+    for (;;) {
+        old = head;
+
+        /* Records do not wrap: a pad record fills the end of the ring */
+        room = KLOG_SIZE - (old & (KLOG_SIZE - 1));
+        start = (size > room) ? old + room : old;
+
+        if (start + size - first > KLOG_SIZE) {
+            if (reclaim()) continue;
+            __asm__ __volatile__("lock; incl %0" : "+m"(dropped) : : "memory");
+            return;
+        }
+        if (cmpxchg(&head, old, start + size) == old) break;
+    }
+
+    if (start != old) {
+        struct klog_header *pad = header_at(old);
+        pad->len = room - sizeof(struct klog_header);
+        pad->color = KLOG_PAD;
+        commit(pad, old);
+    }
+
+    struct klog_header *h = header_at(start);
+    h->len = len;
+    h->color = color;
+    copy_data((void *)text, h + 1, len);
+    commit(h, start);
+}
+
+void init_klog(void) {
+    open_softirq(SOFTIRQ_KLOG, klog_flush);
+}
+
+void klog_write(const char *text, int len, Word color) {
+#if KLOG_ASYNC
+    while (len > KLOG_RECORD_MAX) {
+        append(text, KLOG_RECORD_MAX, color);
+        text += KLOG_RECORD_MAX;
+        len -= KLOG_RECORD_MAX;
+    }
+    if (len > 0) append(text, len, color);
+
+    raise_softirq(SOFTIRQ_KLOG);
+#else
+    for (int i = 0; i < len; i++) printc(text[i], color);
+#endif
+}
+
+void klog_flush(void) {
+    unsigned int busy = 1;
+    __asm__ __volatile__("xchgl %0, %1" : "+r"(busy), "+m"(draining) : : "memory");
+    if (busy) return;
+
+    for (unsigned int pos = console; pos != head; pos = console) {
+        struct klog_header *h = header_at(pos);
+
+        /* Still being written by the code this flush interrupted */
+        if (h->pos != pos) break;
+
+        if (h->color != KLOG_PAD) {
+            char *text = (char *)(h + 1);
+            for (int i = 0; i < h->len; i++) printc(text[i], h->color);
+        }
+        console = pos + record_size(h->len);
+    }
+
+    if (reported != dropped) {
+        char number[12];
+        unsigned int lost = dropped - reported;
+        reported += lost;
+        utoa(lost, number);
+        for (int i = 0; number[i]; i++) printc(number[i], WARNING_COLOR);
+        for (const char *s = " log messages dropped\n"; *s; s++) printc(*s, WARNING_COLOR);
+    }
+
+    draining = 0;
+}
+
+int klog_read(char *buffer, int size) {
+    unsigned int pos, total = 0;
+    struct klog_header *h;
+
+    /* Text of the complete records, oldest first */
+    for (pos = first; pos != head && (h = header_at(pos))->pos == pos; pos += record_size(h->len)) {
+        if (h->color != KLOG_PAD) total += h->len;
+    }
+
+    /* Keep the newest size bytes */
+    unsigned int skip = (total > (unsigned int)size) ? total - size : 0;
+    int copied = 0;
+
+    for (pos = first; pos != head && (h = header_at(pos))->pos == pos; pos += record_size(h->len)) {
+        if (h->color == KLOG_PAD) continue;
+        if (skip >= h->len) {
+            skip -= h->len;
+            continue;
+        }
+        copy_to_user((char *)(h + 1) + skip, buffer + copied, h->len - skip);
+        copied += h->len - skip;
+        skip = 0;
+        if (copied == size) break;
+    }
+
+    return copied;
+}
@@ -0,0 +1,48 @@
+/**
+ * @file lapic.c
+ * @brief Local APIC setup and one-shot timer.
+ */
+
+#include <lapic.h>
+#include <smp.h>
+
+static inline unsigned int lapic_read(unsigned int reg) {
+    return *(volatile unsigned int *)(LAPIC_BASE + reg);
+}
+
+static inline void lapic_write(unsigned int reg, unsigned int value) {
+    *(volatile unsigned int *)(LAPIC_BASE + reg) = value;
+}
+
+int init_lapic(void) {
+    if (!smp_has_apic) return 0;
+
+    /* A missing APIC reads as all ones (or zeros on some emulators) */
+    unsigned int version = lapic_read(LAPIC_VERSION);
+    if (version == 0xffffffff || (version & 0xff) == 0) return 0;
+
+    /* Accept every priority; PIC interrupts come through LINT0 as before */
+    lapic_write(LAPIC_TPR, 0);
+    lapic_write(LAPIC_LVT_LINT0, LAPIC_DM_EXTINT);
+    lapic_write(LAPIC_LVT_LINT1, LAPIC_DM_NMI);
+    lapic_write(LAPIC_SVR, LAPIC_SVR_ENABLE | LAPIC_SPURIOUS_VECTOR);
+
+    lapic_write(LAPIC_TIMER_DIVIDE, LAPIC_DIVIDE_16);
+    lapic_write(LAPIC_LVT_TIMER, LAPIC_LVT_MASKED | LAPIC_TIMER_VECTOR);
+    lapic_write(LAPIC_TIMER_INITIAL, 0);
+    return 1;
+}
+
+void lapic_eoi(void) {
+    lapic_write(LAPIC_EOI, 0);
+}
+
+void lapic_timer_oneshot(unsigned int count) {
+    /* One-shot is the LVT timer mode 0; the write of the count arms it */
+    lapic_write(LAPIC_LVT_TIMER, LAPIC_TIMER_VECTOR);
+    lapic_write(LAPIC_TIMER_INITIAL, count);
+}
+
+unsigned int lapic_timer_count(void) {
+    return lapic_read(LAPIC_TIMER_CURRENT);
+}
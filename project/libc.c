@@ -10,7 +10,13 @@
 #include <errno.h>
 #include <io.h>
 #include <libc.h>
+#include <mm_address.h>
+#include <times.h>
 #include <types.h>
+#include <vdso_data.h>
+
+/* Kernel page mapped read-only in every process */
+#define VDSO ((const volatile struct vdso_data *)(VDSO_PAGE << 12))
 
 /* Global errno variable for error handling */
 int errno;
@@ -81,6 +87,12 @@ void perror(void) {
     case EBADF:
         msg = "Bad file number\n";
         break;
+    case ECHILD:
+        msg = "No child processes\n";
+        break;
+    case EBUSY:
+        msg = "Device or resource busy\n";
+        break;
     default:
         itoa(errno, buff);
         msg = "Message for error ";
@@ -141,16 +153,18 @@ void prints(const char *fmt, ...) {
                 }
                 break;
             }
-            case 'u': {
+            case 'u':
+            case 'x': {
                 unsigned int uval = __builtin_va_arg(args, unsigned int);
+                unsigned int base = (*fmt == 'x') ? 16 : 10;
                 /* Convert to string */
                 int i = 0;
                 if (uval == 0) {
                     num_buf[i++] = '0';
                 } else {
                     while (uval > 0 && i < 15) {
-                        num_buf[i++] = (uval % 10) + '0';
-                        uval /= 10;
+                        num_buf[i++] = "0123456789abcdef"[uval % base];
+                        uval /= base;
                     }
                 }
                 /* Reverse and copy */
@@ -238,16 +252,18 @@ void printd(const char *fmt, ...) {
                 }
                 break;
             }
-            case 'u': {
+            case 'u':
+            case 'x': {
                 unsigned int uval = __builtin_va_arg(args, unsigned int);
+                unsigned int base = (*fmt == 'x') ? 16 : 10;
                 /* Convert to string */
                 int i = 0;
                 if (uval == 0) {
                     num_buf[i++] = '0';
                 } else {
                     while (uval > 0 && i < 15) {
-                        num_buf[i++] = (uval % 10) + '0';
-                        uval /= 10;
+                        num_buf[i++] = "0123456789abcdef"[uval % base];
+                        uval /= base;
                     }
                 }
                 /* Reverse and copy */
@@ -303,6 +319,180 @@ int clear_screen_buffer(int fd) {
     return write(fd, clear_buffer, sizeof(clear_buffer));
 }
 
+/****************************************/
+/**    Shared Page Readers             **/
+/****************************************/
+
+int fast_gettime(void) {
+    return VDSO->ticks;
+}
+
+int fast_gettime_precise(int *subtick) {
+    unsigned int seq, ticks, last, per_tick, now;
+
+    /* Retry if a clock interrupt updated the page while we read it */
+    do {
+        seq = VDSO->seq;
+        ticks = VDSO->ticks;
+        last = VDSO->tsc_last_tick;
+        per_tick = VDSO->tsc_per_tick;
+        __asm__ __volatile__("rdtsc" : "=a"(now) : : "edx");
+    } while ((seq & 1) || seq != VDSO->seq);
+
+    int frac = 0;
+    if (per_tick >= 1000) {
+        frac = (now - last) / (per_tick / 1000);
+        if (frac > 999) frac = 999;
+    }
+    if (subtick != NULL) *subtick = frac;
+    return ticks;
+}
+
+unsigned int get_tsc_khz(void) {
+    return VDSO->tsc_khz;
+}
+
+int ticks_per_second(void) {
+    return VDSO->ticks_per_second;
+}
+
+int fast_getpid(void) {
+    return VDSO->pid;
+}
+
+int fast_gettid(void) {
+    return VDSO->tid;
+}
+
+/****************************************/
+/**    Submission/Completion Rings     **/
+/****************************************/
+
+struct uring_sqe *uring_get_sqe(struct uring *ring) {
+    if (ring->sq_tail - ring->sq_head == URING_ENTRIES) return NULL;
+
+    /* The kernel only reads submissions inside ring_enter: publish right away */
+    struct uring_sqe *sqe = &ring->sqes[ring->sq_tail % URING_ENTRIES];
+    ring->sq_tail++;
+    return sqe;
+}
+
+int uring_submit(struct uring *ring) {
+    return ring_enter(ring->sq_tail - ring->sq_head);
+}
+
+struct uring_cqe *uring_peek_cqe(struct uring *ring) {
+    if (ring->cq_head == ring->cq_tail) return NULL;
+    return &ring->cqes[ring->cq_head % URING_ENTRIES];
+}
+
+void uring_cqe_seen(struct uring *ring) {
+    ring->cq_head++;
+}
+
+/****************************************/
+/**    Syscall Statistics              **/
+/****************************************/
+
+/* Indexed by syscall number; unused numbers stay NULL */
+static const char *syscall_names[NR_SYSCALLS] = {
+    [1] = "exit",           [2] = "fork",
+    [4] = "write",          [5] = "exit_thread",
+    [6] = "create_thread",  [7] = "waitpid",
+    [10] = "gettime",       [12] = "block",
+    [13] = "unblock",       [20] = "getpid",
+    [21] = "gettid",        [22] = "keyboard_event",
+    [23] = "waitfortick",   [24] = "yield",
+    [25] = "setdeadline",   [26] = "waitperiod",
+    [27] = "sched_getstats", [28] = "read_keys",
+    [29] = "kbd_event_batch", [30] = "keyboard_state",
+    [31] = "ring_setup",    [32] = "ring_enter",
+    [33] = "syscall_stats", [34] = "prof_start",
+    [35] = "prof_stop",     [36] = "prof_read",
+    [37] = "trace_ctl",     [38] = "trace_read",
+    [39] = "irqsoff_read",  [40] = "clock_gettime",
+    [41] = "set_tick_rate", [42] = "clock_getstats",
+    [43] = "get_cpu_stats", [44] = "serial_read",
+    [45] = "dmesg",         [46] = "set_present_mode",
+};
+
+/* 64/32 division without libgcc: two DIVLs, each with a quotient below 2^32 */
+static unsigned long long udiv64(unsigned long long n, unsigned int d) {
+    unsigned int high = n >> 32, low = n, qhigh, qlow, rem;
+
+    __asm__("divl %4" : "=a"(qhigh), "=d"(rem) : "a"(high), "d"(0), "rm"(d));
+    __asm__("divl %4" : "=a"(qlow), "=d"(rem) : "a"(low), "d"(rem), "rm"(d));
+    return ((unsigned long long)qhigh << 32) | qlow;
+}
+
+void dump_syscall_stats(int pid) {
+    struct syscall_stats st;
+
+    for (int nr = 0; nr < NR_SYSCALLS; nr++) {
+        if (get_syscall_stats(nr, pid, &st) < 0 || st.calls == 0) continue;
+
+        const char *name = syscall_names[nr] ? syscall_names[nr] : "?";
+
+        prints("%d %s: %u calls, avg %u, max %u\n", nr, name, st.calls,
+               (unsigned int)udiv64(st.cycles, st.calls), st.max_cycles);
+
+        if (pid != 0) continue;
+
+        /* Non-empty log2 buckets: [b]=n means n calls took 2^b to 2^(b+1)-1 cycles */
+        prints("   ");
+        for (int b = 0; b < SYSCALL_HIST_BUCKETS; b++) {
+            if (st.hist[b]) prints(" [%d]=%u", b, st.hist[b]);
+        }
+        prints("\n");
+    }
+}
+
+/****************************************/
+/**    Sampling Profiler               **/
+/****************************************/
+
+int prof_dump(void) {
+    static struct prof_sample samples[32];
+    int total = 0;
+    int n;
+
+    while ((n = prof_read(samples, 32)) > 0) {
+        for (int i = 0; i < n; i++) {
+            struct prof_sample *s = &samples[i];
+            printd("@prof %c %d %d %u %u %u\n", (s->flags & PROF_SAMPLE_KERNEL) ? 'k' : 'u',
+                   s->pid, s->tid, s->eip, s->callers[0], s->callers[1]);
+        }
+        total += n;
+    }
+
+    return total;
+}
+
+/****************************************/
+/**    Event Tracing                   **/
+/****************************************/
+
+int trace_dump(void) {
+    static struct trace_record records[16];
+    int total = 0;
+    int n;
+
+    /* Lets the decoder turn TSC cycles into microseconds */
+    printd("@trace-clock %u %d\n", VDSO->tsc_per_tick, TICKS_PER_SECOND);
+
+    while ((n = trace_read(records, 16)) > 0) {
+        for (int i = 0; i < n; i++) {
+            struct trace_record *r = &records[i];
+            printd("@trace %u %u %d %d %d %d %u %u\n", (unsigned int)(r->tsc >> 32),
+                   (unsigned int)r->tsc, r->event, r->lost, r->pid, r->tid, r->args[0],
+                   r->args[1]);
+        }
+        total += n;
+    }
+
+    return total;
+}
+
 /****************************************/
 /**    Utility Functions               **/
 /****************************************/
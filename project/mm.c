@@ -7,6 +7,7 @@
  */
 
 #include <hardware.h>
+#include <lapic.h>
 #include <mm.h>
 #include <sched.h>
 #include <segment.h>
@@ -27,6 +28,9 @@ page_table_entry dir_pages[NR_TASKS][TOTAL_PAGES] __attribute__((__section__(".d
 /* User page tables for each task */
 page_table_entry pagusr_table[NR_TASKS][TOTAL_PAGES] __attribute__((__section__(".data.task")));
 
+/* 1 once the page table of a task slot maps the kernel pages */
+static Byte table_ready[NR_TASKS];
+
 /* Task State Segment */
 TSS tss;
 
@@ -42,23 +46,40 @@ void init_dir_pages(void) {
     }
 }
 
-void init_table_pages(void) {
-    int i, j;
+void init_task_table(int pos) {
+    int i;
+
+    if (table_ready[pos]) return;
+
     /* reset all entries */
+    for (i = 0; i < TOTAL_PAGES; i++) {
+        pagusr_table[pos][i].entry = 0;
+    }
+    /* Init kernel pages */
+    for (i = 1; i < NUM_PAG_KERNEL;
+         i++) // Leave the page inaccessible to comply with NULL convention
+    {
+        // Logical page equal to physical page (frame)
+        pagusr_table[pos][i].bits.pbase_addr = i;
+        pagusr_table[pos][i].bits.rw = 1;
+        pagusr_table[pos][i].bits.present = 1;
+    }
+    /* Local APIC registers: device memory, never cached */
+    pagusr_table[pos][LAPIC_PAGE].bits.pbase_addr = LAPIC_PHYS_BASE >> 12;
+    pagusr_table[pos][LAPIC_PAGE].bits.cache_d = 1;
+    pagusr_table[pos][LAPIC_PAGE].bits.write_t = 1;
+    pagusr_table[pos][LAPIC_PAGE].bits.rw = 1;
+    pagusr_table[pos][LAPIC_PAGE].bits.present = 1;
+    table_ready[pos] = 1;
+}
+
+void init_table_pages(void) {
+#if !FAST_BOOT
+    int j;
     for (j = 0; j < NR_TASKS; j++) {
-        for (i = 0; i < TOTAL_PAGES; i++) {
-            pagusr_table[j][i].entry = 0;
-        }
-        /* Init kernel pages */
-        for (i = 1; i < NUM_PAG_KERNEL;
-             i++) // Leave the page inaccessible to comply with NULL convention
-        {
-            // Logical page equal to physical page (frame)
-            pagusr_table[j][i].bits.pbase_addr = i;
-            pagusr_table[j][i].bits.rw = 1;
-            pagusr_table[j][i].bits.present = 1;
-        }
+        init_task_table(j);
     }
+#endif
 }
 
 void set_user_pages(struct task_struct *task) {
@@ -105,6 +126,18 @@ void set_pe_flag(void) {
     write_cr0(cr0);
 }
 
+void set_wp_flag(void) {
+    unsigned int cr0 = read_cr0();
+    cr0 |= CR0_WP;
+    write_cr0(cr0);
+}
+
+void clear_wp_flag(void) {
+    unsigned int cr0 = read_cr0();
+    cr0 &= ~CR0_WP;
+    write_cr0(cr0);
+}
+
 void init_mm(void) {
     init_table_pages();
     init_frames();
@@ -112,6 +145,7 @@ void init_mm(void) {
     allocate_DIR(&tasks[0].task);
     set_cr3(get_DIR(&tasks[0].task));
     set_pe_flag();
+    set_wp_flag();
 }
 
 void setGdt(void) {
@@ -173,6 +207,7 @@ int init_frames(void) {
 
 int alloc_frame(void) {
     int i;
+    /* Callers run with interrupts disabled on the only CPU: no lock needed */
     for (i = NUM_PAG_KERNEL; i < TOTAL_PAGES;) {
         if (phys_mem[i] == FREE_FRAME) {
             phys_mem[i] = USED_FRAME;
@@ -207,6 +242,13 @@ void set_ss_pag(page_table_entry *PT, unsigned page, unsigned frame) {
     PT[page].bits.present = 1;
 }
 
+void set_user_ro_pag(page_table_entry *PT, unsigned page, unsigned frame) {
+    PT[page].entry = 0;
+    PT[page].bits.pbase_addr = frame;
+    PT[page].bits.user = 1;
+    PT[page].bits.present = 1;
+}
+
 void del_ss_pag(page_table_entry *PT, unsigned logical_page) {
     PT[logical_page].entry = 0;
 }
@@ -0,0 +1,71 @@
+/**
+ * @file pit.c
+ * @brief Programmable interval timer counter read-back.
+ */
+
+#include <io.h>
+#include <pit.h>
+#include <utils.h>
+
+/* Polls of the channel 2 OUT pin before calibration gives up */
+#define PIT_CALIBRATE_MAX_POLLS 10000000
+
+unsigned int pit_reload = PIT_BIOS_RELOAD;
+
+void pit_set_rate(unsigned int hz) {
+    unsigned int reload = (PIT_INPUT_HZ + hz / 2) / hz;
+
+    if (reload < 2) reload = 2;
+    if (reload > PIT_BIOS_RELOAD) reload = PIT_BIOS_RELOAD;
+
+    outb(PIT_CMD_PORT, PIT_CH0_RATE);
+    outb(PIT_CH0_PORT, reload & 0xff);
+    outb(PIT_CH0_PORT, (reload >> 8) & 0xff); /* 65536 is written as 0 */
+    pit_reload = reload;
+}
+
+unsigned int pit_calibrate_tsc(unsigned int ms) {
+    unsigned int count = PIT_INPUT_HZ * ms / 1000;
+    unsigned int low0, high0, low1, high1;
+    Byte gate = inb(PIT_GATE_PORT);
+    int polls = 0;
+
+    /* Gate channel 2 on, keep the speaker quiet */
+    outb(PIT_GATE_PORT, (gate & ~PIT_SPEAKER) | PIT_GATE_CH2);
+    outb(PIT_CMD_PORT, PIT_CH2_ONESHOT);
+    outb(PIT_CH2_PORT, count & 0xff);
+    outb(PIT_CH2_PORT, (count >> 8) & 0xff);
+
+    /* Counting starts with the high byte: OUT rises at terminal count */
+    rdtsc(low0, high0);
+    while (!(inb(PIT_GATE_PORT) & PIT_CH2_OUT) && ++polls < PIT_CALIBRATE_MAX_POLLS) {
+    }
+    rdtsc(low1, high1);
+    outb(PIT_GATE_PORT, gate);
+
+    if (polls == PIT_CALIBRATE_MAX_POLLS) return 0;
+
+    unsigned long long cycles =
+        (((unsigned long long)high1 << 32) | low1) - (((unsigned long long)high0 << 32) | low0);
+    do_div(cycles, ms);
+    return (cycles >> 32) ? 0xffffffff : (unsigned int)cycles;
+}
+
+unsigned int pit_elapsed(void) {
+    outb(PIT_CMD_PORT, PIT_READBACK_CH0);
+    unsigned int status = inb(PIT_CH0_PORT);
+    unsigned int count = inb(PIT_CH0_PORT);
+    count |= (unsigned int)inb(PIT_CH0_PORT) << 8;
+    if (count == 0) count = 65536;
+
+    /* Modes 6 and 7 are aliases of 2 and 3 */
+    unsigned int mode = (status >> 1) & 3;
+    if (mode == 3) {
+        /* Square wave: counts down by 2 in each half; OUT is high in the first */
+        unsigned int done = (pit_reload - count) / 2;
+        return (status & PIT_STATUS_OUT) ? done : pit_reload / 2 + done;
+    }
+
+    /* Rate generator: one pass from the reload value down to 1 per period */
+    return pit_reload - count;
+}
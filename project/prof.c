@@ -0,0 +1,222 @@
+/**
+ * @file prof.c
+ * @brief Host tool that symbolizes ZeOS profiler samples.
+ *
+ * Reads the "@prof" lines written by prof_dump() to the debug port
+ * (COM1, or the Bochs port 0xe9) and resolves every address against
+ * the function symbols of the system (kernel samples) or user (user
+ * samples) ELF files. It prints:
+ *
+ * - a flat profile: samples whose EIP falls in each function (self time)
+ * - a call-count profile: samples in which each function is on the
+ *   recorded part of the stack (itself or a caller), and the sampled
+ *   caller -> callee edges with their counts
+ *
+ * Usage: ./prof system user < serial.out (or the Bochs output without a UART)
+ */
+
+#include <elf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Must match PROF_CALLERS in include/prof_data.h */
+#define PROF_CALLERS 2
+
+struct symbol {
+    unsigned int addr;
+    unsigned int size;
+    const char *name;
+};
+
+struct symtab {
+    struct symbol *syms;
+    int count;
+};
+
+/* Per-function and per-edge counters */
+struct counter {
+    const char *name;   /* Function (or caller of an edge) */
+    const char *callee; /* NULL for function counters */
+    int samples;
+};
+
+struct counters {
+    struct counter *items;
+    int count;
+    int capacity;
+};
+
+static void die(const char *msg, const char *arg) {
+    fprintf(stderr, "prof: %s%s\n", msg, arg ? arg : "");
+    exit(1);
+}
+
+static int cmp_symbol(const void *a, const void *b) {
+    const struct symbol *x = a, *y = b;
+    return (x->addr > y->addr) - (x->addr < y->addr);
+}
+
+/* Load the function symbols of a 32-bit ELF file, sorted by address */
+static void load_symbols(const char *path, struct symtab *tab) {
+    FILE *f = fopen(path, "rb");
+    if (!f) die("cannot open ", path);
+
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    unsigned char *image = malloc(size);
+    if (!image || fread(image, 1, size, f) != (size_t)size) die("cannot read ", path);
+    fclose(f);
+
+    Elf32_Ehdr *eh = (Elf32_Ehdr *)image;
+    if (size < (long)sizeof(*eh) || memcmp(eh->e_ident, ELFMAG, SELFMAG) != 0 ||
+        eh->e_ident[EI_CLASS] != ELFCLASS32)
+        die("not a 32-bit ELF file: ", path);
+
+    Elf32_Shdr *sh = (Elf32_Shdr *)(image + eh->e_shoff);
+    tab->syms = NULL;
+    tab->count = 0;
+
+    for (int i = 0; i < eh->e_shnum; i++) {
+        if (sh[i].sh_type != SHT_SYMTAB) continue;
+
+        Elf32_Sym *sym = (Elf32_Sym *)(image + sh[i].sh_offset);
+        const char *strtab = (const char *)image + sh[sh[i].sh_link].sh_offset;
+        int nsyms = sh[i].sh_size / sizeof(Elf32_Sym);
+
+        tab->syms = realloc(tab->syms, (tab->count + nsyms) * sizeof(struct symbol));
+        for (int j = 0; j < nsyms; j++) {
+            int type = ELF32_ST_TYPE(sym[j].st_info);
+            /* Assembly entry points (ENTRY()) are untyped: keep them too */
+            if (type != STT_FUNC && !(type == STT_NOTYPE && sym[j].st_shndx != SHN_UNDEF &&
+                                      sym[j].st_shndx < SHN_LORESERVE && sym[j].st_name))
+                continue;
+            tab->syms[tab->count].addr = sym[j].st_value;
+            tab->syms[tab->count].size = sym[j].st_size;
+            tab->syms[tab->count].name = strtab + sym[j].st_name;
+            tab->count++;
+        }
+    }
+
+    if (tab->count == 0) die("no symbols in ", path);
+    qsort(tab->syms, tab->count, sizeof(struct symbol), cmp_symbol);
+    /* The image stays allocated: symbol names point into it */
+}
+
+/* Function containing addr, or NULL */
+static const char *lookup(const struct symtab *tab, unsigned int addr) {
+    int lo = 0, hi = tab->count - 1, found = -1;
+
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (tab->syms[mid].addr <= addr) {
+            found = mid;
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    if (found < 0) return NULL;
+    const struct symbol *s = &tab->syms[found];
+    if (s->size != 0 && addr >= s->addr + s->size) return NULL;
+    return s->name;
+}
+
+static void count(struct counters *c, const char *name, const char *callee) {
+    for (int i = 0; i < c->count; i++) {
+        if (c->items[i].name == name && c->items[i].callee == callee) {
+            c->items[i].samples++;
+            return;
+        }
+    }
+
+    if (c->count == c->capacity) {
+        c->capacity = c->capacity ? 2 * c->capacity : 64;
+        c->items = realloc(c->items, c->capacity * sizeof(struct counter));
+    }
+    c->items[c->count].name = name;
+    c->items[c->count].callee = callee;
+    c->items[c->count].samples = 1;
+    c->count++;
+}
+
+static int cmp_counter(const void *a, const void *b) {
+    const struct counter *x = a, *y = b;
+    return y->samples - x->samples;
+}
+
+static void print_counters(struct counters *c, int total) {
+    qsort(c->items, c->count, sizeof(struct counter), cmp_counter);
+    for (int i = 0; i < c->count; i++) {
+        struct counter *it = &c->items[i];
+        printf("%8d %6.2f%%  %s%s%s\n", it->samples, 100.0 * it->samples / total, it->name,
+               it->callee ? " -> " : "", it->callee ? it->callee : "");
+    }
+}
+
+int main(int argc, char **argv) {
+    struct symtab kernel, user;
+    struct counters flat = {0}, inclusive = {0}, edges = {0};
+    char line[256];
+    int total = 0, kernel_samples = 0;
+
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s system user < bochs-output\n", argv[0]);
+        return 1;
+    }
+
+    load_symbols(argv[1], &kernel);
+    load_symbols(argv[2], &user);
+
+    while (fgets(line, sizeof(line), stdin)) {
+        char *rec = strstr(line, "@prof ");
+        char mode;
+        int pid, tid;
+        unsigned int addr[1 + PROF_CALLERS];
+
+        if (!rec || sscanf(rec, "@prof %c %d %d %u %u %u", &mode, &pid, &tid, &addr[0], &addr[1],
+                           &addr[2]) != 6)
+            continue;
+
+        const struct symtab *tab = (mode == 'k') ? &kernel : &user;
+        const char *names[1 + PROF_CALLERS];
+
+        /* Return addresses point after the call: look up the call itself */
+        for (int i = 0; i <= PROF_CALLERS; i++) {
+            names[i] = (addr[i] == 0) ? NULL : lookup(tab, i == 0 ? addr[i] : addr[i] - 1);
+        }
+        if (!names[0]) names[0] = "[unknown]";
+
+        total++;
+        if (mode == 'k') kernel_samples++;
+        count(&flat, names[0], NULL);
+
+        for (int i = 0; i <= PROF_CALLERS && names[i]; i++) {
+            /* Count a recursive function once per sample */
+            int seen = 0;
+            for (int j = 0; j < i; j++) seen |= (names[j] == names[i]);
+            if (!seen) count(&inclusive, names[i], NULL);
+
+            if (i > 0) count(&edges, names[i], names[i - 1]);
+        }
+    }
+
+    if (total == 0) {
+        fprintf(stderr, "prof: no @prof samples in the input\n");
+        return 1;
+    }
+
+    printf("%d samples (%d kernel, %d user)\n", total, kernel_samples, total - kernel_samples);
+    printf("\nFlat profile (samples in the function itself):\n");
+    print_counters(&flat, total);
+    printf("\nInclusive profile (function or its callees, %d frames recorded):\n",
+           1 + PROF_CALLERS);
+    print_counters(&inclusive, total);
+    printf("\nCall counts (caller -> callee, per sample):\n");
+    print_counters(&edges, total);
+
+    return 0;
+}
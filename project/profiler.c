@@ -0,0 +1,127 @@
+/**
+ * @file profiler.c
+ * @brief Clock-driven sampling profiler for ZeOS.
+ *
+ * This file implements the per-CPU sample rings filled from the clock
+ * interrupt and the start/stop/read operations behind the profiler
+ * system calls.
+ */
+
+#include <errno.h>
+#include <mm.h>
+#include <mm_address.h>
+#include <profiler.h>
+#include <sched.h>
+#include <smp.h>
+#include <sys.h>
+#include <utils.h>
+
+/* Positions in the SAVE_ALL frame passed by the interrupt entry */
+#define REG_EBP (STACK_EBP - STACK_EBX)
+#define REG_EIP (STACK_USER_EIP - STACK_EBX)
+#define REG_CS (STACK_USER_CS - STACK_EBX)
+
+struct prof_ring {
+    struct prof_sample samples[PROF_RING_SIZE];
+    unsigned int head; /* Next sample to read */
+    unsigned int tail; /* Next slot to fill */
+};
+
+/* One ring per CPU; only the bootstrap processor takes clock interrupts */
+static struct prof_ring prof_rings[NR_CPUS];
+
+static int prof_period = 0; /* Ticks between samples, 0 while stopped */
+static int prof_countdown = 0;
+static int prof_dropped = 0;
+
+/* Scheduling happens on the bootstrap processor only */
+static int this_cpu(void) {
+    return 0;
+}
+
+/* 1 if the user word at addr can be read without faulting */
+static int user_word_present(unsigned long addr) {
+    if (!access_ok(VERIFY_READ, (void *)addr, sizeof(unsigned long))) return 0;
+
+    page_table_entry *PT = get_PT(current_task);
+    return PT[addr >> 12].bits.present && PT[(addr + sizeof(unsigned long) - 1) >> 12].bits.present;
+}
+
+/* 1 if a frame record at ebp lies inside the current kernel stack */
+static int kernel_frame_valid(unsigned long ebp) {
+    unsigned long low = (unsigned long)((union task_union *)current_task)->stack;
+    unsigned long high = KERNEL_ESP((union task_union *)current_task);
+    return ebp >= low && ebp + 2 * sizeof(unsigned long) <= high;
+}
+
+void prof_tick(unsigned long *regs) {
+    if (prof_period == 0 || --prof_countdown > 0) return;
+    prof_countdown = prof_period;
+
+    struct prof_ring *ring = &prof_rings[this_cpu()];
+    if (ring->tail - ring->head == PROF_RING_SIZE) {
+        prof_dropped++;
+        return;
+    }
+
+    struct prof_sample *s = &ring->samples[ring->tail % PROF_RING_SIZE];
+    int kernel = (regs[REG_CS] & 3) == 0;
+
+    s->eip = regs[REG_EIP];
+    s->pid = current_task->PID;
+    s->tid = current_task->TID;
+    s->flags = kernel ? PROF_SAMPLE_KERNEL : 0;
+
+    /* Follow saved EBPs: [ebp] is the caller's EBP, [ebp+4] its return address */
+    unsigned long ebp = regs[REG_EBP];
+    for (int i = 0; i < PROF_CALLERS; i++) {
+        int valid = kernel ? kernel_frame_valid(ebp)
+                           : user_word_present(ebp) && user_word_present(ebp + 4);
+        if (!valid) {
+            s->callers[i] = 0;
+            ebp = 0;
+            continue;
+        }
+        s->callers[i] = ((unsigned long *)ebp)[1];
+        ebp = ((unsigned long *)ebp)[0];
+    }
+
+    ring->tail++;
+}
+
+int prof_start(int period) {
+    if (period <= 0) return -EINVAL;
+
+    for (int cpu = 0; cpu < NR_CPUS; cpu++) {
+        prof_rings[cpu].head = prof_rings[cpu].tail = 0;
+    }
+    prof_dropped = 0;
+    prof_countdown = period;
+    prof_period = period;
+    return 0;
+}
+
+int prof_active(void) {
+    return prof_period != 0;
+}
+
+int prof_stop(void) {
+    prof_period = 0;
+    return prof_dropped;
+}
+
+int prof_read(struct prof_sample *buf, int n) {
+    int copied = 0;
+
+    for (int cpu = 0; cpu < nr_cpus && copied < n; cpu++) {
+        struct prof_ring *ring = &prof_rings[cpu];
+        while (ring->head != ring->tail && copied < n) {
+            copy_to_user(&ring->samples[ring->head % PROF_RING_SIZE], &buf[copied],
+                         sizeof(struct prof_sample));
+            ring->head++;
+            copied++;
+        }
+    }
+
+    return copied;
+}
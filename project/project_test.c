@@ -12,6 +12,8 @@
 
 #include <errno.h>
 #include <libc.h>
+#include <mm_address.h>
+#include <pit.h>
 #include <project_test.h>
 #include <screen_samples.h>
 #include <zeos_test.h>
@@ -39,6 +41,16 @@ static int project_tests_run = 0;
 static int project_tests_passed = 0;
 
 static volatile int kbd_syscall_tested = 0;
+
+/* read_keys reader thread results */
+static struct kbd_event kbd_reader_events[KBD_MAX_KEYS];
+static volatile int kbd_reader_count = 0;
+static volatile int kbd_reader_done = 0;
+
+/* Upcall batching subtest counters */
+static volatile int kbd_upcalls = 0;
+static volatile int kbd_upcall_events = 0;
+static volatile int kbd_batch_errors = 0;
 static volatile int kbd_syscall_results[NUM_SYSCALLS_TO_TEST];
 static volatile int kbd_syscall_errnos[NUM_SYSCALLS_TO_TEST];
 
@@ -53,9 +65,74 @@ static volatile int wft_threads_completed = 0;
 static volatile int wft_threads_woken_same_tick = 0;
 static volatile int wft_wake_tick = 0;
 
+/* FPU test variables */
+static int fpu_subtests_run = 0;
+static int fpu_subtests_passed = 0;
+static volatile int fpu_threads_completed = 0;
+static volatile int fpu_results[FPU_TEST_THREADS];
+
+/* EDF test variables */
+static int edf_subtests_run = 0;
+static int edf_subtests_passed = 0;
+static volatile int edf_thread_done = 0;
+static volatile int edf_min_spacing = 0;
+static struct sched_stats edf_thread_stats;
+
+/* Context switch benchmark variables */
+static int ctx_switch_perf_passed = 0;
+
+/* Preemption latency test variables */
+static int preempt_latency_passed = 0;
+static volatile int preempt_writer_done = 0;
+static char preempt_write_buffer[PREEMPT_WRITE_SIZE];
+
+/* Shared page test variables */
+static int vdso_passed = 0;
+static volatile int vdso_thread_ok = 0;
+static volatile int vdso_thread_done = 0;
+
+/* Submission/completion ring test variables */
+static int uring_passed = 0;
+static struct uring test_ring;
+
+/* Syscall statistics test variables */
+static int syscall_stats_passed = 0;
+
+/* Profiler test variables */
+static int profiler_passed = 0;
+static struct prof_sample prof_test_samples[PROF_TEST_CHUNK];
+
+/* Event tracing test variables */
+static int trace_passed = 0;
+static struct trace_record trace_test_records[TRACE_TEST_CHUNK];
+static volatile int trace_thread_done = 0;
+
+/* Interrupts-off tracer test variables */
+static int irqsoff_passed = 0;
+
 /* Tick calibration test variables */
 static int tick_cal_passed = 0;
 
+/* Tick rate test variables */
+static int tick_rate_passed = 0;
+
+/* CPU load test variables */
+static int cpu_load_passed = 0;
+
+/* Serial port test variables */
+static int serial_passed = 0;
+static char serial_test_buffer[SERIAL_TEST_BYTES];
+
+/* Kernel log test variables */
+static int klog_passed = 0;
+static char klog_test_buffer[KLOG_TEST_BYTES];
+
+/* Console scrolling test variables */
+static int console_scroll_passed = 0;
+
+/* Page flipping test variables */
+static int present_passed = 0;
+
 /* FPS test state variables */
 static volatile int fps_test_exit = 0;
 static volatile int fps_next_scene = 0;
@@ -132,7 +209,7 @@ static void survivor_thread_func(void *arg) {
            getpid(), gettid());
 
     /* Exit the process */
-    exit();
+    exit(0);
 }
 
 static void long_work_thread_func(void *arg) {
@@ -241,8 +318,8 @@ static void test_kbd_handler_with_syscall(char key, int pressed) {
 /****************************************/
 
 void busyWait(int ticks) {
-    int start_time = gettime();
-    while (gettime() - start_time < ticks) {
+    int start_time = fast_gettime();
+    while (fast_gettime() - start_time < ticks) {
         /* Busy wait */
     }
 }
@@ -341,7 +418,7 @@ void subtest_max_threads(int *passed) {
     /* Master already uses 1 slot (slot 0), so we can create MAX - 1 new threads */
     int max_new_threads = MAX_THREADS_PER_PROCESS - 1;
 
-    print_subtest_header(1, "Create maximum additional threads (9) and verify limit");
+    print_subtest_header(1, "Create maximum additional threads and verify limit");
 
     clear_all_flags();
 
@@ -366,7 +443,7 @@ void subtest_max_threads(int *passed) {
     prints("[PID %d] [TID %d] Created %d/%d additional threads\n", getpid(), gettid(), created,
            max_new_threads);
 
-    /* Expect exactly max_new_threads (4) to be created */
+    /* Expect exactly max_new_threads to be created */
     int test1_passed = (created == max_new_threads);
     print_subtest_result(test1_passed);
 
@@ -388,13 +465,13 @@ void subtest_max_threads(int *passed) {
         if (tids[i] > 0) created++;
     }
 
-    /* Now try to create one more - should fail (we have master + max_new_threads = 10 total) */
-    int extra_flag = 9;
+    /* Now try to create one more - should fail (master + max_new_threads fill every slot) */
+    int extra_flag = max_new_threads;
     int extra_tid = ThreadCreate(simple_thread_func, &extra_flag);
 
     if (extra_tid < 0) {
-        prints("[PID %d] [TID %d] Correctly rejected 10th additional thread (returned %d)\n",
-               getpid(), gettid(), extra_tid);
+        prints("[PID %d] [TID %d] Correctly rejected additional thread %d (returned %d)\n",
+               getpid(), gettid(), MAX_THREADS_PER_PROCESS, extra_tid);
         *passed = 1;
     } else {
         prints("[PID %d] [TID %d] ERROR: Created extra thread with TID %d (should have failed)\n",
@@ -475,7 +552,7 @@ void subtest_last_thread_exits(void) {
 
         /* Should never reach here */
         prints("-> FAILED: Code after ThreadExit executed!\n");
-        exit();
+        exit(0);
 
     } else if (pid > 0) {
         /* Parent waits for child to complete */
@@ -528,7 +605,7 @@ void subtest_master_reassignment(void) {
         } else {
             prints("-> FAILED: Could not create survivor thread\n");
         }
-        exit();
+        exit(0);
 
     } else if (pid > 0) {
         /* Parent waits for child to complete */
@@ -574,7 +651,7 @@ void subtest_fork_single_thread(int *passed) {
 
     if (child_pid == 0) {
         /* Child process - should only have current thread, not the secondary one */
-        /* Child starts fresh with 1 thread (master), so can create 9 more */
+        /* Child starts fresh with 1 thread (master), so can create all the other slots */
         int max_new_threads = MAX_THREADS_PER_PROCESS - 1;
 
         prints("[PID %d] [TID %d] Child: I should be the only thread\n", getpid(), gettid());
@@ -602,7 +679,7 @@ void subtest_fork_single_thread(int *passed) {
 
         /* Wait for threads to complete and exit */
         busyWait(TIME_MEDIUM);
-        exit();
+        exit(0);
 
     } else if (child_pid > 0) {
         /* Parent - wait for child and our secondary thread */
@@ -899,6 +976,231 @@ void subtest_kbd_einprogress(int *passed) {
     if (*passed) kbd_subtests_passed++;
 }
 
+void subtest_kbd_read_keys_timeout(int *passed) {
+    print_subtest_header(5, "read_keys argument checks, polling and timeout");
+
+    struct kbd_event events[KBD_MAX_KEYS];
+    *passed = 1;
+
+    RESET_ERRNO();
+    int ret = read_keys(events, -1, 0);
+    prints("[PID %d] [TID %d] read_keys(n=-1): ret=%d errno=%d (expected -1, EINVAL)\n",
+           getpid(), gettid(), ret, errno);
+    if (ret != -1 || errno != EINVAL) *passed = 0;
+
+    RESET_ERRNO();
+    ret = read_keys((struct kbd_event *)0x100, KBD_MAX_KEYS, 0);
+    prints("[PID %d] [TID %d] read_keys(kernel buffer): ret=%d errno=%d (expected -1, EFAULT)\n",
+           getpid(), gettid(), ret, errno);
+    if (ret != -1 || errno != EFAULT) *passed = 0;
+
+    /* Drain anything typed earlier, then poll an empty ring */
+    while (read_keys(events, KBD_MAX_KEYS, 0) > 0)
+        ;
+    ret = read_keys(events, KBD_MAX_KEYS, 0);
+    prints("[PID %d] [TID %d] read_keys(timeout=0) on empty ring: ret=%d (expected 0)\n",
+           getpid(), gettid(), ret);
+    if (ret != 0) *passed = 0;
+
+    prints("[PID %d] [TID %d] Waiting %d ticks in read_keys (do not press keys)...\n", getpid(),
+           gettid(), KBD_READ_TIMEOUT);
+    int start = gettime();
+    ret = read_keys(events, KBD_MAX_KEYS, KBD_READ_TIMEOUT);
+    int waited = gettime() - start;
+    prints("[PID %d] [TID %d] read_keys returned %d after %d ticks\n", getpid(), gettid(), ret,
+           waited);
+    if (ret < 0 || (ret == 0 && waited < KBD_READ_TIMEOUT)) *passed = 0;
+
+    print_subtest_result(*passed);
+    kbd_subtests_run++;
+    if (*passed) kbd_subtests_passed++;
+}
+
+static void kbd_reader_thread(void *arg) {
+    (void)arg;
+    kbd_reader_count = read_keys(kbd_reader_events, KBD_MAX_KEYS, TIME_KBD_WAIT);
+    kbd_reader_done = 1;
+    ThreadExit();
+}
+
+void subtest_kbd_read_keys_blocking(int *passed) {
+    print_subtest_header(6, "Blocking read_keys from a reader thread");
+
+    kbd_reader_done = 0;
+    kbd_reader_count = 0;
+
+    if (ThreadCreate(kbd_reader_thread, (void *)0) < 0) {
+        prints("[PID %d] [TID %d] Failed to create reader thread\n", getpid(), gettid());
+        *passed = 0;
+        print_subtest_result(*passed);
+        kbd_subtests_run++;
+        return;
+    }
+
+    prints("[PID %d] [TID %d] Reader thread blocked in read_keys. Press some keys...\n",
+           getpid(), gettid());
+
+    /* Keep the CPU busy: events must reach the reader even though we are running */
+    while (!kbd_reader_done) {
+    }
+
+    if (kbd_reader_count > 0) {
+        prints("[PID %d] [TID %d] Reader got %d events:\n", getpid(), gettid(), kbd_reader_count);
+        for (int i = 0; i < kbd_reader_count; i++) {
+            char scancode = kbd_reader_events[i].key;
+            char ch = (scancode < 87) ? scancode_to_char[(int)scancode] : '?';
+            if (ch == '\0') ch = '?';
+            prints("  [%d] tick %d: scancode=0x%d -> '%c' (%s)\n", i + 1,
+                   kbd_reader_events[i].time, (int)scancode, ch,
+                   kbd_reader_events[i].pressed ? "PRESSED" : "RELEASED");
+        }
+        *passed = 1;
+    } else if (kbd_reader_count == 0) {
+        prints("[PID %d] [TID %d] No events received (press keys during test!)\n", getpid(),
+               gettid());
+        /* Still pass if no keys pressed - the reader woke up on its timeout */
+        *passed = 1;
+    } else {
+        prints("[PID %d] [TID %d] read_keys failed in reader thread\n", getpid(), gettid());
+        *passed = 0;
+    }
+
+    print_subtest_result(*passed);
+    kbd_subtests_run++;
+    if (*passed) kbd_subtests_passed++;
+}
+
+static void kbd_handler_work(void) {
+    int start = gettime();
+    while (gettime() - start < KBD_HANDLER_WORK_TICKS) {
+    }
+}
+
+static void kbd_single_counting_handler(char key, int pressed) {
+    (void)key;
+    (void)pressed;
+    kbd_upcalls++;
+    kbd_upcall_events++;
+    kbd_handler_work();
+}
+
+static void kbd_batch_counting_handler(struct kbd_event *events, int count) {
+    kbd_upcalls++;
+    kbd_upcall_events += count;
+    if (count < 1 || count > KBD_BATCH_MAX) kbd_batch_errors++;
+
+    /* Events come oldest first */
+    for (int i = 1; i < count; i++) {
+        if (events[i].time < events[i - 1].time) kbd_batch_errors++;
+    }
+    kbd_handler_work();
+}
+
+/* Run one hold-a-key phase with the given mode; returns the events received */
+static int kbd_batch_phase(int batch, int *upcalls) {
+    kbd_upcalls = 0;
+    kbd_upcall_events = 0;
+
+    int ret = batch ? KeyboardEventBatch(kbd_batch_counting_handler)
+                    : KeyboardEvent(kbd_single_counting_handler);
+    if (ret != 0) return -1;
+
+    prints("[PID %d] [TID %d] %s handler: hold a key down for %d seconds...\n", getpid(),
+           gettid(), batch ? "Batch" : "Single-event", TIME_KBD_WAIT / ONE_SECOND);
+    busyWait(TIME_KBD_WAIT);
+
+    KeyboardEvent((void *)0);
+    *upcalls = kbd_upcalls;
+    return kbd_upcall_events;
+}
+
+void subtest_kbd_batch_upcalls(int *passed) {
+    print_subtest_header(7, "Batched upcalls during key repeat");
+
+    int single_upcalls = 0, batch_upcalls = 0;
+    kbd_batch_errors = 0;
+
+    int single_events = kbd_batch_phase(0, &single_upcalls);
+    busyWait(TIME_KBD_PAUSE);
+    int batch_events = kbd_batch_phase(1, &batch_upcalls);
+
+    if (single_events < 0 || batch_events < 0) {
+        prints("[PID %d] [TID %d] Failed to register handler\n", getpid(), gettid());
+        *passed = 0;
+    } else {
+        prints("[PID %d] [TID %d] Single-event: %d events in %d upcalls\n", getpid(), gettid(),
+               single_events, single_upcalls);
+        prints("[PID %d] [TID %d] Batch:        %d events in %d upcalls\n", getpid(), gettid(),
+               batch_events, batch_upcalls);
+        if (batch_upcalls > 0) {
+            prints("[PID %d] [TID %d] Batching averaged %d.%d events per upcall\n", getpid(),
+                   gettid(), batch_events / batch_upcalls,
+                   (batch_events * 10 / batch_upcalls) % 10);
+        } else {
+            prints("[PID %d] [TID %d] No events received (hold a key during test!)\n", getpid(),
+                   gettid());
+        }
+        /* Batches must be well formed and never cost more upcalls than events */
+        *passed = (kbd_batch_errors == 0 && batch_upcalls <= batch_events);
+    }
+
+    print_subtest_result(*passed);
+    kbd_subtests_run++;
+    if (*passed) kbd_subtests_passed++;
+}
+
+void subtest_kbd_shared_state(int *passed) {
+    print_subtest_header(8, "Read-only shared keyboard state");
+
+    const volatile struct kbd_state *state = KeyboardState();
+    if (state == NULL) {
+        prints("[PID %d] [TID %d] KeyboardState failed (errno=%d)\n", getpid(), gettid(), errno);
+        *passed = 0;
+        print_subtest_result(*passed);
+        kbd_subtests_run++;
+        return;
+    }
+
+    *passed = (KeyboardState() == state);
+    prints("[PID %d] [TID %d] State mapped at %u (second call %s)\n", getpid(), gettid(),
+           (unsigned int)state, *passed ? "returns the same address" : "differs");
+
+    /* The kernel must not write the shared page for a syscall either */
+    RESET_ERRNO();
+    int ret = get_cpu_stats((struct cpu_stats *)state);
+    prints("[PID %d] [TID %d] get_cpu_stats(state page): ret=%d errno=%d (expected -1, EFAULT)\n",
+           getpid(), gettid(), ret, errno);
+    if (ret != -1 || errno != EFAULT) *passed = 0;
+
+    prints("[PID %d] [TID %d] Hold a key down (polling the page for %d seconds)...\n", getpid(),
+           gettid(), TIME_KBD_WAIT / ONE_SECOND);
+
+    unsigned int start_seq = state->seq;
+    int held_key = -1;
+    int start = gettime();
+    while (gettime() - start < TIME_KBD_WAIT && held_key < 0) {
+        for (int key = 0; key < KBD_KEYS; key++) {
+            if (KBD_KEY_HELD(state, key)) {
+                held_key = key;
+                break;
+            }
+        }
+    }
+
+    if (held_key >= 0) {
+        unsigned int changed = state->last_change[held_key];
+        prints("[PID %d] [TID %d] Key 0x%d held since tick %d (%d changes seen)\n", getpid(),
+               gettid(), held_key, changed, state->seq - start_seq);
+        if (changed > (unsigned int)gettime()) *passed = 0;
+    } else {
+        prints("[PID %d] [TID %d] No key held (hold a key during test!)\n", getpid(), gettid());
+    }
+
+    print_subtest_result(*passed);
+    kbd_subtests_run++;
+    if (*passed) kbd_subtests_passed++;
+}
+
 void keyboard_tests(void) {
     print_test_header("KEYBOARD SUPPORT TESTS");
 
@@ -928,6 +1230,18 @@ void keyboard_tests(void) {
     /* Subtest 4: EINPROGRESS inside handler */
     subtest_kbd_einprogress(&result);
 
+    /* Subtest 5: read_keys argument checks and timeout */
+    subtest_kbd_read_keys_timeout(&result);
+
+    /* Subtest 6: Blocking read_keys */
+    subtest_kbd_read_keys_blocking(&result);
+
+    /* Subtest 7: Batched upcalls */
+    subtest_kbd_batch_upcalls(&result);
+
+    /* Subtest 8: Shared keyboard state */
+    subtest_kbd_shared_state(&result);
+
     /* Print keyboard test summary */
     prints("\n========================================\n");
     prints("KEYBOARD SUPPORT TESTS: %d/%d subtests passed\n", kbd_subtests_passed,
@@ -1435,106 +1749,1871 @@ void waitfortick_tests(void) {
 }
 
 /****************************************/
-/**    Tick Calibration Test Functions **/
+/**    FPU Test Functions              **/
 /****************************************/
 
-void tick_calibration_test(void) {
-    print_test_header("TICK CALIBRATION TEST");
+/* Floating point loop whose integer result depends on every iteration */
+static int fpu_compute(int seed) {
+    double acc = 0.0;
+    double x = seed * 0.5;
+
+    for (int i = 0; i < FPU_TEST_ITERATIONS; i++) {
+        acc = acc * 0.999 + x;
+        x = x * 1.0001 + 0.25;
+        if (x > 1000.0) x -= 1000.0;
+    }
+    return (int)(acc * 16.0);
+}
 
-    prints("[PID %d] [TID %d] Starting tick calibration...\n", getpid(), gettid());
-    prints("[PID %d] [TID %d] Test duration: %d seconds\n", getpid(), gettid(),
-           TIME_CALIBRATION_SECONDS);
-    prints("[PID %d] [TID %d] USE A STOPWATCH!\n", getpid(), gettid());
-    prints("[PID %d] [TID %d] Starting in 3 seconds...\n", getpid(), gettid());
+static void fpu_test_thread_func(void *arg) {
+    int idx = *(int *)arg;
 
-    busyWait(TIME_CALIBRATION_COUNTDOWN);
+    fpu_results[idx] = fpu_compute(idx + 1);
+    fpu_threads_completed++;
+    ThreadExit();
+}
 
-    prints("[PID %d] [TID %d] GO!\n", getpid(), gettid());
+void subtest_fpu_threads(int *passed) {
+    print_subtest_header(1, "Concurrent threads using the FPU");
 
-    int start_ticks = gettime();
-    int expected_ticks = TIME_CALIBRATION_TICKS;
+    int expected[FPU_TEST_THREADS];
+    int thread_nums[FPU_TEST_THREADS];
+
+    /* Reference values computed without contention */
+    for (int i = 0; i < FPU_TEST_THREADS; i++) {
+        expected[i] = fpu_compute(i + 1);
+        fpu_results[i] = 0;
+        thread_nums[i] = i;
+    }
+    fpu_threads_completed = 0;
+
+    for (int i = 0; i < FPU_TEST_THREADS; i++) {
+        if (ThreadCreate(fpu_test_thread_func, &thread_nums[i]) < 0) {
+            prints("[PID %d] [TID %d] ERROR: Failed to create thread %d\n", getpid(), gettid(),
+                   i + 1);
+            *passed = 0;
+            print_subtest_result(*passed);
+            fpu_subtests_run++;
+            return;
+        }
+    }
+
+    /* The coordinator keeps using the FPU while the threads run */
+    int own = fpu_compute(FPU_TEST_THREADS + 1);
+
+    while (fpu_threads_completed < FPU_TEST_THREADS) {
+        WaitForTick();
+    }
 
-    busyWait(expected_ticks);
+    *passed = (own == fpu_compute(FPU_TEST_THREADS + 1));
+    for (int i = 0; i < FPU_TEST_THREADS; i++) {
+        prints("[PID %d] [TID %d] Thread %d result %d (expected %d)\n", getpid(), gettid(), i + 1,
+               fpu_results[i], expected[i]);
+        if (fpu_results[i] != expected[i]) *passed = 0;
+    }
 
-    int end_ticks = gettime();
-    int elapsed_ticks = end_ticks - start_ticks;
+    print_subtest_result(*passed);
+    fpu_subtests_run++;
+    if (*passed) fpu_subtests_passed++;
+}
 
-    prints("[PID %d] [TID %d] STOP!\n", getpid(), gettid());
+void subtest_fpu_fork(int *passed) {
+    print_subtest_header(2, "FPU use in a forked child");
 
-    prints("Expected: %d ticks\n", expected_ticks);
-    prints("Elapsed:  %d ticks\n", elapsed_ticks);
+    int expected = fpu_compute(7);
+    int pid = fork();
 
-    int deviation = elapsed_ticks - expected_ticks;
-    if (deviation < 0) deviation = -deviation;
+    if (pid == 0) {
+        exit(fpu_compute(7) == expected ? 0 : 1);
+    }
 
-    tick_cal_passed = (deviation <= expected_ticks / 20); /* 5% tolerance */
+    if (pid < 0) {
+        prints("[PID %d] [TID %d] ERROR: fork failed\n", getpid(), gettid());
+        *passed = 0;
+    } else {
+        /* Parent computes concurrently with the child */
+        int own = fpu_compute(7);
+        int status = -1;
+        int ret = waitpid(pid, &status, 0);
+
+        prints("[PID %d] [TID %d] Child %d exited with status %d\n", getpid(), gettid(), ret,
+               status);
+        *passed = (ret == pid && status == 0 && own == expected);
+    }
 
-    print_test_result("TICK CALIBRATION TEST", tick_cal_passed);
+    print_subtest_result(*passed);
+    fpu_subtests_run++;
+    if (*passed) fpu_subtests_passed++;
+}
+
+void fpu_tests(void) {
+    print_test_header("FPU SUPPORT TESTS");
+
+    fpu_subtests_run = 0;
+    fpu_subtests_passed = 0;
+
+    int result;
+
+    /* Subtest 1: Concurrent threads */
+    subtest_fpu_threads(&result);
+
+    /* Subtest 2: Forked child */
+    subtest_fpu_fork(&result);
 
+    prints("\n========================================\n");
+    prints("FPU SUPPORT TESTS: %d/%d subtests passed\n", fpu_subtests_passed, fpu_subtests_run);
+    prints("========================================\n");
+
+    int all_passed = (fpu_subtests_passed == fpu_subtests_run);
+    print_test_result("FPU SUPPORT TESTS", all_passed);
+
+    /* Track in global summary */
     project_tests_run++;
-    if (tick_cal_passed) project_tests_passed++;
+    if (all_passed) project_tests_passed++;
 }
 
 /****************************************/
-/**    FPS Visual Test Functions       **/
+/**    EDF Test Functions              **/
 /****************************************/
 
-/* Keyboard handler for FPS test - N/B/Esc navigation */
-static void fps_kbd_handler(char scancode, int pressed) {
-    unsigned char sc = (unsigned char)scancode;
-    if (!pressed) return; /* Only handle key press, not release */
+void subtest_edf_admission(int *passed) {
+    print_subtest_header(1, "EDF parameter validation and admission control");
 
-    switch (sc) {
-    case FPS_SCANCODE_ESC:
-        fps_test_exit = 1;
-        break;
-    case FPS_SCANCODE_N:
-        fps_next_scene = 1;
-        break;
-    case FPS_SCANCODE_B:
-        fps_prev_scene = 1;
-        break;
+    *passed = 1;
+
+    RESET_ERRNO();
+    if (sched_setdeadline(EDF_TEST_PERIOD, EDF_TEST_PERIOD + 1, 0) != -1 || errno != EINVAL) {
+        prints("[PID %d] [TID %d] ERROR: runtime > period accepted (errno=%d)\n", getpid(),
+               gettid(), errno);
+        *passed = 0;
+    }
+
+    RESET_ERRNO();
+    if (sched_setdeadline(EDF_TEST_PERIOD, EDF_TEST_PERIOD, 0) != -1 || errno != EBUSY) {
+        prints("[PID %d] [TID %d] ERROR: 100%% utilization admitted (errno=%d)\n", getpid(),
+               gettid(), errno);
+        *passed = 0;
+    }
+
+    RESET_ERRNO();
+    if (sched_waitperiod() != -1 || errno != EINVAL) {
+        prints("[PID %d] [TID %d] ERROR: sched_waitperiod outside EDF (errno=%d)\n", getpid(),
+               gettid(), errno);
+        *passed = 0;
+    }
+
+    struct sched_stats stats;
+    RESET_ERRNO();
+    if (sched_getstats(-1, &stats) != -1 || errno != ESRCH) {
+        prints("[PID %d] [TID %d] ERROR: sched_getstats accepted an invalid TID (errno=%d)\n",
+               getpid(), gettid(), errno);
+        *passed = 0;
     }
+
+    print_subtest_result(*passed);
+    edf_subtests_run++;
+    if (*passed) edf_subtests_passed++;
 }
 
-int fps_visual_test(void) {
-    char frame_buffer[SCREEN_BUFFER_SIZE];
-    char checkerboard_buffer[SCREEN_BUFFER_SIZE];
-    char rainbow_buffer[SCREEN_BUFFER_SIZE];
-    int current_scene = 1;
-    SceneState scene_state;
+static void edf_periodic_thread_func(void *arg) {
+    (void)arg;
+    int last_release = -1;
 
-    /* Pre-generate static patterns (only once) */
-    generate_checkerboard_pattern(checkerboard_buffer);
-    generate_rainbow_pattern(rainbow_buffer);
+    edf_min_spacing = EDF_TEST_PERIOD;
+    if (sched_setdeadline(EDF_TEST_PERIOD, EDF_TEST_RUNTIME, 0) < 0) {
+        edf_min_spacing = -1;
+        edf_thread_done = 1;
+        ThreadExit();
+    }
 
-    /* Reset state */
-    fps_test_exit = 0;
-    fps_next_scene = 0;
-    fps_prev_scene = 0;
-    scene_init(&scene_state);
+    for (int job = 0; job < EDF_TEST_JOBS; job++) {
+        int release = gettime();
+        if (last_release >= 0 && release - last_release < edf_min_spacing) {
+            edf_min_spacing = release - last_release;
+        }
+        last_release = release;
+        sched_waitperiod();
+    }
 
-    /* Register keyboard handler */
-    int ret = KeyboardEvent(fps_kbd_handler);
-    if (ret != 0) {
-        prints("[PID %d] [TID %d] Failed to register keyboard handler for FPS test\n", getpid(),
-               gettid());
-        return 0;
+    sched_getstats(0, &edf_thread_stats);
+    edf_thread_done = 1;
+    ThreadExit();
+}
+
+void subtest_edf_periodic(int *passed) {
+    print_subtest_header(2, "Periodic EDF thread");
+
+    edf_thread_done = 0;
+    if (ThreadCreate(edf_periodic_thread_func, (void *)0) < 0) {
+        prints("[PID %d] [TID %d] ERROR: Failed to create EDF thread\n", getpid(), gettid());
+        *passed = 0;
+    } else {
+        while (!edf_thread_done) {
+            WaitForTick();
+        }
+
+        prints("[PID %d] [TID %d] %d activations, %d misses, %d overruns, min spacing %d ticks\n",
+               getpid(), gettid(), edf_thread_stats.activations, edf_thread_stats.deadline_misses,
+               edf_thread_stats.budget_overruns, edf_min_spacing);
+
+        *passed = (edf_min_spacing >= EDF_TEST_PERIOD - 1 &&
+                   edf_thread_stats.activations >= EDF_TEST_JOBS &&
+                   edf_thread_stats.deadline_misses == 0);
     }
 
-    prints("[PID %d] [TID %d] FPS Visual Test started.\n", getpid(), gettid());
-    prints("[PID %d] [TID %d] Navigation: N=Next, B=Back, Esc=Exit\n", getpid(), gettid());
-    prints("[PID %d] [TID %d] Scene 1: Checkerboard pattern (static)\n", getpid(), gettid());
-    prints("[PID %d] [TID %d] Scene 2: Rainbow pattern (static)\n", getpid(), gettid());
-    prints("[PID %d] [TID %d] Scene 3: Starfield with twinkling stars\n", getpid(), gettid());
-    prints("[PID %d] [TID %d] Scene 4: Bouncing balls with decorations\n", getpid(), gettid());
+    print_subtest_result(*passed);
+    edf_subtests_run++;
+    if (*passed) edf_subtests_passed++;
+}
 
-    /* Small pause before starting */
-    busyWait(TIME_VISUAL_PAUSE);
+void edf_tests(void) {
+    print_test_header("EDF SCHEDULER TESTS");
 
-    int start_time = gettime();
+    edf_subtests_run = 0;
+    edf_subtests_passed = 0;
 
-    /* Main render loop */
+    int result;
+
+    /* Subtest 1: Admission control */
+    subtest_edf_admission(&result);
+
+    /* Subtest 2: Periodic thread */
+    subtest_edf_periodic(&result);
+
+    prints("\n========================================\n");
+    prints("EDF SCHEDULER TESTS: %d/%d subtests passed\n", edf_subtests_passed, edf_subtests_run);
+    prints("========================================\n");
+
+    int all_passed = (edf_subtests_passed == edf_subtests_run);
+    print_test_result("EDF SCHEDULER TESTS", all_passed);
+
+    /* Track in global summary */
+    project_tests_run++;
+    if (all_passed) project_tests_passed++;
+}
+
+/****************************************/
+/**    Context Switch Benchmark        **/
+/****************************************/
+
+static volatile int ctx_partner_done = 0;
+static volatile int ctx_partner_cost = -1;
+static volatile int ctx_ready[2];
+
+/* Low 32 bits of the TSC, enough for the short intervals measured here */
+static unsigned int read_tsc_low(void) {
+    unsigned int low;
+    __asm__ __volatile__("rdtsc" : "=a"(low) : : "edx");
+    return low;
+}
+
+static unsigned long long read_tsc(void) {
+    unsigned int low, high;
+    __asm__ __volatile__("rdtsc" : "=a"(low), "=d"(high));
+    return ((unsigned long long)high << 32) | low;
+}
+
+/*
+ * Time CTX_SWITCH_ITERATIONS yield() calls and return the cycles per
+ * switch, or -1 if a call failed. With a ready flag, first wait until
+ * the partner thread is about to start its own loop too.
+ */
+static int ctx_timed_loop(volatile int *mine, volatile int *partner) {
+    if (mine) {
+        *mine = 1;
+        while (!*partner) yield();
+    }
+
+    int errors = 0;
+    unsigned long long start = read_tsc();
+    for (int i = 0; i < CTX_SWITCH_ITERATIONS; i++) {
+        if (yield() < 0) errors++;
+    }
+    unsigned long long cycles = read_tsc() - start;
+    if (errors) return -1;
+
+    /* Both sides yield in turn: the loop spans twice as many switches */
+    unsigned int total = (cycles >> 32) ? 0xffffffff : (unsigned int)cycles;
+    return (int)(total / (2 * CTX_SWITCH_ITERATIONS));
+}
+
+static void ctx_yield_thread_func(void *arg) {
+    (void)arg;
+    ctx_partner_cost = ctx_timed_loop(&ctx_ready[1], &ctx_ready[0]);
+    ctx_partner_done = 1;
+    ThreadExit();
+}
+
+static void ctx_print_cost(char *label, int own, int partner) {
+    /* The side whose loop overlapped its partner's start or exit less is closest */
+    prints("  - %s: %d and %d cycles/switch measured by each side, %d reported\n", label, own,
+           partner, own < partner ? own : partner);
+}
+
+int test_context_switch_performance(void) {
+    print_test_header("CONTEXT SWITCH PERFORMANCE TEST");
+
+    int passed = 1;
+
+    /* Same process: coordinator and one sibling thread */
+    int same_cost = -1;
+    ctx_partner_done = 0;
+    ctx_partner_cost = -1;
+    ctx_ready[0] = ctx_ready[1] = 0;
+    if (ThreadCreate(ctx_yield_thread_func, (void *)0) < 0) {
+        prints("[PID %d] [TID %d] ERROR: Failed to create thread\n", getpid(), gettid());
+        passed = 0;
+    } else {
+        same_cost = ctx_timed_loop(&ctx_ready[0], &ctx_ready[1]);
+        while (!ctx_partner_done) yield();
+        if (same_cost < 0 || ctx_partner_cost < 0) passed = 0;
+    }
+
+    /* Cross process: parent and a forked child, which reports its cost as exit code */
+    int cross_cost = -1;
+    int child_cost = -1;
+    int pid = fork();
+    if (pid == 0) {
+        exit(ctx_timed_loop((volatile int *)0, (volatile int *)0));
+    }
+    if (pid < 0) {
+        prints("[PID %d] [TID %d] ERROR: fork failed\n", getpid(), gettid());
+        passed = 0;
+    } else {
+        cross_cost = ctx_timed_loop((volatile int *)0, (volatile int *)0);
+        if (waitpid(pid, &child_cost, 0) != pid) passed = 0;
+        if (cross_cost < 0 || child_cost < 0) passed = 0;
+    }
+
+    if (passed) {
+        prints("[PID %d] [TID %d] %d yield() rounds per side:\n", getpid(), gettid(),
+               CTX_SWITCH_ITERATIONS);
+        ctx_print_cost("Same process ", same_cost, ctx_partner_cost);
+        ctx_print_cost("Cross process", cross_cost, child_cost);
+    }
+
+    prints("\n========================================\n");
+    prints("CONTEXT SWITCH PERFORMANCE TEST: %d/1 subtests passed\n", passed ? 1 : 0);
+    prints("========================================\n");
+
+    print_test_result("CONTEXT SWITCH PERFORMANCE TEST", passed);
+    ctx_switch_perf_passed = passed;
+
+    /* Track in global summary */
+    project_tests_run++;
+    if (passed) project_tests_passed++;
+
+    return passed;
+}
+
+/****************************************/
+/**    Syscall Preemption Latency      **/
+/****************************************/
+
+static void preempt_fill_buffer(void) {
+    for (int i = 0; i < PREEMPT_WRITE_SIZE; i++) {
+        preempt_write_buffer[i] = ((i + 1) % 64 == 0) ? '\n' : '.';
+    }
+}
+
+static void preempt_writer_func(void *arg) {
+    (void)arg;
+    for (int i = 0; i < PREEMPT_WRITES; i++) {
+        write(2, preempt_write_buffer, PREEMPT_WRITE_SIZE);
+    }
+    preempt_writer_done = 1;
+    ThreadExit();
+}
+
+int test_preempt_latency(void) {
+    print_test_header("SYSCALL PREEMPTION LATENCY TEST");
+
+    int passed = 1;
+    struct irqsoff_stats st;
+
+    preempt_fill_buffer();
+    preempt_writer_done = 0;
+    irqsoff_read(&st, 1);
+    if (ThreadCreate(preempt_writer_func, (void *)0) < 0) {
+        prints("[PID %d] [TID %d] ERROR: Failed to create writer thread\n", getpid(), gettid());
+        passed = 0;
+    } else {
+        unsigned int max_gap = 0;
+        int max_gap_ticks = 0;
+        unsigned int last = read_tsc_low();
+        int last_tick = gettime();
+
+        /* Spin: any long gap between two iterations is time we were kept off the CPU */
+        while (!preempt_writer_done) {
+            unsigned int now = read_tsc_low();
+            int tick = gettime();
+            if (now - last > max_gap) {
+                max_gap = now - last;
+                max_gap_ticks = tick - last_tick;
+            }
+            last = now;
+            last_tick = tick;
+        }
+        int ret = irqsoff_read(&st, 0);
+
+        /* PIT_INPUT_HZ / 1000 PIT clocks per millisecond */
+        unsigned int max_clocks = PREEMPT_MAX_LATENCY_US * (PIT_INPUT_HZ / 1000) / 1000;
+
+        prints("[PID %d] [TID %d] %d writes of %d bytes to the debug console:\n", getpid(),
+               gettid(), PREEMPT_WRITES, PREEMPT_WRITE_SIZE);
+        prints("  - Longest time off CPU: %u cycles (%d ticks, expected <= %d)\n", max_gap,
+               max_gap_ticks, PREEMPT_MAX_GAP_TICKS);
+        prints("  - Worst clock interrupt latency: %u PIT clocks over %u interrupts "
+               "(expected <= %u)\n",
+               st.irq_latency_max, st.irq_samples, max_clocks);
+
+        passed = (ret == 0 && st.irq_samples > 0 && st.irq_latency_max <= max_clocks &&
+                  max_gap_ticks <= PREEMPT_MAX_GAP_TICKS);
+    }
+
+    prints("\n========================================\n");
+    prints("SYSCALL PREEMPTION LATENCY TEST: %d/1 subtests passed\n", passed ? 1 : 0);
+    prints("========================================\n");
+
+    print_test_result("SYSCALL PREEMPTION LATENCY TEST", passed);
+
+    /* Track in global summary */
+    preempt_latency_passed = passed;
+    project_tests_run++;
+    if (passed) project_tests_passed++;
+
+    return passed;
+}
+
+/****************************************/
+/**    Shared Time/ID Page             **/
+/****************************************/
+
+static void vdso_thread_func(void *arg) {
+    (void)arg;
+    vdso_thread_ok = (fast_gettid() == gettid() && fast_getpid() == getpid());
+    vdso_thread_done = 1;
+    ThreadExit();
+}
+
+static void subtest_vdso_values(int *passed) {
+    print_subtest_header(1, "Shared page values match the syscalls");
+
+    int before = gettime();
+    int fast = fast_gettime();
+    int after = gettime();
+    int subtick = 0;
+    fast_gettime_precise(&subtick);
+
+    prints("[PID %d] [TID %d] fast_getpid=%d fast_gettid=%d\n", getpid(), gettid(),
+           fast_getpid(), fast_gettid());
+    prints("[PID %d] [TID %d] gettime %d <= fast_gettime %d <= gettime %d (sub-tick %d/1000)\n",
+           getpid(), gettid(), before, fast, after, subtick);
+
+    *passed = (fast_getpid() == getpid() && fast_gettid() == gettid() && before <= fast &&
+               fast <= after && subtick >= 0 && subtick < 1000);
+
+    vdso_thread_ok = 0;
+    vdso_thread_done = 0;
+    if (ThreadCreate(vdso_thread_func, (void *)0) < 0) {
+        *passed = 0;
+    } else {
+        while (!vdso_thread_done) {
+        }
+        prints("[PID %d] [TID %d] Second thread reads its own IDs: %s\n", getpid(), gettid(),
+               vdso_thread_ok ? "yes" : "NO");
+        if (!vdso_thread_ok) *passed = 0;
+    }
+
+    print_subtest_result(*passed);
+}
+
+static void subtest_vdso_benchmark(int *passed) {
+    print_subtest_header(2, "Syscall vs shared page read cost");
+
+    volatile int sink = 0;
+    unsigned int start, sys_time, fast_time, sys_tid, fast_tid;
+
+    start = read_tsc_low();
+    for (int i = 0; i < VDSO_BENCH_ITERATIONS; i++) sink += gettime();
+    sys_time = (read_tsc_low() - start) / VDSO_BENCH_ITERATIONS;
+
+    start = read_tsc_low();
+    for (int i = 0; i < VDSO_BENCH_ITERATIONS; i++) sink += fast_gettime();
+    fast_time = (read_tsc_low() - start) / VDSO_BENCH_ITERATIONS;
+
+    start = read_tsc_low();
+    for (int i = 0; i < VDSO_BENCH_ITERATIONS; i++) sink += gettid();
+    sys_tid = (read_tsc_low() - start) / VDSO_BENCH_ITERATIONS;
+
+    start = read_tsc_low();
+    for (int i = 0; i < VDSO_BENCH_ITERATIONS; i++) sink += fast_gettid();
+    fast_tid = (read_tsc_low() - start) / VDSO_BENCH_ITERATIONS;
+
+    prints("[PID %d] [TID %d] Cycles per call (%d calls each):\n", getpid(), gettid(),
+           VDSO_BENCH_ITERATIONS);
+    prints("  - gettime(): %u   fast_gettime(): %u\n", sys_time, fast_time);
+    prints("  - gettid():  %u   fast_gettid():  %u\n", sys_tid, fast_tid);
+
+    *passed = (fast_time < sys_time && fast_tid < sys_tid);
+    print_subtest_result(*passed);
+}
+
+int test_vdso(void) {
+    print_test_header("SHARED TIME/ID PAGE TESTS");
+
+    int passed = 0;
+    int result;
+
+    subtest_vdso_values(&result);
+    passed += result;
+
+    subtest_vdso_benchmark(&result);
+    passed += result;
+
+    prints("\n========================================\n");
+    prints("SHARED TIME/ID PAGE TESTS: %d/2 subtests passed\n", passed);
+    prints("========================================\n");
+
+    int all_passed = (passed == 2);
+    print_test_result("SHARED TIME/ID PAGE TESTS", all_passed);
+
+    /* Track in global summary */
+    vdso_passed = all_passed;
+    project_tests_run++;
+    if (all_passed) project_tests_passed++;
+
+    return all_passed;
+}
+
+/****************************************/
+/**    Submission/Completion Rings     **/
+/****************************************/
+
+static void subtest_uring_errors(int *passed) {
+    print_subtest_header(1, "ring_setup/ring_enter error cases");
+
+    RESET_ERRNO();
+    int ret = ring_enter(1);
+    prints("[PID %d] [TID %d] ring_enter without ring: ret=%d errno=%d (expected -1, ENXIO)\n",
+           getpid(), gettid(), ret, errno);
+    *passed = (ret == -1 && errno == ENXIO);
+
+    RESET_ERRNO();
+    ret = ring_setup((struct uring *)0x100);
+    prints("[PID %d] [TID %d] ring_setup(kernel address): ret=%d errno=%d (expected -1, EFAULT)\n",
+           getpid(), gettid(), ret, errno);
+    if (ret != -1 || errno != EFAULT) *passed = 0;
+
+    print_subtest_result(*passed);
+}
+
+static void uring_prep(int opcode, int fd, char *buf, int len, unsigned int user_data) {
+    struct uring_sqe *sqe = uring_get_sqe(&test_ring);
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->buf = buf;
+    sqe->len = len;
+    sqe->user_data = user_data;
+}
+
+static void subtest_uring_batch(int *passed) {
+    print_subtest_header(2, "One ring_enter runs a mixed batch");
+
+    static char msg[] = "[uring] batched debug write\n";
+    int msg_len = sizeof(msg) - 1;
+    *passed = 1;
+
+    if (ring_setup(&test_ring) < 0) {
+        prints("[PID %d] [TID %d] ring_setup failed\n", getpid(), gettid());
+        *passed = 0;
+        print_subtest_result(*passed);
+        return;
+    }
+
+    int start = gettime();
+    uring_prep(URING_OP_NOP, 0, (void *)0, 0, 1);
+    uring_prep(URING_OP_GETTIME, 0, (void *)0, 0, 2);
+    uring_prep(URING_OP_WRITE, 2, msg, msg_len, 3);
+    uring_prep(URING_OP_SLEEP, 0, (void *)0, URING_SLEEP_TICKS, 4);
+    uring_prep(URING_OP_GETTIME, 0, (void *)0, 0, 5);
+    uring_prep(99, 0, (void *)0, 0, 6);
+
+    int ret = uring_submit(&test_ring);
+    prints("[PID %d] [TID %d] ring_enter consumed %d of 6 submissions\n", getpid(), gettid(), ret);
+    if (ret != 6) *passed = 0;
+
+    /* Reap without system calls */
+    int res[7] = {0};
+    int seen = 0;
+    struct uring_cqe *cqe;
+    while ((cqe = uring_peek_cqe(&test_ring)) != (void *)0) {
+        if (seen < 6 && cqe->user_data == (unsigned int)(seen + 1)) {
+            res[seen + 1] = cqe->res;
+        } else {
+            *passed = 0;
+        }
+        seen++;
+        uring_cqe_seen(&test_ring);
+    }
+
+    prints("[PID %d] [TID %d] Completions: nop=%d gettime=%d write=%d sleep=%d gettime=%d "
+           "bad=%d\n",
+           getpid(), gettid(), res[1], res[2], res[3], res[4], res[5], res[6]);
+
+    if (seen != 6 || res[1] != 0 || res[2] < start || res[3] != msg_len || res[4] != 0 ||
+        res[5] - res[2] < URING_SLEEP_TICKS || res[6] != -EINVAL) {
+        *passed = 0;
+    }
+
+    print_subtest_result(*passed);
+}
+
+static void subtest_uring_benchmark(int *passed) {
+    print_subtest_header(3, "Syscalls per frame: separate vs batched");
+
+    static char empty[1];
+    volatile int sink = 0;
+    unsigned int start, direct_cycles, ring_cycles;
+
+    start = read_tsc_low();
+    for (int i = 0; i < URING_BENCH_FRAMES; i++) {
+        sink += gettime();
+        sink += write(2, empty, 0);
+        sink += gettime();
+    }
+    direct_cycles = (read_tsc_low() - start) / URING_BENCH_FRAMES;
+
+    int batched = 0;
+    start = read_tsc_low();
+    for (int i = 0; i < URING_BENCH_FRAMES; i++) {
+        uring_prep(URING_OP_GETTIME, 0, (void *)0, 0, 0);
+        uring_prep(URING_OP_WRITE, 2, empty, 0, 1);
+        uring_prep(URING_OP_GETTIME, 0, (void *)0, 0, 2);
+        batched += uring_submit(&test_ring);
+
+        struct uring_cqe *cqe;
+        while ((cqe = uring_peek_cqe(&test_ring)) != (void *)0) {
+            sink += cqe->res;
+            uring_cqe_seen(&test_ring);
+        }
+    }
+    ring_cycles = (read_tsc_low() - start) / URING_BENCH_FRAMES;
+
+    prints("[PID %d] [TID %d] %d frames of gettime + debug write + gettime:\n", getpid(),
+           gettid(), URING_BENCH_FRAMES);
+    prints("  - Separate syscalls: 3 transitions, %u cycles per frame\n", direct_cycles);
+    prints("  - ring_enter:        1 transition,  %u cycles per frame\n", ring_cycles);
+
+    *passed = (batched == 3 * URING_BENCH_FRAMES);
+    print_subtest_result(*passed);
+
+    ring_setup((void *)0);
+}
+
+int test_uring(void) {
+    print_test_header("SUBMISSION/COMPLETION RING TESTS");
+
+    int passed = 0;
+    int result;
+
+    subtest_uring_errors(&result);
+    passed += result;
+
+    subtest_uring_batch(&result);
+    passed += result;
+
+    subtest_uring_benchmark(&result);
+    passed += result;
+
+    prints("\n========================================\n");
+    prints("SUBMISSION/COMPLETION RING TESTS: %d/3 subtests passed\n", passed);
+    prints("========================================\n");
+
+    int all_passed = (passed == 3);
+    print_test_result("SUBMISSION/COMPLETION RING TESTS", all_passed);
+
+    /* Track in global summary */
+    uring_passed = all_passed;
+    project_tests_run++;
+    if (all_passed) project_tests_passed++;
+
+    return all_passed;
+}
+
+/****************************************/
+/**    Syscall Statistics Tests        **/
+/****************************************/
+
+static void subtest_syscall_stats_count(int *passed) {
+    print_subtest_header(1, "gettid() calls are counted and timed");
+
+    struct syscall_stats before, after, proc_before, proc_after;
+    int pid = getpid();
+    *passed = 1;
+
+    /* This process has already made calls, so both queries succeed */
+    get_syscall_stats(SYSCALL_STATS_NR, 0, &before);
+    get_syscall_stats(SYSCALL_STATS_NR, pid, &proc_before);
+
+    for (int i = 0; i < SYSCALL_STATS_CALLS; i++) {
+        gettid();
+    }
+
+    if (get_syscall_stats(SYSCALL_STATS_NR, 0, &after) < 0 ||
+        get_syscall_stats(SYSCALL_STATS_NR, pid, &proc_after) < 0) {
+        prints("[PID %d] [TID %d] get_syscall_stats failed: errno=%d\n", pid, gettid(), errno);
+        *passed = 0;
+        print_subtest_result(*passed);
+        return;
+    }
+
+    /* gettid never blocks: every counted call has landed in the histogram */
+    unsigned int hist_total = 0;
+    for (int b = 0; b < SYSCALL_HIST_BUCKETS; b++) {
+        hist_total += after.hist[b];
+    }
+
+    unsigned int calls = after.calls - before.calls;
+    unsigned int proc_calls = proc_after.calls - proc_before.calls;
+    prints("[PID %d] [TID %d] gettid: +%u calls system-wide, +%u for this process "
+           "(expected %d), max %u cycles\n",
+           pid, gettid(), calls, proc_calls, SYSCALL_STATS_CALLS, after.max_cycles);
+    prints("[PID %d] [TID %d] Histogram holds %u of %u calls\n", pid, gettid(), hist_total,
+           after.calls);
+
+    if (calls < SYSCALL_STATS_CALLS || proc_calls != SYSCALL_STATS_CALLS ||
+        after.cycles <= before.cycles || after.max_cycles == 0 || hist_total != after.calls) {
+        *passed = 0;
+    }
+
+    print_subtest_result(*passed);
+}
+
+static void subtest_syscall_stats_errors(int *passed) {
+    print_subtest_header(2, "get_syscall_stats error cases");
+
+    struct syscall_stats st;
+    *passed = 1;
+
+    RESET_ERRNO();
+    int ret = get_syscall_stats(NR_SYSCALLS, 0, &st);
+    prints("[PID %d] [TID %d] nr=NR_SYSCALLS: ret=%d errno=%d (expected -1, EINVAL)\n", getpid(),
+           gettid(), ret, errno);
+    if (ret != -1 || errno != EINVAL) *passed = 0;
+
+    RESET_ERRNO();
+    ret = get_syscall_stats(SYSCALL_STATS_NR, 30000, &st);
+    prints("[PID %d] [TID %d] unknown pid: ret=%d errno=%d (expected -1, ESRCH)\n", getpid(),
+           gettid(), ret, errno);
+    if (ret != -1 || errno != ESRCH) *passed = 0;
+
+    RESET_ERRNO();
+    ret = get_syscall_stats(SYSCALL_STATS_NR, 0, (struct syscall_stats *)0x100);
+    prints("[PID %d] [TID %d] kernel address: ret=%d errno=%d (expected -1, EFAULT)\n", getpid(),
+           gettid(), ret, errno);
+    if (ret != -1 || errno != EFAULT) *passed = 0;
+
+    print_subtest_result(*passed);
+
+    prints("\nSystem calls of PID %d:\n", getpid());
+    dump_syscall_stats(getpid());
+}
+
+int test_syscall_stats(void) {
+    print_test_header("SYSCALL STATISTICS TESTS");
+
+    int passed = 0;
+    int result;
+
+    subtest_syscall_stats_count(&result);
+    passed += result;
+
+    subtest_syscall_stats_errors(&result);
+    passed += result;
+
+    prints("\n========================================\n");
+    prints("SYSCALL STATISTICS TESTS: %d/2 subtests passed\n", passed);
+    prints("========================================\n");
+
+    int all_passed = (passed == 2);
+    print_test_result("SYSCALL STATISTICS TESTS", all_passed);
+
+    /* Track in global summary */
+    syscall_stats_passed = all_passed;
+    project_tests_run++;
+    if (all_passed) project_tests_passed++;
+
+    return all_passed;
+}
+
+/****************************************/
+/**    Sampling Profiler Tests         **/
+/****************************************/
+
+static void subtest_profiler_errors(int *passed) {
+    print_subtest_header(1, "prof_start/prof_read error cases");
+
+    RESET_ERRNO();
+    int ret = prof_start(0);
+    prints("[PID %d] [TID %d] prof_start(0): ret=%d errno=%d (expected -1, EINVAL)\n", getpid(),
+           gettid(), ret, errno);
+    *passed = (ret == -1 && errno == EINVAL);
+
+    RESET_ERRNO();
+    ret = prof_read(prof_test_samples, -1);
+    prints("[PID %d] [TID %d] prof_read(n=-1): ret=%d errno=%d (expected -1, EINVAL)\n", getpid(),
+           gettid(), ret, errno);
+    if (ret != -1 || errno != EINVAL) *passed = 0;
+
+    RESET_ERRNO();
+    ret = prof_read((struct prof_sample *)0x100, 1);
+    prints("[PID %d] [TID %d] prof_read(kernel address): ret=%d errno=%d (expected -1, EFAULT)\n",
+           getpid(), gettid(), ret, errno);
+    if (ret != -1 || errno != EFAULT) *passed = 0;
+
+    print_subtest_result(*passed);
+}
+
+/* Hot spot the profiler should find */
+static void __attribute__((noinline)) prof_test_spin(int ticks) {
+    int end = fast_gettime() + ticks;
+    while (fast_gettime() < end) {
+    }
+}
+
+static void subtest_profiler_samples(int *passed) {
+    print_subtest_header(2, "Samples land in a busy user function");
+
+    int pid = getpid();
+    *passed = 1;
+
+    prof_start(1);
+    prof_test_spin(PROF_TEST_TICKS);
+    int dropped = prof_stop();
+
+    /* prof_test_spin is small: its own samples fall just after its entry */
+    unsigned int spin = (unsigned int)prof_test_spin;
+    int n = 0, mine = 0, in_spin = 0, kernel = 0;
+    int got;
+    while ((got = prof_read(prof_test_samples, PROF_TEST_CHUNK)) > 0) {
+        for (int i = 0; i < got; i++) {
+            struct prof_sample *s = &prof_test_samples[i];
+            if (s->flags & PROF_SAMPLE_KERNEL) kernel++;
+            if (s->pid != pid) continue;
+            mine++;
+            if (!(s->flags & PROF_SAMPLE_KERNEL) && s->eip >= spin && s->eip < spin + 256)
+                in_spin++;
+        }
+        n += got;
+    }
+
+    prints("[PID %d] [TID %d] %d samples over %d ticks (%d dropped): %d of this process, "
+           "%d in prof_test_spin, %d in the kernel\n",
+           pid, gettid(), n, PROF_TEST_TICKS, dropped, mine, in_spin, kernel);
+
+    if (n < PROF_TEST_TICKS / 2 || dropped != 0 || in_spin < mine / 2) *passed = 0;
+
+    /* A short run dumped to the debug port, for the host tool */
+    prof_start(1);
+    prof_test_spin(PROF_TEST_TICKS / 4);
+    prof_stop();
+    int dumped = prof_dump();
+    prints("[PID %d] [TID %d] prof_dump printed %d samples to the debug port\n", pid, gettid(),
+           dumped);
+    if (dumped <= 0) *passed = 0;
+
+    print_subtest_result(*passed);
+}
+
+int test_profiler(void) {
+    print_test_header("SAMPLING PROFILER TESTS");
+
+    int passed = 0;
+    int result;
+
+    subtest_profiler_errors(&result);
+    passed += result;
+
+    subtest_profiler_samples(&result);
+    passed += result;
+
+    prints("\n========================================\n");
+    prints("SAMPLING PROFILER TESTS: %d/2 subtests passed\n", passed);
+    prints("========================================\n");
+
+    int all_passed = (passed == 2);
+    print_test_result("SAMPLING PROFILER TESTS", all_passed);
+
+    /* Track in global summary */
+    profiler_passed = all_passed;
+    project_tests_run++;
+    if (all_passed) project_tests_passed++;
+
+    return all_passed;
+}
+
+/****************************************/
+/**    Event Tracing Tests             **/
+/****************************************/
+
+/* Discard records left in the kernel ring */
+static void trace_drain(void) {
+    while (trace_read(trace_test_records, TRACE_TEST_CHUNK) > 0) {
+    }
+}
+
+static void subtest_trace_errors(int *passed) {
+    print_subtest_header(1, "trace_ctl/trace_read error cases");
+
+    RESET_ERRNO();
+    int ret = trace_ctl(TRACE_CAT_ALL + 1);
+    prints("[PID %d] [TID %d] trace_ctl(unknown category): ret=%d errno=%d (expected -1, "
+           "EINVAL)\n",
+           getpid(), gettid(), ret, errno);
+    *passed = (ret == -1 && errno == EINVAL);
+
+    RESET_ERRNO();
+    ret = trace_read((struct trace_record *)0x100, 1);
+    prints("[PID %d] [TID %d] trace_read(kernel address): ret=%d errno=%d (expected -1, "
+           "EFAULT)\n",
+           getpid(), gettid(), ret, errno);
+    if (ret != -1 || errno != EFAULT) *passed = 0;
+
+    print_subtest_result(*passed);
+}
+
+static void subtest_trace_syscalls(int *passed) {
+    print_subtest_header(2, "Syscall entry/exit records in order");
+
+    int tid = gettid();
+    *passed = 1;
+
+    trace_drain();
+    trace_ctl(TRACE_CAT_SYSCALL);
+    for (int i = 0; i < TRACE_TEST_CALLS; i++) {
+        gettid();
+    }
+    int old = trace_ctl(0);
+
+    /* Each gettid must appear as an entry followed by an exit returning the TID */
+    int entries = 0, pairs = 0, ordered = 1, total = 0, got;
+    unsigned long long last = 0;
+    while ((got = trace_read(trace_test_records, TRACE_TEST_CHUNK)) > 0) {
+        for (int i = 0; i < got; i++) {
+            struct trace_record *r = &trace_test_records[i];
+            if (r->tsc < last) ordered = 0;
+            last = r->tsc;
+            if (r->tid != tid || r->args[0] != SYSCALL_STATS_NR) continue;
+            if (r->event == TRACE_SYSCALL_ENTRY) entries++;
+            if (r->event == TRACE_SYSCALL_EXIT && entries > pairs && (int)r->args[1] == tid) pairs++;
+        }
+        total += got;
+    }
+
+    prints("[PID %d] [TID %d] %d records, %d gettid entry/exit pairs (expected %d), "
+           "timestamps %s, previous mask %d\n",
+           getpid(), tid, total, pairs, TRACE_TEST_CALLS, ordered ? "ordered" : "NOT ORDERED",
+           old);
+
+    if (pairs != TRACE_TEST_CALLS || entries != TRACE_TEST_CALLS || !ordered ||
+        old != TRACE_CAT_SYSCALL) {
+        *passed = 0;
+    }
+
+    print_subtest_result(*passed);
+}
+
+static void trace_thread_func(void *arg) {
+    (void)arg;
+    trace_thread_done = 1;
+    ThreadExit();
+}
+
+static void subtest_trace_sched(int *passed) {
+    print_subtest_header(3, "Thread creation, switches and a dump");
+
+    *passed = 1;
+    trace_thread_done = 0;
+
+    trace_drain();
+    trace_ctl(TRACE_CAT_SCHED | TRACE_CAT_PROC);
+    int new_tid = ThreadCreate(trace_thread_func, (void *)0);
+    while (!trace_thread_done) {
+        yield();
+    }
+    waitTicksYield(2);
+    trace_ctl(0);
+
+    int created = 0, switched_to = 0, exited = 0, got;
+    while ((got = trace_read(trace_test_records, TRACE_TEST_CHUNK)) > 0) {
+        for (int i = 0; i < got; i++) {
+            struct trace_record *r = &trace_test_records[i];
+            if (r->event == TRACE_THREAD_CREATE && (int)r->args[0] == new_tid) created = 1;
+            if (r->event == TRACE_SWITCH && (int)r->args[1] == new_tid) switched_to = 1;
+            if (r->event == TRACE_THREAD_EXIT && r->tid == new_tid) exited = 1;
+        }
+    }
+
+    prints("[PID %d] [TID %d] TID %d: create %s, switched to %s, exit %s\n", getpid(), gettid(),
+           new_tid, created ? "traced" : "MISSING", switched_to ? "traced" : "MISSING",
+           exited ? "traced" : "MISSING");
+    if (new_tid < 0 || !created || !switched_to || !exited) *passed = 0;
+
+    /* A few ticks of every category, dumped to the debug port for trace2json */
+    trace_ctl(TRACE_CAT_ALL);
+    waitTicksYield(TRACE_TEST_DUMP_TICKS);
+    trace_ctl(0);
+    int dumped = trace_dump();
+    prints("[PID %d] [TID %d] trace_dump printed %d records to the debug port\n", getpid(),
+           gettid(), dumped);
+    if (dumped <= 0) *passed = 0;
+
+    print_subtest_result(*passed);
+}
+
+int test_trace(void) {
+    print_test_header("EVENT TRACING TESTS");
+
+    int passed = 0;
+    int result;
+
+    subtest_trace_errors(&result);
+    passed += result;
+
+    subtest_trace_syscalls(&result);
+    passed += result;
+
+    subtest_trace_sched(&result);
+    passed += result;
+
+    prints("\n========================================\n");
+    prints("EVENT TRACING TESTS: %d/3 subtests passed\n", passed);
+    prints("========================================\n");
+
+    int all_passed = (passed == 3);
+    print_test_result("EVENT TRACING TESTS", all_passed);
+
+    /* Track in global summary */
+    trace_passed = all_passed;
+    project_tests_run++;
+    if (all_passed) project_tests_passed++;
+
+    return all_passed;
+}
+
+/****************************************/
+/**    Interrupts-Off Tracer Tests     **/
+/****************************************/
+
+/* Print the clock latency distribution and the longest interrupts-off window */
+static void irqsoff_report(const struct irqsoff_stats *st) {
+    /* One PIT clock is 1000000/PIT_INPUT_HZ us, about 0.838 */
+    prints("  - Clock interrupts: %u, worst latency %u PIT clocks (%u us)\n", st->irq_samples,
+           st->irq_latency_max, st->irq_latency_max * 1000 / (PIT_INPUT_HZ / 1000));
+    for (int b = 0; b < IRQ_LATENCY_BUCKETS; b++) {
+        if (st->irq_latency_hist[b] == 0) continue;
+        prints("      %u-%u clocks: %u\n", b ? 1u << b : 0, (1u << (b + 1)) - 1,
+               st->irq_latency_hist[b]);
+    }
+
+    prints("  - Interrupts-off windows: %u, longest %u cycles in PID %d, opened by ",
+           st->windows, st->max_cycles, st->max_pid);
+    if (st->max_tag >= IRQSOFF_TAG_SYSCALL) {
+        prints("syscall %d", st->max_tag - IRQSOFF_TAG_SYSCALL);
+    } else if (st->max_tag == IRQSOFF_TAG_KERNEL) {
+        prints("kernel cli");
+    } else {
+        prints("vector %d", st->max_tag);
+    }
+    prints(" (0x%x -> 0x%x)\n", st->max_start_site, st->max_end_site);
+}
+
+static void subtest_irqsoff_errors(int *passed) {
+    print_subtest_header(1, "irqsoff_read error cases");
+
+    RESET_ERRNO();
+    int ret = irqsoff_read((struct irqsoff_stats *)0x100, 0);
+    prints("[PID %d] [TID %d] irqsoff_read(kernel address): ret=%d errno=%d (expected -1, "
+           "EFAULT)\n",
+           getpid(), gettid(), ret, errno);
+    *passed = (ret == -1 && errno == EFAULT);
+
+    print_subtest_result(*passed);
+}
+
+static void subtest_irqsoff_idle(int *passed) {
+    print_subtest_header(2, "Clock latency with an idle system");
+
+    struct irqsoff_stats st;
+    irqsoff_read(&st, 1);
+    waitTicksYield(IRQSOFF_TEST_TICKS);
+    int ret = irqsoff_read(&st, 0);
+
+    prints("[PID %d] [TID %d] %d ticks of yield():\n", getpid(), gettid(), IRQSOFF_TEST_TICKS);
+    irqsoff_report(&st);
+
+    *passed = (ret == 0 && st.irq_samples >= IRQSOFF_TEST_TICKS && st.windows > 0 &&
+               st.max_cycles > 0 && st.max_start_site != 0 && st.max_end_site != 0);
+
+    print_subtest_result(*passed);
+}
+
+static void subtest_irqsoff_load(int *passed) {
+    print_subtest_header(3, "Clock latency under console writes");
+
+    struct irqsoff_stats st;
+    preempt_fill_buffer();
+    preempt_writer_done = 0;
+    irqsoff_read(&st, 1);
+
+    if (ThreadCreate(preempt_writer_func, (void *)0) < 0) {
+        prints("[PID %d] [TID %d] ERROR: Failed to create writer thread\n", getpid(), gettid());
+        *passed = 0;
+        print_subtest_result(*passed);
+        return;
+    }
+    while (!preempt_writer_done) {
+        yield();
+    }
+    int ret = irqsoff_read(&st, 0);
+
+    prints("[PID %d] [TID %d] %d writes of %d bytes to the debug console:\n", getpid(), gettid(),
+           PREEMPT_WRITES, PREEMPT_WRITE_SIZE);
+    irqsoff_report(&st);
+
+    *passed = (ret == 0 && st.irq_samples > 0 && st.max_cycles > 0);
+
+    print_subtest_result(*passed);
+}
+
+int test_irqsoff(void) {
+    print_test_header("INTERRUPTS-OFF TRACER TESTS");
+
+    int passed = 0;
+    int result;
+
+    subtest_irqsoff_errors(&result);
+    passed += result;
+
+    subtest_irqsoff_idle(&result);
+    passed += result;
+
+    subtest_irqsoff_load(&result);
+    passed += result;
+
+    prints("\n========================================\n");
+    prints("INTERRUPTS-OFF TRACER TESTS: %d/3 subtests passed\n", passed);
+    prints("========================================\n");
+
+    int all_passed = (passed == 3);
+    print_test_result("INTERRUPTS-OFF TRACER TESTS", all_passed);
+
+    /* Track in global summary */
+    irqsoff_passed = all_passed;
+    project_tests_run++;
+    if (all_passed) project_tests_passed++;
+
+    return all_passed;
+}
+
+/****************************************/
+/**    Tick Calibration Test Functions **/
+/****************************************/
+
+/* Deviation of measured from expected, in tenths of a percent */
+static int deviation_permille(unsigned int measured, unsigned int expected) {
+    unsigned int diff = (measured > expected) ? measured - expected : expected - measured;
+    return (expected >= 10) ? (int)(diff * 100 / (expected / 10)) : 1000;
+}
+
+void tick_calibration_test(void) {
+    print_test_header("TICK CALIBRATION TEST");
+
+    struct timespec t0, t1;
+    int passed = 1;
+
+    RESET_ERRNO();
+    int ret = clock_gettime(CLOCK_MONOTONIC + 1, &t0);
+    prints("[PID %d] [TID %d] clock_gettime(unknown clock): ret=%d errno=%d (expected -1, "
+           "EINVAL)\n",
+           getpid(), gettid(), ret, errno);
+    if (ret != -1 || errno != EINVAL) passed = 0;
+
+    RESET_ERRNO();
+    ret = clock_gettime(CLOCK_MONOTONIC, (struct timespec *)0x100);
+    prints("[PID %d] [TID %d] clock_gettime(kernel address): ret=%d errno=%d (expected -1, "
+           "EFAULT)\n",
+           getpid(), gettid(), ret, errno);
+    if (ret != -1 || errno != EFAULT) passed = 0;
+
+    /* The shared time page is read-only for the kernel too */
+    RESET_ERRNO();
+    ret = clock_gettime(CLOCK_MONOTONIC, (struct timespec *)(VDSO_PAGE << 12));
+    prints("[PID %d] [TID %d] clock_gettime(vDSO page): ret=%d errno=%d (expected -1, EFAULT)\n",
+           getpid(), gettid(), ret, errno);
+    if (ret != -1 || errno != EFAULT) passed = 0;
+
+    /* Start right after a tick so the interval holds whole ticks */
+    busyWait(1);
+    int start_ticks = gettime();
+    unsigned long long start_tsc = read_tsc();
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    busyWait(TIME_CALIBRATION_TICKS);
+
+    int elapsed_ticks = gettime() - start_ticks;
+    unsigned long long cycles = read_tsc() - start_tsc;
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    /* The TSC must run at the calibrated rate against the clock interrupt */
+    unsigned int elapsed_ms = (unsigned int)elapsed_ticks * 1000 / TICKS_PER_SECOND;
+    unsigned int measured_khz = elapsed_ms ? (unsigned int)(cycles >> 8) / elapsed_ms * 256 : 0;
+    int tsc_dev = deviation_permille(measured_khz, get_tsc_khz());
+
+    prints("[PID %d] [TID %d] %d ticks at %d ticks/s (%u ms)\n", getpid(), gettid(),
+           elapsed_ticks, TICKS_PER_SECOND, elapsed_ms);
+    prints("  - TSC: calibrated %u kHz, measured %u kHz, deviation %d.%d%%\n", get_tsc_khz(),
+           measured_khz, tsc_dev / 10, tsc_dev % 10);
+    if (tsc_dev > 50) passed = 0; /* 5% tolerance */
+
+    /* clock_gettime must advance like the tick counter, within one tick */
+    unsigned int clock_us = (t1.tv_sec - t0.tv_sec) * 1000000 + (t1.tv_nsec - t0.tv_nsec) / 1000;
+    unsigned int ticks_us = (unsigned int)elapsed_ticks * (1000000 / TICKS_PER_SECOND);
+    unsigned int tick_us = 1000000 / TICKS_PER_SECOND;
+    prints("  - clock_gettime: %u us elapsed (ticks give %u us, one tick is %u us)\n", clock_us,
+           ticks_us, tick_us);
+    if (clock_us + tick_us < ticks_us || clock_us > ticks_us + 2 * tick_us) passed = 0;
+
+    /* Consecutive reads never go back */
+    int monotonic = 1;
+    t0 = t1;
+    for (int i = 0; i < 1000; i++) {
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        if (t1.tv_sec < t0.tv_sec || (t1.tv_sec == t0.tv_sec && t1.tv_nsec < t0.tv_nsec))
+            monotonic = 0;
+        t0 = t1;
+    }
+    prints("  - 1000 consecutive reads: %s\n", monotonic ? "monotonic" : "WENT BACKWARDS");
+    if (!monotonic) passed = 0;
+
+    tick_cal_passed = passed;
+
+    print_test_result("TICK CALIBRATION TEST", tick_cal_passed);
+
+    project_tests_run++;
+    if (tick_cal_passed) project_tests_passed++;
+}
+
+/****************************************/
+/**    Tick Rate Tests                 **/
+/****************************************/
+
+static void subtest_tick_rate_errors(int *passed) {
+    print_subtest_header(1, "set_tick_rate/clock_getstats error cases");
+
+    *passed = 1;
+
+    RESET_ERRNO();
+    int ret = set_tick_rate(CLOCK_MIN_HZ - 1);
+    prints("[PID %d] [TID %d] set_tick_rate(%d): ret=%d errno=%d (expected -1, EINVAL)\n",
+           getpid(), gettid(), CLOCK_MIN_HZ - 1, ret, errno);
+    if (ret != -1 || errno != EINVAL) *passed = 0;
+
+    RESET_ERRNO();
+    ret = set_tick_rate(CLOCK_MAX_HZ + 1);
+    prints("[PID %d] [TID %d] set_tick_rate(%d): ret=%d errno=%d (expected -1, EINVAL)\n",
+           getpid(), gettid(), CLOCK_MAX_HZ + 1, ret, errno);
+    if (ret != -1 || errno != EINVAL) *passed = 0;
+
+    RESET_ERRNO();
+    ret = clock_getstats((struct clock_stats *)0x100);
+    prints("[PID %d] [TID %d] clock_getstats(kernel address): ret=%d errno=%d (expected -1, "
+           "EFAULT)\n",
+           getpid(), gettid(), ret, errno);
+    if (ret != -1 || errno != EFAULT) *passed = 0;
+
+    ret = set_tick_rate(0);
+    prints("[PID %d] [TID %d] set_tick_rate(0): ret=%d (expected the current rate, %d)\n",
+           getpid(), gettid(), ret, TICKS_PER_SECOND);
+    if (ret != TICKS_PER_SECOND) *passed = 0;
+
+    print_subtest_result(*passed);
+}
+
+static void subtest_tick_rate_fast(int *passed) {
+    print_subtest_header(2, "Faster tick rate");
+
+    struct timespec before, after;
+    *passed = 1;
+
+    clock_gettime(CLOCK_MONOTONIC, &before);
+    int old = set_tick_rate(TICK_RATE_TEST_HZ);
+    clock_gettime(CLOCK_MONOTONIC, &after);
+    int hz = TICKS_PER_SECOND;
+
+    /* The clock continues from where it was */
+    int gap_us = (after.tv_sec - before.tv_sec) * 1000000 + (after.tv_nsec - before.tv_nsec) / 1000;
+    prints("[PID %d] [TID %d] set_tick_rate(%d): was %d, now %d ticks/s, clock moved %d us\n",
+           getpid(), gettid(), TICK_RATE_TEST_HZ, old, hz, gap_us);
+    if (old <= 0 || gap_us < 0 || gap_us > 10000) *passed = 0;
+
+    /* PIT rates are rounded to whole input clocks: allow 1% */
+    if (hz < TICK_RATE_TEST_HZ - TICK_RATE_TEST_HZ / 100 ||
+        hz > TICK_RATE_TEST_HZ + TICK_RATE_TEST_HZ / 100)
+        *passed = 0;
+
+    /* Each tick must last the TSC cycles of 1/hz seconds */
+    busyWait(1);
+    int start_ticks = gettime();
+    unsigned long long start_tsc = read_tsc();
+    busyWait(MS_TO_TICKS(TICK_RATE_TEST_MS));
+    int elapsed = gettime() - start_ticks;
+    unsigned long long cycles = read_tsc() - start_tsc;
+
+    unsigned int measured = elapsed ? (unsigned int)(cycles >> 4) / elapsed * 16 : 0;
+    unsigned int expected = get_tsc_khz() * 10 / (hz / 100);
+    int dev = deviation_permille(measured, expected);
+    prints("  - %d ticks: %u cycles per tick, expected %u, deviation %d.%d%%\n", elapsed,
+           measured, expected, dev / 10, dev % 10);
+    if (dev > 50) *passed = 0; /* 5% tolerance */
+
+    int ret = set_tick_rate(old);
+    prints("  - set_tick_rate(%d): ret=%d, now %d ticks/s\n", old, ret, TICKS_PER_SECOND);
+    if (ret != hz || TICKS_PER_SECOND != old) *passed = 0;
+
+    print_subtest_result(*passed);
+}
+
+static void subtest_tick_rate_idle(int *passed) {
+    print_subtest_header(3, "Clock interrupts while idle");
+
+    struct clock_stats st0, st1;
+    int period = MS_TO_TICKS(TICK_RATE_IDLE_MS);
+
+    /* A sleeping EDF thread is a timed event the tick can skip to */
+    if (sched_setdeadline(period, 1, 0) < 0) {
+        prints("[PID %d] [TID %d] ERROR: sched_setdeadline failed (errno=%d)\n", getpid(),
+               gettid(), errno);
+        *passed = 0;
+        print_subtest_result(*passed);
+        return;
+    }
+    sched_waitperiod();
+
+    clock_getstats(&st0);
+    int start_ticks = gettime();
+    sched_waitperiod();
+    int elapsed = gettime() - start_ticks;
+    clock_getstats(&st1);
+    sched_setdeadline(0, 0, 0);
+
+    unsigned int irqs = st1.timer_irqs - st0.timer_irqs;
+    prints("[PID %d] [TID %d] slept %d ticks (period %d) with the %s timer at %d ticks/s\n",
+           getpid(), gettid(), elapsed, period, st1.oneshot ? "one-shot APIC" : "PIT", st1.hz);
+    prints("  - %u clock interrupts, %u idle tick stops, %u ticks skipped in total\n", irqs,
+           st1.idle_stops - st0.idle_stops, st1.ticks_skipped);
+    if (st1.oneshot) prints("  - APIC timer: %u kHz\n", st1.lapic_khz);
+
+    /* The ticks advance either way; only the one-shot timer skips interrupts */
+    int slack = MS_TO_TICKS(50);
+    *passed = (elapsed >= period - slack && elapsed <= period + slack);
+    if (st1.oneshot && irqs * 10 > (unsigned int)elapsed) *passed = 0;
+
+    print_subtest_result(*passed);
+}
+
+int test_tick_rate(void) {
+    print_test_header("TICK RATE TESTS");
+
+    int passed = 0;
+    int result;
+
+    subtest_tick_rate_errors(&result);
+    passed += result;
+
+    subtest_tick_rate_fast(&result);
+    passed += result;
+
+    subtest_tick_rate_idle(&result);
+    passed += result;
+
+    prints("\n========================================\n");
+    prints("TICK RATE TESTS: %d/3 subtests passed\n", passed);
+    prints("========================================\n");
+
+    int all_passed = (passed == 3);
+    print_test_result("TICK RATE TESTS", all_passed);
+
+    /* Track in global summary */
+    tick_rate_passed = all_passed;
+    project_tests_run++;
+    if (all_passed) project_tests_passed++;
+
+    return all_passed;
+}
+
+/****************************************/
+/**    CPU Load Test Functions         **/
+/****************************************/
+
+static void print_cpu_stats(struct cpu_stats *st, struct cpu_stats *before) {
+    unsigned int khz = get_tsc_khz();
+    unsigned int idle_ms = (unsigned int)(st->idle_cycles - before->idle_cycles) / khz;
+    unsigned int busy_ms = (unsigned int)(st->busy_cycles - before->busy_cycles) / khz;
+
+    prints("  - last windows (%u ms, permille busy):", st->window_ms);
+    for (int i = 0; i < 4; i++) prints(" %u", st->util[i]);
+    prints("\n  - %u ms idle, %u ms busy, %u halts; load %u/%u %u/%u %u/%u\n", idle_ms, busy_ms,
+           st->halts - before->halts, st->loadavg[0], LOAD_FIXED_1, st->loadavg[1], LOAD_FIXED_1,
+           st->loadavg[2], LOAD_FIXED_1);
+}
+
+static void subtest_cpu_load_errors(int *passed) {
+    print_subtest_header(1, "get_cpu_stats error cases");
+
+    RESET_ERRNO();
+    int ret = get_cpu_stats((struct cpu_stats *)0x100);
+    prints("[PID %d] [TID %d] get_cpu_stats(kernel address): ret=%d errno=%d (expected -1, "
+           "EFAULT)\n",
+           getpid(), gettid(), ret, errno);
+    *passed = (ret == -1 && errno == EFAULT);
+
+    print_subtest_result(*passed);
+}
+
+static void subtest_cpu_load_idle(int *passed) {
+    print_subtest_header(2, "Utilization while idle");
+
+    struct cpu_stats st0, st1;
+
+    if (sched_setdeadline(MS_TO_TICKS(CPU_LOAD_TEST_MS), 1, 0) < 0) {
+        prints("[PID %d] [TID %d] ERROR: sched_setdeadline failed (errno=%d)\n", getpid(),
+               gettid(), errno);
+        *passed = 0;
+        print_subtest_result(*passed);
+        return;
+    }
+    sched_waitperiod();
+
+    get_cpu_stats(&st0);
+    sched_waitperiod();
+    get_cpu_stats(&st1);
+    sched_setdeadline(0, 0, 0);
+
+    prints("[PID %d] [TID %d] slept %d ms\n", getpid(), gettid(), CPU_LOAD_TEST_MS);
+    print_cpu_stats(&st1, &st0);
+
+    *passed = (st1.windows > st0.windows && st1.util[0] < 500 && st1.halts > st0.halts);
+    print_subtest_result(*passed);
+}
+
+static void subtest_cpu_load_busy(int *passed) {
+    print_subtest_header(3, "Utilization while spinning");
+
+    struct cpu_stats st0, st1;
+
+    get_cpu_stats(&st0);
+    busyWait(MS_TO_TICKS(CPU_LOAD_TEST_MS));
+    get_cpu_stats(&st1);
+
+    prints("[PID %d] [TID %d] spun %d ms\n", getpid(), gettid(), CPU_LOAD_TEST_MS);
+    print_cpu_stats(&st1, &st0);
+
+    /* Only the clock interrupts may leave the CPU idle for a moment */
+    unsigned int idle = (unsigned int)(st1.idle_cycles - st0.idle_cycles);
+    unsigned int busy = (unsigned int)(st1.busy_cycles - st0.busy_cycles);
+    *passed = (st1.windows > st0.windows && st1.util[0] > 800 && idle < busy / 10);
+    print_subtest_result(*passed);
+}
+
+int test_cpu_load(void) {
+    print_test_header("CPU LOAD TESTS");
+
+    int passed = 0;
+    int result;
+
+    subtest_cpu_load_errors(&result);
+    passed += result;
+
+    subtest_cpu_load_idle(&result);
+    passed += result;
+
+    subtest_cpu_load_busy(&result);
+    passed += result;
+
+    prints("\n========================================\n");
+    prints("CPU LOAD TESTS: %d/3 subtests passed\n", passed);
+    prints("========================================\n");
+
+    int all_passed = (passed == 3);
+    print_test_result("CPU LOAD TESTS", all_passed);
+
+    /* Track in global summary */
+    cpu_load_passed = all_passed;
+    project_tests_run++;
+    if (all_passed) project_tests_passed++;
+
+    return all_passed;
+}
+
+/****************************************/
+/**    Serial Port Test Functions      **/
+/****************************************/
+
+static void subtest_serial_errors(int *passed) {
+    print_subtest_header(1, "serial_read error cases");
+
+    char buffer[16];
+    *passed = 1;
+
+    RESET_ERRNO();
+    int ret = serial_read(buffer, -1);
+    prints("[PID %d] [TID %d] serial_read(size -1): ret=%d errno=%d (expected -1, EINVAL)\n",
+           getpid(), gettid(), ret, errno);
+    if (ret != -1 || errno != EINVAL) *passed = 0;
+
+    RESET_ERRNO();
+    ret = serial_read((char *)0x100, sizeof(buffer));
+    prints("[PID %d] [TID %d] serial_read(kernel address): ret=%d errno=%d (expected -1, EFAULT)\n",
+           getpid(), gettid(), ret, errno);
+    if (ret != -1 || errno != EFAULT) *passed = 0;
+
+    RESET_ERRNO();
+    ret = serial_read(buffer, sizeof(buffer));
+    prints("[PID %d] [TID %d] serial_read(nothing sent): ret=%d errno=%d (expected 0, or -1 with "
+           "ENODEV)\n",
+           getpid(), gettid(), ret, errno);
+    if (ret != 0 && (ret != -1 || errno != ENODEV)) *passed = 0;
+
+    print_subtest_result(*passed);
+}
+
+static void subtest_serial_debug_write(int *passed) {
+    print_subtest_header(2, "Debug output through the transmit ring");
+
+    for (int i = 0; i < SERIAL_TEST_BYTES; i++)
+        serial_test_buffer[i] = ((i + 1) % 64 == 0) ? '\n' : '~';
+
+    unsigned int start = read_tsc_low();
+    int ret = write(2, serial_test_buffer, SERIAL_TEST_BYTES);
+    unsigned int cycles = read_tsc_low() - start;
+
+    prints("[PID %d] [TID %d] write(FD_DEBUG, %d bytes): ret=%d in %u cycles (%u per byte)\n",
+           getpid(), gettid(), SERIAL_TEST_BYTES, ret, cycles, cycles / SERIAL_TEST_BYTES);
+    *passed = (ret == SERIAL_TEST_BYTES);
+
+    print_subtest_result(*passed);
+}
+
+int test_serial(void) {
+    print_test_header("SERIAL PORT TESTS");
+
+    int passed = 0;
+    int result;
+
+    subtest_serial_errors(&result);
+    passed += result;
+
+    subtest_serial_debug_write(&result);
+    passed += result;
+
+    prints("\n========================================\n");
+    prints("SERIAL PORT TESTS: %d/2 subtests passed\n", passed);
+    prints("========================================\n");
+
+    int all_passed = (passed == 2);
+    print_test_result("SERIAL PORT TESTS", all_passed);
+
+    /* Track in global summary */
+    serial_passed = all_passed;
+    project_tests_run++;
+    if (all_passed) project_tests_passed++;
+
+    return all_passed;
+}
+
+/****************************************/
+/**    Kernel Log Test Functions       **/
+/****************************************/
+
+static void subtest_klog_errors(int *passed) {
+    print_subtest_header(1, "dmesg error cases");
+
+    char buffer[16];
+    *passed = 1;
+
+    RESET_ERRNO();
+    int ret = dmesg(buffer, -1);
+    prints("[PID %d] [TID %d] dmesg(size -1): ret=%d errno=%d (expected -1, EINVAL)\n", getpid(),
+           gettid(), ret, errno);
+    if (ret != -1 || errno != EINVAL) *passed = 0;
+
+    RESET_ERRNO();
+    ret = dmesg((char *)0x100, sizeof(buffer));
+    prints("[PID %d] [TID %d] dmesg(kernel address): ret=%d errno=%d (expected -1, EFAULT)\n",
+           getpid(), gettid(), ret, errno);
+    if (ret != -1 || errno != EFAULT) *passed = 0;
+
+    print_subtest_result(*passed);
+}
+
+static void subtest_klog_read(int *passed) {
+    print_subtest_header(2, "Boot messages and the newest text");
+
+    char tail[KLOG_TEST_TAIL];
+    *passed = 1;
+
+    /* Nothing is printed between the two reads, so the log does not change */
+    int len = dmesg(klog_test_buffer, KLOG_TEST_BYTES);
+    int n = dmesg(tail, KLOG_TEST_TAIL);
+
+    prints("[PID %d] [TID %d] dmesg(%d bytes): ret=%d (expected > 0)\n", getpid(), gettid(),
+           KLOG_TEST_BYTES, len);
+    if (len <= 0) *passed = 0;
+
+    int same = (len >= KLOG_TEST_TAIL && n == KLOG_TEST_TAIL);
+    for (int i = 0; same && i < n; i++) {
+        if (tail[i] != klog_test_buffer[len - n + i]) same = 0;
+    }
+    prints("[PID %d] [TID %d] dmesg(%d bytes): ret=%d, %s the end of the full read\n", getpid(),
+           gettid(), KLOG_TEST_TAIL, n, same ? "matches" : "does not match");
+    if (!same) *passed = 0;
+
+    print_subtest_result(*passed);
+}
+
+int test_klog(void) {
+    print_test_header("KERNEL LOG TESTS");
+
+    int passed = 0;
+    int result;
+
+    subtest_klog_errors(&result);
+    passed += result;
+
+    subtest_klog_read(&result);
+    passed += result;
+
+    prints("\n========================================\n");
+    prints("KERNEL LOG TESTS: %d/2 subtests passed\n", passed);
+    prints("========================================\n");
+
+    int all_passed = (passed == 2);
+    print_test_result("KERNEL LOG TESTS", all_passed);
+
+    /* Track in global summary */
+    klog_passed = all_passed;
+    project_tests_run++;
+    if (all_passed) project_tests_passed++;
+
+    return all_passed;
+}
+
+/****************************************/
+/**    Console Scroll Test Functions   **/
+/****************************************/
+
+static void subtest_console_lines(int *passed) {
+    print_subtest_header(1, "Lines through the end of video memory");
+
+    char line[] = "console scroll test: line 000\n";
+    int len = sizeof(line) - 1;
+    int accepted = 0;
+
+    unsigned int start = read_tsc_low();
+    for (int i = 0; i < CONSOLE_TEST_LINES; i++) {
+        line[len - 4] = '0' + (i / 100) % 10;
+        line[len - 3] = '0' + (i / 10) % 10;
+        line[len - 2] = '0' + i % 10;
+        if (write(1, line, len) == len) accepted++;
+    }
+    unsigned int cycles = read_tsc_low() - start;
+
+    prints("[PID %d] [TID %d] %d/%d lines written in %u cycles (%u per line)\n", getpid(),
+           gettid(), accepted, CONSOLE_TEST_LINES, cycles, cycles / CONSOLE_TEST_LINES);
+    *passed = (accepted == CONSOLE_TEST_LINES);
+
+    print_subtest_result(*passed);
+}
+
+int test_console_scroll(void) {
+    print_test_header("CONSOLE SCROLLING TESTS");
+
+    int passed = 0;
+    int result;
+
+    subtest_console_lines(&result);
+    passed += result;
+
+    prints("\n========================================\n");
+    prints("CONSOLE SCROLLING TESTS: %d/1 subtests passed\n", passed);
+    prints("========================================\n");
+
+    int all_passed = (passed == 1);
+    print_test_result("CONSOLE SCROLLING TESTS", all_passed);
+
+    /* Track in global summary */
+    console_scroll_passed = all_passed;
+    project_tests_run++;
+    if (all_passed) project_tests_passed++;
+
+    return all_passed;
+}
+
+/****************************************/
+/**    Page Flipping Test Functions    **/
+/****************************************/
+
+static void subtest_present_errors(int *passed) {
+    print_subtest_header(1, "set_present_mode error cases");
+
+    *passed = 1;
+
+    RESET_ERRNO();
+    int ret = set_present_mode(1, SCREEN_PRESENT_FLIP);
+    prints("[PID %d] [TID %d] set_present_mode(fd 1): ret=%d errno=%d (expected -1, EBADF)\n",
+           getpid(), gettid(), ret, errno);
+    if (ret != -1 || errno != EBADF) *passed = 0;
+
+    RESET_ERRNO();
+    ret = set_present_mode(10, 99);
+    prints("[PID %d] [TID %d] set_present_mode(mode 99): ret=%d errno=%d (expected -1, EINVAL)\n",
+           getpid(), gettid(), ret, errno);
+    if (ret != -1 || errno != EINVAL) *passed = 0;
+
+    print_subtest_result(*passed);
+}
+
+/* Present PRESENT_TEST_FRAMES frames in mode; returns the frames accepted */
+static int present_frames(int mode, const char *name, char *frame) {
+    int accepted = 0;
+
+    unsigned int start = read_tsc_low();
+    for (int i = 0; i < PRESENT_TEST_FRAMES; i++) {
+        for (int j = 0; j < SCREEN_BUFFER_SIZE; j += 2) {
+            frame[j] = '0' + i;
+            frame[j + 1] = (mode == SCREEN_PRESENT_VSYNC) ? 0x1F : 0x2F;
+        }
+        if (write(10, frame, SCREEN_BUFFER_SIZE) == SCREEN_BUFFER_SIZE) accepted++;
+    }
+    unsigned int cycles = read_tsc_low() - start;
+
+    prints("[PID %d] [TID %d] %s: %d/%d frames in %u cycles (%u per frame)\n", getpid(), gettid(),
+           name, accepted, PRESENT_TEST_FRAMES, cycles, cycles / PRESENT_TEST_FRAMES);
+    return accepted;
+}
+
+static void subtest_present_flip(int *passed) {
+    print_subtest_header(2, "Frames through the flip and vsync modes");
+
+    char frame[SCREEN_BUFFER_SIZE];
+    *passed = 1;
+
+    int old = set_present_mode(10, SCREEN_PRESENT_FLIP);
+    if (old != SCREEN_PRESENT_DIRECT) *passed = 0;
+    if (present_frames(SCREEN_PRESENT_FLIP, "flip", frame) != PRESENT_TEST_FRAMES) *passed = 0;
+
+    old = set_present_mode(10, SCREEN_PRESENT_VSYNC);
+    if (old != SCREEN_PRESENT_FLIP) *passed = 0;
+    if (present_frames(SCREEN_PRESENT_VSYNC, "vsync", frame) != PRESENT_TEST_FRAMES) *passed = 0;
+
+    /* Back to the console, which kept its text while the pages were shown */
+    old = set_present_mode(10, SCREEN_PRESENT_DIRECT);
+    prints("[PID %d] [TID %d] set_present_mode(direct): ret=%d (expected %d)\n", getpid(),
+           gettid(), old, SCREEN_PRESENT_VSYNC);
+    if (old != SCREEN_PRESENT_VSYNC) *passed = 0;
+
+    print_subtest_result(*passed);
+}
+
+int test_present(void) {
+    print_test_header("PAGE FLIPPING TESTS");
+
+    int passed = 0;
+    int result;
+
+    subtest_present_errors(&result);
+    passed += result;
+
+    subtest_present_flip(&result);
+    passed += result;
+
+    prints("\n========================================\n");
+    prints("PAGE FLIPPING TESTS: %d/2 subtests passed\n", passed);
+    prints("========================================\n");
+
+    int all_passed = (passed == 2);
+    print_test_result("PAGE FLIPPING TESTS", all_passed);
+
+    /* Track in global summary */
+    present_passed = all_passed;
+    project_tests_run++;
+    if (all_passed) project_tests_passed++;
+
+    return all_passed;
+}
+
+/****************************************/
+/**    FPS Visual Test Functions       **/
+/****************************************/
+
+/* Keyboard handler for FPS test - N/B/Esc navigation */
+static void fps_kbd_handler(char scancode, int pressed) {
+    unsigned char sc = (unsigned char)scancode;
+    if (!pressed) return; /* Only handle key press, not release */
+
+    switch (sc) {
+    case FPS_SCANCODE_ESC:
+        fps_test_exit = 1;
+        break;
+    case FPS_SCANCODE_N:
+        fps_next_scene = 1;
+        break;
+    case FPS_SCANCODE_B:
+        fps_prev_scene = 1;
+        break;
+    }
+}
+
+int fps_visual_test(void) {
+    char frame_buffer[SCREEN_BUFFER_SIZE];
+    char checkerboard_buffer[SCREEN_BUFFER_SIZE];
+    char rainbow_buffer[SCREEN_BUFFER_SIZE];
+    int current_scene = 1;
+    SceneState scene_state;
+
+    /* Pre-generate static patterns (only once) */
+    generate_checkerboard_pattern(checkerboard_buffer);
+    generate_rainbow_pattern(rainbow_buffer);
+
+    /* Reset state */
+    fps_test_exit = 0;
+    fps_next_scene = 0;
+    fps_prev_scene = 0;
+    scene_init(&scene_state);
+
+    /* Register keyboard handler */
+    int ret = KeyboardEvent(fps_kbd_handler);
+    if (ret != 0) {
+        prints("[PID %d] [TID %d] Failed to register keyboard handler for FPS test\n", getpid(),
+               gettid());
+        return 0;
+    }
+
+    prints("[PID %d] [TID %d] FPS Visual Test started.\n", getpid(), gettid());
+    prints("[PID %d] [TID %d] Navigation: N=Next, B=Back, Esc=Exit\n", getpid(), gettid());
+    prints("[PID %d] [TID %d] Scene 1: Checkerboard pattern (static)\n", getpid(), gettid());
+    prints("[PID %d] [TID %d] Scene 2: Rainbow pattern (static)\n", getpid(), gettid());
+    prints("[PID %d] [TID %d] Scene 3: Starfield with twinkling stars\n", getpid(), gettid());
+    prints("[PID %d] [TID %d] Scene 4: Bouncing balls with decorations\n", getpid(), gettid());
+
+    /* Small pause before starting */
+    busyWait(TIME_VISUAL_PAUSE);
+
+    int start_time = gettime();
+
+    /* Main render loop */
     while (!fps_test_exit && (gettime() - start_time) < TIME_FPS_TEST_DURATION) {
         /* Handle scene navigation */
         if (fps_next_scene) {
@@ -1659,16 +3738,100 @@ void execute_project_tests(void) {
     waitfortick_tests();
 #endif
 
+#if FPU_TEST
+    RESET_ERRNO();
+    fpu_tests();
+#endif
+
+#if EDF_TEST
+    RESET_ERRNO();
+    edf_tests();
+#endif
+
+#if CTX_SWITCH_PERFORMANCE_TEST
+    RESET_ERRNO();
+    test_context_switch_performance();
+#endif
+
+#if PREEMPT_LATENCY_TEST
+    RESET_ERRNO();
+    test_preempt_latency();
+#endif
+
+#if VDSO_TEST
+    RESET_ERRNO();
+    test_vdso();
+#endif
+
+#if URING_TEST
+    RESET_ERRNO();
+    test_uring();
+#endif
+
+#if SYSCALL_STATS_TEST
+    RESET_ERRNO();
+    test_syscall_stats();
+#endif
+
+#if PROFILER_TEST
+    RESET_ERRNO();
+    test_profiler();
+#endif
+
+#if TRACE_TEST
+    RESET_ERRNO();
+    test_trace();
+#endif
+
+#if IRQSOFF_TEST
+    RESET_ERRNO();
+    test_irqsoff();
+#endif
+
 #if TICK_CALIBRATION_TEST
     RESET_ERRNO();
     tick_calibration_test();
 #endif
 
+#if TICK_RATE_TEST
+    RESET_ERRNO();
+    test_tick_rate();
+#endif
+
+#if CPU_LOAD_TEST
+    RESET_ERRNO();
+    test_cpu_load();
+#endif
+
+#if SERIAL_TEST
+    RESET_ERRNO();
+    test_serial();
+#endif
+
+#if KLOG_TEST
+    RESET_ERRNO();
+    test_klog();
+#endif
+
+#if CONSOLE_SCROLL_TEST
+    RESET_ERRNO();
+    test_console_scroll();
+#endif
+
+#if PRESENT_TEST
+    RESET_ERRNO();
+    test_present();
+#endif
+
 #if FPS_TEST
     RESET_ERRNO();
     fps_tests();
 #endif
 
+    /* Reap finished child processes so their task_structs are released */
+    while (waitpid(-1, (int *)0, WNOHANG) > 0) {
+    }
+
     /* Final summary */
     prints("\n=========================================\n");
     prints("      PROJECT TEST SUITE SUMMARY         \n");
@@ -1693,9 +3856,59 @@ void execute_project_tests(void) {
     prints("  - TIME SUPPORT TESTS:       %s\n",
            (wft_subtests_passed == wft_subtests_run) ? "PASSED" : "FAILED");
 #endif
+#if FPU_TEST
+    prints("  - FPU SUPPORT TESTS:        %s\n",
+           (fpu_subtests_passed == fpu_subtests_run) ? "PASSED" : "FAILED");
+#endif
+#if EDF_TEST
+    prints("  - EDF SCHEDULER TESTS:      %s\n",
+           (edf_subtests_passed == edf_subtests_run) ? "PASSED" : "FAILED");
+#endif
+#if CTX_SWITCH_PERFORMANCE_TEST
+    prints("  - CONTEXT SWITCH PERF TEST: %s\n", ctx_switch_perf_passed ? "PASSED" : "FAILED");
+#endif
+#if PREEMPT_LATENCY_TEST
+    prints("  - PREEMPT LATENCY TEST:     %s\n", preempt_latency_passed ? "PASSED" : "FAILED");
+#endif
+#if VDSO_TEST
+    prints("  - SHARED TIME/ID PAGE:      %s\n", vdso_passed ? "PASSED" : "FAILED");
+#endif
+#if URING_TEST
+    prints("  - SUBMISSION RING TEST:     %s\n", uring_passed ? "PASSED" : "FAILED");
+#endif
+#if SYSCALL_STATS_TEST
+    prints("  - SYSCALL STATISTICS TEST:  %s\n", syscall_stats_passed ? "PASSED" : "FAILED");
+#endif
+#if PROFILER_TEST
+    prints("  - SAMPLING PROFILER TEST:   %s\n", profiler_passed ? "PASSED" : "FAILED");
+#endif
+#if TRACE_TEST
+    prints("  - EVENT TRACING TEST:       %s\n", trace_passed ? "PASSED" : "FAILED");
+#endif
+#if IRQSOFF_TEST
+    prints("  - IRQS-OFF TRACER TEST:     %s\n", irqsoff_passed ? "PASSED" : "FAILED");
+#endif
 #if TICK_CALIBRATION_TEST
     prints("  - TICK CALIBRATION TEST:    %s\n", tick_cal_passed ? "PASSED" : "FAILED");
 #endif
+#if TICK_RATE_TEST
+    prints("  - TICK RATE TEST:           %s\n", tick_rate_passed ? "PASSED" : "FAILED");
+#endif
+#if CPU_LOAD_TEST
+    prints("  - CPU LOAD TEST:            %s\n", cpu_load_passed ? "PASSED" : "FAILED");
+#endif
+#if SERIAL_TEST
+    prints("  - SERIAL PORT TEST:         %s\n", serial_passed ? "PASSED" : "FAILED");
+#endif
+#if KLOG_TEST
+    prints("  - KERNEL LOG TEST:          %s\n", klog_passed ? "PASSED" : "FAILED");
+#endif
+#if CONSOLE_SCROLL_TEST
+    prints("  - CONSOLE SCROLLING TEST:   %s\n", console_scroll_passed ? "PASSED" : "FAILED");
+#endif
+#if PRESENT_TEST
+    prints("  - PAGE FLIPPING TEST:       %s\n", present_passed ? "PASSED" : "FAILED");
+#endif
 #if FPS_TEST
     prints("  - FPS VISUAL TEST:          %s\n", fps_test_passed ? "PASSED" : "FAILED");
 #endif
@@ -1707,6 +3920,6 @@ void execute_project_tests(void) {
     prints("\n--- Testing: IDLE SWITCH ---\n");
     prints("[PID %d] [TID %d] Terminating init process. System will switch to idle.\n", getpid(),
            gettid());
-    exit();
+    exit(0);
 #endif
 }
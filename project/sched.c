@@ -7,15 +7,24 @@
  * scheduling with process queues and memory management integration.
  */
 
+#include <clock.h>
+#include <cpuload.h>
 #include <debug.h>
+#include <edf.h>
+#include <fpu.h>
+#include <vdso.h>
 #include <interrupt.h>
 #include <io.h>
+#include <irqsoff.h>
 #include <keyboard.h>
 #include <libc.h>
 #include <mm.h>
+#include <profiler.h>
 #include <sched.h>
 #include <segment.h>
+#include <softirq.h>
 #include <sys.h>
+#include <trace.h>
 #include <utils.h>
 
 /* Global array of all tasks */
@@ -42,6 +51,13 @@ struct list_head readyqueue;
 struct list_head blockedqueue;
 struct list_head tick_blockedqueue;
 
+/* Context switches since boot (lets preemption points detect that they slept) */
+unsigned long nr_context_switches = 0;
+
+/* PID and TID hash tables for O(1) lookup by identifier */
+static struct list_head pid_hash_table[ID_HASH_SIZE];
+static struct list_head tid_hash_table[ID_HASH_SIZE];
+
 struct task_struct *list_head_to_task_struct(struct list_head *l) {
     return list_entry(l, struct task_struct, list);
 }
@@ -54,20 +70,37 @@ page_table_entry *get_PT(struct task_struct *task) {
     return (page_table_entry *)(((unsigned int)(task->dir_pages_baseAddr->bits.pbase_addr)) << 12);
 }
 
-int allocate_DIR(struct task_struct *task) {
+int get_task_index(struct task_struct *task) {
     unsigned long base = (unsigned long)&tasks[0].task;
-    unsigned long current_task = (unsigned long)task;
-    int pos = (current_task - base) / sizeof(union task_union); // Index in tasks[]
+    return ((unsigned long)task - base) / sizeof(union task_union);
+}
+
+int allocate_DIR(struct task_struct *task) {
+    int pos = get_task_index(task); // Index in tasks[]
+    init_task_table(pos);           // First use of the slot with FAST_BOOT
     task->dir_pages_baseAddr = (page_table_entry *)&dir_pages[pos];
     return 1;
 }
 
 void cpu_idle(void) {
+    irqsoff_enabled();
     __asm__ __volatile__("sti" : : : "memory");
     printk_color_fmt(INFO_COLOR, "DEBUG->[IDLE] Idle task started. Current PID=%d, TID=%d\n",
                      current()->PID, current()->TID);
     while (1) {
-        ;
+        /* Decide and halt with interrupts off, so a wakeup cannot slip in between */
+        __asm__ __volatile__("cli" : : : "memory");
+        irqsoff_disabled();
+        cpuload_idle_exit();
+
+        /* Bottom halves an interrupt left over run here, as in a worker thread */
+        do_softirq();
+        clock_nohz_idle();
+        cpuload_idle_enter();
+        irqsoff_enabled();
+
+        /* sti takes effect after hlt: a pending interrupt still wakes it */
+        __asm__ __volatile__("sti; hlt" : : : "memory");
     }
 }
 
@@ -89,6 +122,10 @@ void init_idle(void) {
     /* Initialize blocking mechanism */
     idle_task->pending_unblocks = 0;
 
+    /* Initialize process termination fields */
+    idle_task->exit_code = 0;
+    idle_task->wait_pid = 0;
+
     /* Initialize thread support */
     idle_task->thread_count = 1;
     idle_task->master_thread = idle_task;
@@ -96,10 +133,12 @@ void init_idle(void) {
     INIT_LIST_HEAD(&idle_task->thread_list);
     /* Idle has special TID = 0 (reserved for idle process) */
     idle_task->TID = 0;
-    /* Idle doesn't use tid_slots, initialize all to 0 */
-    for (int i = 0; i < MAX_TIDS_PER_PROCESS; i++) {
-        idle_task->tid_slots[i] = 0;
+    /* Idle doesn't use TIDs, clear its bitmap; it is never looked up by ID */
+    for (int i = 0; i < TID_BITMAP_WORDS; i++) {
+        idle_task->tid_bitmap[i] = 0;
     }
+    INIT_LIST_HEAD(&idle_task->tid_hash);
+    INIT_LIST_HEAD(&idle_task->pid_hash);
     idle_task->user_stack_ptr = NULL;
     idle_task->user_stack_frames = 0;
     idle_task->user_stack_region_start = 0;
@@ -110,6 +149,14 @@ void init_idle(void) {
     /* Initialize keyboard fields */
     init_keyboard_fields(idle_task);
 
+    /* Initialize FPU fields */
+    fpu_init_task(idle_task);
+    idle_task->in_preempt_point = 0;
+    idle_task->uring = NULL;
+
+    /* Idle is always round robin */
+    edf_init_task(idle_task);
+
     allocate_DIR(idle_task);
 
     union task_union *idle_union = (union task_union *)idle_task;
@@ -145,16 +192,23 @@ void init_task1(void) {
     /* Initialize blocking mechanism */
     init_task->pending_unblocks = 0;
 
+    /* Initialize process termination fields */
+    init_task->exit_code = 0;
+    init_task->wait_pid = 0;
+
     /* Initialize thread support */
     init_task->thread_count = 1;
     init_task->master_thread = init_task;
     INIT_LIST_HEAD(&init_task->threads);
     INIT_LIST_HEAD(&init_task->thread_list);
     init_tid_slots(init_task);
-    init_task->TID = 10; /* TID = PID*10 + 0 = 1*10 + 0 = 10 */
+    init_task->TID = 1 * MAX_TIDS_PER_PROCESS; /* Slot 0 of PID 1 */
+    id_hash_add(init_task);
 
     allocate_DIR(init_task);
     set_user_pages(init_task);
+    vdso_map(init_task);
+    vdso_switch_to(init_task);
 
     /* Allocate a dedicated user stack for init's first thread
      * This ensures uniform stack management for all threads including master */
@@ -180,10 +234,17 @@ void init_task1(void) {
     /* Initialize keyboard fields */
     init_keyboard_fields(init_task);
 
+    /* Initialize FPU fields */
+    fpu_init_task(init_task);
+    init_task->in_preempt_point = 0;
+    init_task->uring = NULL;
+
+    /* Initialize scheduling class */
+    edf_init_task(init_task);
+
     union task_union *init_union = (union task_union *)init_task;
 
     tss.esp0 = KERNEL_ESP(init_union);
-    writeMSR(0x175, (unsigned long)tss.esp0);
     set_cr3(init_task->dir_pages_baseAddr);
 }
 
@@ -201,6 +262,9 @@ void init_queues(void) {
 
 void init_sched(void) {
     init_queues();
+    init_id_hash();
+    init_edf();
+    init_kbd_rings();
 }
 
 struct task_struct *current(void) {
@@ -212,56 +276,131 @@ struct task_struct *current(void) {
 
 void inner_task_switch(union task_union *new) {
     struct task_struct *old_task = current();
+    trace_event(TRACE_CAT_SCHED, TRACE_SWITCH, new->task.PID, new->task.TID);
     current_task = &new->task; /* (Optimization) Update global current_task pointer */
+    nr_context_switches++;
 
 #if DEBUG_INFO_TASK_SWITCH
     printDebugInfoSched(old_task->PID, old_task->TID, new->task.PID, new->task.TID);
 #endif
 
-    /* Update TSS stack pointer for the new task */
+    /* Update TSS stack pointer for the new task (also used by sysenter) */
     tss.esp0 = KERNEL_ESP(new);
-    writeMSR(0x175, (DWord)tss.esp0);
 
-    /* Switch to the new task's page directory */
-    set_cr3(get_DIR(&new->task));
+    /* Threads of the same process share the page directory: keep the TLB */
+    if (get_DIR(old_task) != get_DIR(&new->task)) {
+        set_cr3(get_DIR(&new->task));
+    }
+
+    /* Lazy FPU: trap the first FPU instruction unless the new task owns it */
+    fpu_switch_to(&new->task);
+
+    /* Let the new thread read its IDs from the shared page */
+    vdso_switch_to(&new->task);
 
     /* Perform context switch, execution continues in the new process */
     switch_context(&old_task->kernel_esp, new->task.kernel_esp);
 }
 
+int preempt_point(void) {
+#if SYSCALL_PREEMPTION
+    unsigned long switches = nr_context_switches;
+
+    /* STI takes effect after the next instruction: pending IRQs run before CLI */
+    current_task->in_preempt_point = 1;
+    irqsoff_enabled();
+    __asm__ __volatile__("sti\n\tnop\n\tcli" : : : "memory");
+    irqsoff_disabled();
+    current_task->in_preempt_point = 0;
+
+    return switches != nr_context_switches;
+#else
+    return 0;
+#endif
+}
+
 int get_next_pid(void) {
     return ++next_pid;
 }
 
 void init_tid_slots(struct task_struct *master) {
-    /* Initialize all slots as free (0)
-     * Array has MAX_TIDS_PER_PROCESS (10) slots: indices 0-9 correspond to TIDs PID*10 + (0-9)
-     * For PID 1: TIDs 10, 11, 12...19
-     * For PID 2: TIDs 20, 21, 22...29 */
-    for (int i = 0; i < MAX_TIDS_PER_PROCESS; i++) {
-        master->tid_slots[i] = 0;
+    /* Bit i of the bitmap tracks TID = PID*MAX_TIDS_PER_PROCESS + i */
+    for (int i = 0; i < TID_BITMAP_WORDS; i++) {
+        master->tid_bitmap[i] = 0;
     }
-    /* Mark slot 0 (TID = PID*10 + 0) as used for the master thread */
-    master->tid_slots[0] = 1;
+    /* Mark slot 0 as used for the master thread */
+    master->tid_bitmap[0] = 1;
 }
 
 int allocate_tid(struct task_struct *master) {
-    /* Find first free slot (indices 0-9, corresponding to TIDs PID*10 + 0 to PID*10 + 9) */
-    for (int i = 0; i < MAX_TIDS_PER_PROCESS; i++) {
-        if (master->tid_slots[i] == 0) {
-            master->tid_slots[i] = 1;    /* Mark as used */
-            return master->PID * 10 + i; /* Return TID = PID*10 + i */
-        }
+    for (int i = 0; i < TID_BITMAP_WORDS; i++) {
+        unsigned int free_bits = ~master->tid_bitmap[i];
+        if (free_bits == 0) continue; /* Word full */
+
+        int slot = i * 32 + __builtin_ctz(free_bits);
+        if (slot >= MAX_TIDS_PER_PROCESS) break;
+
+        master->tid_bitmap[i] |= 1u << (slot % 32);
+        return master->PID * MAX_TIDS_PER_PROCESS + slot;
     }
     return -1; /* No free slots */
 }
 
 void free_tid(struct task_struct *master, int tid) {
-    /* Convert TID to slot index: TID = PID*10 + slot, so slot = TID - PID*10 */
-    int slot = tid - (master->PID * 10);
+    int slot = tid - master->PID * MAX_TIDS_PER_PROCESS;
     if (slot >= 0 && slot < MAX_TIDS_PER_PROCESS) {
-        master->tid_slots[slot] = 0; /* Mark as free */
+        master->tid_bitmap[slot / 32] &= ~(1u << (slot % 32));
+    }
+}
+
+void init_id_hash(void) {
+    for (int i = 0; i < ID_HASH_SIZE; i++) {
+        INIT_LIST_HEAD(&pid_hash_table[i]);
+        INIT_LIST_HEAD(&tid_hash_table[i]);
+    }
+}
+
+void id_hash_add(struct task_struct *task) {
+    list_add_tail(&task->tid_hash, &tid_hash_table[task->TID & (ID_HASH_SIZE - 1)]);
+
+    if (task->master_thread == task) {
+        list_add_tail(&task->pid_hash, &pid_hash_table[task->PID & (ID_HASH_SIZE - 1)]);
+    } else {
+        INIT_LIST_HEAD(&task->pid_hash);
+    }
+}
+
+void id_hash_del(struct task_struct *task) {
+    list_del(&task->tid_hash);
+    INIT_LIST_HEAD(&task->tid_hash);
+
+    /* pid_hash points to itself when the task is not a master */
+    if (!list_empty(&task->pid_hash)) {
+        list_del(&task->pid_hash);
+        INIT_LIST_HEAD(&task->pid_hash);
+    }
+}
+
+struct task_struct *find_task_by_pid(int pid) {
+    struct list_head *pos;
+
+    if (pid <= 0) return NULL;
+    list_for_each(pos, &pid_hash_table[pid & (ID_HASH_SIZE - 1)]) {
+        struct task_struct *task = list_entry(pos, struct task_struct, pid_hash);
+        if (task->PID == pid) return task;
+    }
+    return NULL;
+}
+
+struct task_struct *find_task_by_tid(int tid) {
+    struct list_head *pos;
+
+    if (tid <= 0) return NULL;
+    list_for_each(pos, &tid_hash_table[tid & (ID_HASH_SIZE - 1)]) {
+        struct task_struct *task = list_entry(pos, struct task_struct, tid_hash);
+        if (task->TID == tid) return task;
     }
+    return NULL;
 }
 
 int get_quantum(struct task_struct *task) {
@@ -277,6 +416,15 @@ void update_sched_data_rr(void) {
 }
 
 int needs_sched_rr(void) {
+    // Need to switch if the current process is blocked
+    if (current_task->status == ST_BLOCKED) return 1;
+
+    // A ready EDF thread preempts round robin threads and later deadlines
+    if (edf_needs_preempt()) return 1;
+
+    // EDF threads are not time sliced: they run until they wait, are throttled or preempted
+    if (current_task->sched_policy == SCHED_EDF) return 0;
+
     if (current_quantum <= 0) {
         current_quantum = get_quantum(current_task);
         // Need to switch if there are ready processes and quantum expired
@@ -284,20 +432,29 @@ int needs_sched_rr(void) {
             return 1;
         }
     }
-    // Need to switch if the current process is blocked
-    return (current_task->status == ST_BLOCKED);
+    return 0;
 }
 
 void update_process_state_rr(struct task_struct *task, struct list_head *dest_queue) {
     struct list_head *task_list = &task->list;
 
+    /* Callers run with interrupts disabled on the only CPU: no lock needed */
+
     // Remove from current queue only if not running
     if (task->status != ST_RUN) {
         list_del(task_list);
     }
 
+    if (dest_queue == &readyqueue && task->status == ST_BLOCKED) {
+        trace_event(TRACE_CAT_SCHED, TRACE_WAKEUP, task->PID, task->TID);
+    }
+
     // Update state and queue based on destination
-    if (dest_queue != NULL) {
+    if (dest_queue == &readyqueue && task->sched_policy == SCHED_EDF) {
+        // EDF threads wait in their own queue, sorted by deadline
+        edf_enqueue(task);
+        task->status = ST_READY;
+    } else if (dest_queue != NULL) {
         list_add_tail(task_list, dest_queue);
         task->status = (dest_queue == &readyqueue) ? ST_READY : ST_BLOCKED;
     } else {
@@ -306,15 +463,50 @@ void update_process_state_rr(struct task_struct *task, struct list_head *dest_qu
     }
 }
 
+#if SCHED_SAME_PROCESS_BIAS
+/* Consecutive switches that stayed inside one address space */
+static int same_process_switches = 0;
+
+/* Return the first ready thread sharing the current page directory, or NULL */
+static struct task_struct *find_ready_sibling(void) {
+    struct list_head *pos;
+
+    if (current_task == idle_task || same_process_switches >= SCHED_SAME_PROCESS_MAX_RUN) {
+        same_process_switches = 0;
+        return NULL;
+    }
+
+    list_for_each(pos, &readyqueue) {
+        struct task_struct *task = list_head_to_task_struct(pos);
+        if (task != current_task && get_DIR(task) == get_DIR(current_task)) {
+            same_process_switches++;
+            return task;
+        }
+    }
+    same_process_switches = 0;
+    return NULL;
+}
+#endif
+
 void sched_next_rr(void) {
     struct list_head *next;
     struct task_struct *next_task;
 
-    /* Select next process: from ready queue if possible, idle process otherwise */
-    if (!list_empty(&readyqueue)) {
+    /* Select next process: earliest deadline first, then the ready queue, idle otherwise */
+    if (!list_empty(&edf_readyqueue)) {
+
+        next_task = list_head_to_task_struct(list_first(&edf_readyqueue));
+        update_process_state_rr(next_task, NULL);
+
+    } else if (!list_empty(&readyqueue)) {
 
         next = list_first(&readyqueue);
         next_task = list_head_to_task_struct(next);
+#if SCHED_SAME_PROCESS_BIAS
+        /* Prefer a sibling thread: the switch avoids reloading CR3 */
+        struct task_struct *sibling = find_ready_sibling();
+        if (sibling != NULL) next_task = sibling;
+#endif
         // Remove from the ready queue
         update_process_state_rr(next_task, NULL);
 
@@ -329,16 +521,24 @@ void sched_next_rr(void) {
     task_switch((union task_union *)next_task);
 }
 
-void scheduler(void) {
+void sched_tick(void) {
     update_sched_data_rr();
 
+    /* Release EDF jobs, charge budgets and count deadline misses */
+    edf_tick();
+
+    /* Expire read_keys timeouts */
+    kbd_tick();
+
     /* Wake up all threads waiting for tick */
     while (!list_empty(&tick_blockedqueue)) {
         struct list_head *first = list_first(&tick_blockedqueue);
         struct task_struct *task = list_head_to_task_struct(first);
         update_process_state_rr(task, &readyqueue);
     }
+}
 
+void scheduler(void) {
     if (needs_sched_rr()) {
         /* Only add to ready queue if NOT blocked (blocked tasks are already in blocked queue) */
         if (current_task->status != ST_BLOCKED) {
@@ -348,6 +548,37 @@ void scheduler(void) {
     }
 }
 
+int sched_idle_ticks(void) {
+    struct list_head *pos;
+    int ticks = SCHED_IDLE_FOREVER;
+
+    if (!list_empty(&readyqueue) || !list_empty(&edf_readyqueue) ||
+        !list_empty(&tick_blockedqueue) || prof_active() || softirq_pending())
+        return 0;
+
+    /* read_keys timeouts count down one tick at a time */
+    list_for_each(pos, &kbd_waitqueue) {
+        if (list_head_to_task_struct(pos)->kbd_wait_ticks > 0) return 0;
+    }
+
+    /* EDF releases are absolute ticks: sleep until the first one */
+    list_for_each(pos, &edf_sleepqueue) {
+        int left = list_head_to_task_struct(pos)->edf_next_release - zeos_ticks;
+        if (left < ticks) ticks = (left > 0) ? left : 0;
+    }
+
+    return ticks;
+}
+
+int sched_nr_running(void) {
+    struct list_head *pos;
+    int running = (current_task != idle_task);
+
+    list_for_each(pos, &readyqueue) running++;
+    list_for_each(pos, &edf_readyqueue) running++;
+    return running;
+}
+
 void printDebugInfoSched(int from_pid, int from_tid, int to_pid, int to_tid) {
     printk_color_fmt(INFO_COLOR,
                      "DEBUG->[SCHED] switch from PID %d TID %d to PID %d TID %d and ready: ",
@@ -4,29 +4,118 @@
  *
  * This file implements direct screen buffer writing for the write(10, ...)
  * system call. Multiple copy methods are available, selectable at compile time.
+ * In the flip presentation modes the frame is written to the hidden page
+ * and then shown by CRTC start address.
  */
 
+#include <clock.h>
+#include <errno.h>
 #include <io.h>
 #include <kernel_helpers.h>
+#include <sched.h>
 #include <screen.h>
 #include <types.h>
 #include <utils.h>
 
 int frame_count = 0;
 
+/* Presentation mode, the process that set it, and the page shown */
+static int present_mode = SCREEN_PRESENT_DIRECT;
+static int present_owner = 0;
+static int front = 0;
+
+/* PID of the process presenting a frame, or 0 (see frame_begin) */
+static int presenting = 0;
+
+/* First cell of a flip page, past the console rows */
+static Word *screen_page(int page) {
+    return (Word *)VIDEO_MEMORY_BASE + (CONSOLE_ROWS + page * NUM_ROWS) * NUM_COLUMNS;
+}
+
+/*
+ * Start a frame and return where it goes: the console screen, or the
+ * hidden page. The retrace waits open preemption windows, so frames are
+ * presented one at a time: a second writer would otherwise pick the
+ * page still on screen. Ends with frame_present().
+ */
+static Word *frame_begin(void) {
+    while (presenting) preempt_point();
+    presenting = current_task->PID;
+
+    if (present_mode == SCREEN_PRESENT_DIRECT) return console_screen();
+    return screen_page(front ^ 1);
+}
+
+/* Wait until the vertical retrace bit reads in_retrace, for SCREEN_VSYNC_TIMEOUT_MS at most */
+static void wait_retrace(int in_retrace) {
+    unsigned int start, now, high;
+    rdtsc(start, high);
+
+    while (((inb(VGA_INPUT_STATUS) & VGA_STATUS_RETRACE) != 0) != in_retrace) {
+        rdtsc(now, high);
+        if (now - start > tsc_khz * SCREEN_VSYNC_TIMEOUT_MS) break;
+        preempt_point();
+    }
+    (void)high;
+}
+
+/* Show the frame just written and draw the overlay on it */
+static void frame_present(void) {
+    if (present_mode != SCREEN_PRESENT_DIRECT) {
+        /*
+         * The CRTC latches the start address when the retrace begins:
+         * set it outside a retrace, then wait for the next one so the
+         * old page is off screen before the following frame overwrites it.
+         */
+        if (present_mode == SCREEN_PRESENT_VSYNC) wait_retrace(0);
+        front ^= 1;
+        console_show_page(screen_page(front));
+        if (present_mode == SCREEN_PRESENT_VSYNC) wait_retrace(1);
+    }
+
+    frame_count++;
+    draw_time_and_fps();
+    presenting = 0;
+}
+
+int screen_set_present(int mode) {
+    if (mode != SCREEN_PRESENT_DIRECT && mode != SCREEN_PRESENT_FLIP &&
+        mode != SCREEN_PRESENT_VSYNC)
+        return -EINVAL;
+
+    /* Not in the middle of another thread's frame */
+    while (presenting) preempt_point();
+
+    int old = present_mode;
+    present_mode = mode;
+    present_owner = current_task->PID;
+
+    /* Flipping starts on the next frame; direct frames go back to the console */
+    if (mode == SCREEN_PRESENT_DIRECT) console_show_page(NULL);
+    return old;
+}
+
+void screen_release(struct task_struct *master) {
+    /* A thread killed while it waited for the retrace leaves its frame unfinished */
+    if (presenting == master->PID) presenting = 0;
+
+    if (present_mode == SCREEN_PRESENT_DIRECT || present_owner != master->PID) return;
+    present_mode = SCREEN_PRESENT_DIRECT;
+    console_show_page(NULL);
+}
+
 #if SCREEN_COPY_METHOD == SCREEN_METHOD_WORD_LOOP /* Method A: Word-by-word C loop */
 int sys_write_screen(char *buffer, int size) {
     if (size > SCREEN_BUFFER_SIZE) size = SCREEN_BUFFER_SIZE;
 
-    Word *screen = (Word *)VIDEO_MEMORY_BASE;
+    Word *screen = frame_begin();
     int words = size / 2;
 
     for (int i = 0; i < words; i++) {
         screen[i] = ((Word)buffer[i * 2]) | ((Word)buffer[i * 2 + 1] << 8);
     }
 
-    frame_count++;
-    draw_time_and_fps();
+    frame_present();
 
     return size;
 }
@@ -34,10 +123,9 @@ int sys_write_screen(char *buffer, int size) {
 int sys_write_screen(char *buffer, int size) {
     if (size > SCREEN_BUFFER_SIZE) size = SCREEN_BUFFER_SIZE;
 
-    copy_from_user(buffer, (char *)VIDEO_MEMORY_BASE, size);
+    copy_from_user(buffer, (char *)frame_begin(), size);
 
-    frame_count++;
-    draw_time_and_fps();
+    frame_present();
 
     return size;
 }
@@ -49,8 +137,9 @@ int sys_write_screen(char *buffer, int size) {
     int remaining = size % 4;
 
     /* Use REP MOVSL for bulk copy (4 bytes at a time) */
+    char *target = (char *)frame_begin();
     unsigned int src = (unsigned int)buffer;
-    unsigned int dst = (unsigned int)VIDEO_MEMORY_BASE;
+    unsigned int dst = (unsigned int)target;
     __asm__ __volatile__("cld\n\t"
                          "rep movsl"
                          : "+S"(src), "+D"(dst)
@@ -59,15 +148,14 @@ int sys_write_screen(char *buffer, int size) {
 
     /* Copy remaining bytes (0-3) if not divisible by 4 */
     if (remaining > 0) {
-        char *dest = (char *)VIDEO_MEMORY_BASE + (dwords * 4);
+        char *dest = target + (dwords * 4);
         char *src_rem = buffer + (dwords * 4);
         for (int i = 0; i < remaining; i++) {
             dest[i] = src_rem[i];
         }
     }
 
-    frame_count++;
-    draw_time_and_fps();
+    frame_present();
 
     return size;
 }
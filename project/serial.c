@@ -0,0 +1,147 @@
+/**
+ * @file serial.c
+ * @brief 16550 UART transmit and receive rings.
+ */
+
+#include <cpuload.h>
+#include <errno.h>
+#include <hardware.h>
+#include <io.h>
+#include <serial.h>
+#include <softirq.h>
+#include <spinlock.h>
+
+static int present = 0;
+
+/* Transmit ring: the writers advance tx_head, the interrupt tx_tail */
+static char tx_ring[SERIAL_TX_SIZE];
+static unsigned int tx_head = 0;
+static unsigned int tx_tail = 0;
+
+/* 1 while the FIFO holds bytes: the interrupt will take the next ones */
+static int tx_busy = 0;
+
+/* Receive ring: the interrupt advances rx_head, serial_read rx_tail */
+static char rx_ring[SERIAL_RX_SIZE];
+static unsigned int rx_head = 0;
+static unsigned int rx_tail = 0;
+
+static spinlock_t serial_lock = SPINLOCK_INIT;
+
+/* Move up to a FIFO's worth of the ring to the UART, whose FIFO is empty */
+static void start_tx(void) {
+    int i;
+
+    for (i = 0; i < SERIAL_FIFO_SIZE && tx_tail != tx_head; i++) {
+        outb(SERIAL_COM1 + SERIAL_DATA, tx_ring[tx_tail & (SERIAL_TX_SIZE - 1)]);
+        tx_tail++;
+    }
+
+    /* Busy until an empty FIFO interrupt finds nothing left to send */
+    tx_busy = (i > 0);
+}
+
+static int fifo_empty(void) {
+    return inb(SERIAL_COM1 + SERIAL_LSR) & SERIAL_LSR_THRE;
+}
+
+static void drain_rx(void) {
+    while (inb(SERIAL_COM1 + SERIAL_LSR) & SERIAL_LSR_DR) {
+        char c = inb(SERIAL_COM1 + SERIAL_DATA);
+
+        /* A full ring drops the newest bytes */
+        if (rx_head - rx_tail < SERIAL_RX_SIZE) rx_ring[rx_head++ & (SERIAL_RX_SIZE - 1)] = c;
+    }
+}
+
+int init_serial(void) {
+#if SERIAL_DEBUG
+    /* No UART behind the port: the scratch register does not keep a value */
+    outb(SERIAL_COM1 + SERIAL_SCRATCH, 0x5A);
+    if (inb(SERIAL_COM1 + SERIAL_SCRATCH) != 0x5A) return 0;
+
+    outb(SERIAL_COM1 + SERIAL_IER, 0);
+    outb(SERIAL_COM1 + SERIAL_LCR, SERIAL_LCR_DLAB);
+    outb(SERIAL_COM1 + SERIAL_DLL, SERIAL_DIVISOR & 0xff);
+    outb(SERIAL_COM1 + SERIAL_DLM, SERIAL_DIVISOR >> 8);
+    outb(SERIAL_COM1 + SERIAL_LCR, SERIAL_LCR_8N1);
+    outb(SERIAL_COM1 + SERIAL_FCR, SERIAL_FCR_INIT);
+    outb(SERIAL_COM1 + SERIAL_MCR, SERIAL_MCR_INIT);
+    outb(SERIAL_COM1 + SERIAL_IER, SERIAL_RX ? SERIAL_IER_TX | SERIAL_IER_RX : SERIAL_IER_TX);
+
+    /* Clear anything latched while the port was unconfigured */
+    inb(SERIAL_COM1 + SERIAL_LSR);
+    inb(SERIAL_COM1 + SERIAL_MSR);
+    inb(SERIAL_COM1 + SERIAL_IIR);
+    drain_rx();
+
+    pic_mask &= ~PIC_IRQ_COM1;
+    present = 1;
+#endif
+    return present;
+}
+
+int serial_present(void) {
+    return present;
+}
+
+int serial_write(const char *buffer, int size) {
+    if (!present) return 0;
+
+    unsigned long flags = spin_lock_irqsave(&serial_lock);
+
+    for (int i = 0; i < size; i++) {
+        /* Full: the interrupt may be held off, so feed the FIFO here */
+        while (tx_head - tx_tail == SERIAL_TX_SIZE) {
+            if (fifo_empty()) start_tx();
+        }
+        tx_ring[tx_head++ & (SERIAL_TX_SIZE - 1)] = buffer[i];
+    }
+
+    /* An idle transmitter raises no interrupt: start it */
+    if (!tx_busy) start_tx();
+
+    spin_unlock_irqrestore(&serial_lock, flags);
+    return size;
+}
+
+int serial_read(char *buffer, int size) {
+    if (!present) return -ENODEV;
+
+    unsigned long flags = spin_lock_irqsave(&serial_lock);
+
+    int n = 0;
+    while (n < size && rx_tail != rx_head) buffer[n++] = rx_ring[rx_tail++ & (SERIAL_RX_SIZE - 1)];
+
+    spin_unlock_irqrestore(&serial_lock, flags);
+    return n;
+}
+
+void serial_routine(void) {
+    cpuload_idle_exit();
+
+    unsigned long flags = spin_lock_irqsave(&serial_lock);
+
+    unsigned char iir;
+    while (!((iir = inb(SERIAL_COM1 + SERIAL_IIR)) & SERIAL_IIR_NONE)) {
+        switch (iir & SERIAL_IIR_ID) {
+        case SERIAL_IIR_TX:
+            /* A writer waiting on a full ring may have refilled it meanwhile */
+            if (fifo_empty()) start_tx();
+            break;
+        case SERIAL_IIR_RX:
+        case SERIAL_IIR_TIMEOUT:
+            drain_rx();
+            break;
+        case SERIAL_IIR_LSR:
+            inb(SERIAL_COM1 + SERIAL_LSR);
+            break;
+        default:
+            inb(SERIAL_COM1 + SERIAL_MSR);
+            break;
+        }
+    }
+
+    spin_unlock_irqrestore(&serial_lock, flags);
+    do_softirq();
+}
@@ -0,0 +1,133 @@
+/**
+ * @file smp.c
+ * @brief Multiprocessor detection for ZeOS.
+ *
+ * This file scans the BIOS memory for the Intel MP floating pointer and
+ * walks the MP configuration table to enumerate processors. Only the
+ * first megabyte is identity mapped, so tables outside it are ignored.
+ * The processors found are recorded, not started (see smp.h).
+ */
+
+#include <io.h>
+#include <mm_address.h>
+#include <smp.h>
+#include <types.h>
+
+struct cpu_info cpus[NR_CPUS];
+int nr_cpus = 1;
+int smp_has_apic = 0;
+
+/* MP floating pointer structure (16 bytes) */
+struct mp_float {
+    DWord signature;
+    DWord config_addr;
+    Byte length;
+    Byte revision;
+    Byte checksum;
+    Byte features[5];
+};
+
+/* MP configuration table header (44 bytes) */
+struct mp_config {
+    DWord signature;
+    Word length;
+    Byte revision;
+    Byte checksum;
+    char oem[20];
+    DWord oem_table;
+    Word oem_size;
+    Word entry_count;
+    DWord lapic_addr;
+    Word ext_length;
+    Byte ext_checksum;
+    Byte reserved;
+};
+
+/* Processor entry of the MP configuration table (20 bytes) */
+struct mp_processor {
+    Byte type;
+    Byte apic_id;
+    Byte apic_version;
+    Byte flags;
+    DWord signature;
+    DWord features;
+    DWord reserved[2];
+};
+
+/* Sizes of the remaining entry types (bus, I/O APIC, interrupts) */
+#define MP_ENTRY_OTHER_SIZE 8
+
+/* Highest physical address the kernel can read through the identity map */
+#define SMP_MAPPED_LIMIT (NUM_PAG_KERNEL << 12)
+
+static int checksum_ok(Byte *p, int len) {
+    Byte sum = 0;
+    for (int i = 0; i < len; i++) sum += p[i];
+    return sum == 0;
+}
+
+static struct mp_float *find_mp_float(unsigned long start, unsigned long len) {
+    for (unsigned long addr = start; addr < start + len; addr += 16) {
+        struct mp_float *mpf = (struct mp_float *)addr;
+        if (mpf->signature == MP_FLOAT_SIGNATURE && mpf->length == 1 &&
+            checksum_ok((Byte *)mpf, sizeof(struct mp_float)))
+            return mpf;
+    }
+    return NULL;
+}
+
+static void parse_mp_config(struct mp_config *cfg) {
+    Byte *entry = (Byte *)(cfg + 1);
+    int next_ap = 1; /* cpus[0] is reserved for the bootstrap processor */
+
+    for (int i = 0; i < cfg->entry_count; i++) {
+        if (*entry != MP_ENTRY_PROCESSOR) {
+            entry += MP_ENTRY_OTHER_SIZE;
+            continue;
+        }
+
+        struct mp_processor *proc = (struct mp_processor *)entry;
+        entry += sizeof(struct mp_processor);
+        if (!(proc->flags & MP_CPU_ENABLED)) continue;
+
+        if (proc->flags & MP_CPU_BSP) {
+            cpus[0].apic_id = proc->apic_id;
+        } else if (next_ap < NR_CPUS) {
+            cpus[next_ap].apic_id = proc->apic_id;
+            cpus[next_ap].is_bsp = 0;
+            cpus[next_ap].online = 0; /* Application processors are not started */
+            next_ap++;
+        }
+    }
+
+    nr_cpus = next_ap;
+}
+
+void init_smp(void) {
+    unsigned int eax = 1, ebx, ecx, edx;
+    __asm__ __volatile__("cpuid" : "+a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx));
+    smp_has_apic = (edx & CPUID_EDX_APIC) != 0;
+
+    /* Until a table says otherwise, the only CPU is the one running this code */
+    cpus[0].apic_id = ebx >> 24;
+    cpus[0].is_bsp = 1;
+    cpus[0].online = 1;
+    nr_cpus = 1;
+
+    /* The floating pointer lives in the last KB of base memory or in the BIOS ROM */
+    struct mp_float *mpf = find_mp_float(0x9fc00, 0x400);
+    if (mpf == NULL) mpf = find_mp_float(0xf0000, 0x10000);
+
+    if (mpf != NULL && mpf->config_addr != 0 &&
+        mpf->config_addr + sizeof(struct mp_config) <= SMP_MAPPED_LIMIT) {
+        struct mp_config *cfg = (struct mp_config *)mpf->config_addr;
+        if (cfg->signature == MP_CONFIG_SIGNATURE &&
+            mpf->config_addr + cfg->length <= SMP_MAPPED_LIMIT &&
+            checksum_ok((Byte *)cfg, cfg->length))
+            parse_mp_config(cfg);
+    }
+
+    printk_color_fmt(INFO_COLOR,
+                     "SMP: %d CPU(s) detected, local APIC %s, APs not started: running on CPU 0\n",
+                     nr_cpus, smp_has_apic ? "present" : "absent");
+}
@@ -0,0 +1,96 @@
+/**
+ * @file softirq.c
+ * @brief Softirq dispatch and the tasklet queue.
+ */
+
+#include <irqsoff.h>
+#include <softirq.h>
+#include <spinlock.h>
+
+static void tasklet_softirq(void);
+
+static void (*softirq_handlers[NR_SOFTIRQS])(void) = {
+    [SOFTIRQ_TASKLET] = tasklet_softirq,
+};
+
+/* Bit nr set while softirq nr waits to run */
+static volatile unsigned int pending = 0;
+
+/* 1 while do_softirq runs the handlers */
+static int running = 0;
+
+/* Queued tasklets, oldest first */
+static struct tasklet *tasklet_head = 0;
+static struct tasklet **tasklet_tail = &tasklet_head;
+static spinlock_t tasklet_lock = SPINLOCK_INIT;
+
+void open_softirq(int nr, void (*handler)(void)) {
+    softirq_handlers[nr] = handler;
+}
+
+void raise_softirq(int nr) {
+    /* One instruction, so a raise from task context cannot lose an interrupt's */
+    __asm__ __volatile__("lock; orl %1, %0" : "+m"(pending) : "r"(1 << nr) : "memory");
+}
+
+int softirq_pending(void) {
+    return pending != 0;
+}
+
+int in_softirq(void) {
+    return running;
+}
+
+void do_softirq(void) {
+    if (running || !pending) return;
+    running = 1;
+
+    for (int pass = 0; pending && pass < SOFTIRQ_MAX_RESTART; pass++) {
+        unsigned int raised = pending;
+        pending = 0;
+
+        irqsoff_enabled();
+        __asm__ __volatile__("sti" : : : "memory");
+
+        for (int nr = 0; nr < NR_SOFTIRQS; nr++) {
+            if ((raised & (1 << nr)) && softirq_handlers[nr]) softirq_handlers[nr]();
+        }
+
+        __asm__ __volatile__("cli" : : : "memory");
+        irqsoff_disabled();
+    }
+
+    running = 0;
+}
+
+/* SOFTIRQ_TASKLET: run the tasklets queued so far */
+static void tasklet_softirq(void) {
+    unsigned long flags = spin_lock_irqsave(&tasklet_lock);
+    struct tasklet *t = tasklet_head;
+    tasklet_head = 0;
+    tasklet_tail = &tasklet_head;
+    spin_unlock_irqrestore(&tasklet_lock, flags);
+
+    while (t) {
+        struct tasklet *next = t->next;
+
+        /* Cleared first: the tasklet may queue itself again */
+        t->scheduled = 0;
+        t->func(t->data);
+        t = next;
+    }
+}
+
+void tasklet_schedule(struct tasklet *t) {
+    unsigned long flags = spin_lock_irqsave(&tasklet_lock);
+
+    if (!t->scheduled) {
+        t->scheduled = 1;
+        t->next = 0;
+        *tasklet_tail = t;
+        tasklet_tail = &t->next;
+        raise_softirq(SOFTIRQ_TASKLET);
+    }
+
+    spin_unlock_irqrestore(&tasklet_lock, flags);
+}
@@ -7,20 +7,33 @@
  * process synchronization (block, unblock), and system information.
  */
 
+#include <clock.h>
+#include <cpuload.h>
 #include <debug.h>
 #include <devices.h>
+#include <edf.h>
 #include <errno.h>
+#include <fpu.h>
 #include <interrupt.h>
 #include <io.h>
+#include <irqsoff.h>
 #include <kernel_helpers.h>
 #include <keyboard.h>
+#include <klog.h>
 #include <libc.h>
 #include <mm.h>
 #include <mm_address.h>
+#include <profiler.h>
 #include <sched.h>
 #include <screen.h>
+#include <serial.h>
+#include <smp.h>
 #include <sys.h>
+#include <syscall_stats.h>
+#include <trace.h>
+#include <uring.h>
 #include <utils.h>
+#include <vdso.h>
 
 /* Kernel buffer for system operations */
 char buffer_k[SYS_BUFFER_SIZE];
@@ -106,6 +119,9 @@ int sys_fork(void) {
                    get_frame(parent_PT, PAG_LOG_INIT_CODE + page));
     }
 
+    /* Kernel page with the time and thread IDs (read-only) */
+    vdso_map(child_task);
+
     /*=== STEP f: Inherit user data === */
     /* Use FORK_TEMP_MAPPING_PAGE at end of address space to avoid conflicts with thread stacks */
     unsigned int temp_pages = FORK_TEMP_MAPPING_PAGE;
@@ -123,6 +139,9 @@ int sys_fork(void) {
 
         /* f.C) Remove temporary mapping */
         del_ss_pag(parent_PT, temp_pages + page);
+
+        /* Only without sibling threads: none can exit the process or reuse the temp pages */
+        if (current_task->master_thread->thread_count == 1) preempt_point();
     }
 
     // Flush TLB to ensure parent cannot access child's pages
@@ -152,17 +171,29 @@ int sys_fork(void) {
     /* Initialize blocking mechanism */
     child_task->pending_unblocks = 0;
 
+    /* Initialize process termination fields */
+    child_task->exit_code = 0;
+    child_task->wait_pid = 0;
+
     /* Initialize thread support - child starts as single-threaded process */
     child_task->thread_count = 1;
     child_task->master_thread = child_task;
     INIT_LIST_HEAD(&child_task->threads);
     INIT_LIST_HEAD(&child_task->thread_list);
     init_tid_slots(child_task);
-    child_task->TID = child_task->PID * 10; /* TID = PID*10 + 0 (master uses slot 0) */
+    child_task->TID = child_task->PID * MAX_TIDS_PER_PROCESS; /* Master uses slot 0 */
 
     /* Initialize keyboard fields - child does NOT inherit keyboard handler */
     init_keyboard_fields(child_task);
 
+    /* Child inherits a copy of the parent's FPU/SSE state */
+    fpu_fork(current_task, child_task);
+    child_task->in_preempt_point = 0;
+    child_task->uring = NULL; /* The child registers its own copy */
+
+    /* Deadline reservations are not inherited */
+    edf_init_task(child_task);
+
     /*=== STEP: Copy parent thread's user stack if it exists ===*/
     /* This is required because the calling thread may have a dedicated stack outside data+stack */
     if (current_task->user_stack_ptr != NULL && current_task->user_stack_frames > 0) {
@@ -239,11 +270,13 @@ int sys_fork(void) {
     child_task->kernel_esp = (unsigned long)&(child_union->stack[KERNEL_STACK_SIZE - 19]);
 
     /* === STEP k: Insert into ready queue === */
+    id_hash_add(child_task);
     list_add_tail(&child_task->list, &readyqueue);
+    trace_event(TRACE_CAT_PROC, TRACE_FORK, PID, child_task->TID);
 
 #if DEBUG_INFO_FORK
     printk_color_fmt(INFO_COLOR, "DEBUG->[FORK] PID %d TID %d created child PID %d TID %d\n",
-                     current_task->PID, current_task->TID, PID, PID * 10);
+                     current_task->PID, current_task->TID, PID, child_task->TID);
 #endif
 
     /* === STEP l: Return child PID === */
@@ -275,6 +308,9 @@ int sys_write(int fd, char *buffer, int size) {
             written_bytes = sys_write_debug(buffer_k, SYS_BUFFER_SIZE);
             bytes_left -= written_bytes;
             buffer += written_bytes;
+
+            /* buffer_k is free again: let pending IRQs in */
+            preempt_point();
         }
 
         if (bytes_left > 0) {
@@ -295,6 +331,9 @@ int sys_write(int fd, char *buffer, int size) {
         written_bytes = sys_write_console(buffer_k, SYS_BUFFER_SIZE);
         bytes_left -= written_bytes;
         buffer += written_bytes;
+
+        /* buffer_k is free again: let pending IRQs in */
+        preempt_point();
     }
 
     if (bytes_left > 0) {
@@ -310,12 +349,96 @@ int sys_gettime(void) {
     return zeos_ticks;
 }
 
-void sys_exit(void) {
+int sys_clock_gettime(int clock_id, struct timespec *tp) {
+    if (clock_id != CLOCK_MONOTONIC) return -EINVAL;
+    if (!access_ok(VERIFY_WRITE, tp, sizeof(struct timespec))) return -EFAULT;
+
+    struct timespec now;
+    clock_monotonic(&now);
+    copy_to_user(&now, tp, sizeof(struct timespec));
+    return 0;
+}
+
+int sys_set_tick_rate(int hz) {
+    if (in_keyboard_context()) {
+        return -EINPROGRESS;
+    }
+
+    /* 0 only reports the current rate */
+    if (hz == 0) return ticks_per_second();
+    return clock_set_rate(hz);
+}
+
+int sys_clock_getstats(struct clock_stats *stats) {
+    if (in_keyboard_context()) {
+        return -EINPROGRESS;
+    }
+
+    if (!access_ok(VERIFY_WRITE, stats, sizeof(struct clock_stats))) return -EFAULT;
+
+    struct clock_stats kstats;
+    clock_get_stats(&kstats);
+    copy_to_user(&kstats, stats, sizeof(struct clock_stats));
+    return 0;
+}
+
+int sys_get_cpu_stats(struct cpu_stats *stats) {
+    if (in_keyboard_context()) {
+        return -EINPROGRESS;
+    }
+
+    if (!access_ok(VERIFY_WRITE, stats, sizeof(struct cpu_stats))) return -EFAULT;
+
+    struct cpu_stats kstats;
+    cpuload_get(&kstats);
+    copy_to_user(&kstats, stats, sizeof(struct cpu_stats));
+    return 0;
+}
+
+int sys_serial_read(char *buffer, int size) {
+    if (in_keyboard_context()) {
+        return -EINPROGRESS;
+    }
+
+    if (size < 0) return -EINVAL;
+    if (size > SERIAL_RX_SIZE) size = SERIAL_RX_SIZE;
+    if (!access_ok(VERIFY_WRITE, buffer, size)) return -EFAULT;
+
+    char kbuffer[SERIAL_RX_SIZE];
+    int n = serial_read(kbuffer, size);
+    if (n > 0) copy_to_user(kbuffer, buffer, n);
+    return n;
+}
+
+int sys_dmesg(char *buffer, int size) {
+    if (in_keyboard_context()) {
+        return -EINPROGRESS;
+    }
+
+    if (size < 0) return -EINVAL;
+    if (!access_ok(VERIFY_WRITE, buffer, size)) return -EFAULT;
+
+    return klog_read(buffer, size);
+}
+
+int sys_set_present_mode(int fd, int mode) {
+    if (in_keyboard_context()) {
+        return -EINPROGRESS;
+    }
+
+    if (fd != FD_SCREEN) return -EBADF;
+    return screen_set_present(mode);
+}
+
+void sys_exit(int status) {
+    trace_event(TRACE_CAT_PROC, TRACE_EXIT, status, 0);
+
 #if DEBUG_INFO_EXIT
-    printk_color_fmt(INFO_COLOR, "DEBUG->[EXIT] PID %d TID %d calling exit\n", current_task->PID,
-                     current_task->TID);
+    printk_color_fmt(INFO_COLOR, "DEBUG->[EXIT] PID %d TID %d calling exit(%d)\n",
+                     current_task->PID, current_task->TID, status);
 #endif
     struct task_struct *master = current_task->master_thread;
+    struct task_struct *parent = master->parent;
 
     /* === STEP 1: Free all threads in the process === */
     if (!list_empty(&master->threads)) {
@@ -328,6 +451,13 @@ void sys_exit(void) {
 
             /* Free TID slot */
             free_tid(master, thread->TID);
+            id_hash_del(thread);
+
+            /* Children forked by this thread become orphans */
+            reparent_children(thread, idle_task);
+
+            fpu_release(thread);
+            edf_release(thread);
 
             list_del(&thread->thread_list);
 
@@ -340,20 +470,9 @@ void sys_exit(void) {
     }
 
     /* === STEP 2: Handle orphaned children === */
-    struct list_head *pos, *tmp;
-    list_for_each_safe(pos, tmp, &current_task->children) {
-        struct task_struct *child = list_entry(pos, struct task_struct, child_list);
-        list_del(&child->child_list);
-        child->parent = idle_task;
-        list_add_tail(&child->child_list, &idle_task->children);
-    }
+    reparent_children(master, idle_task);
 
-    /* === STEP 3: Remove from parent's children list === */
-    if (current_task->parent != NULL) {
-        list_del(&current_task->child_list);
-    }
-
-    /* === STEP 4: Free process resources === */
+    /* === STEP 3: Free process resources === */
     page_table_entry *PT = get_PT(master);
     for (int page = 0; page < NUM_PAG_DATA; page++) {
         int frame = get_frame(PT, PAG_LOG_INIT_DATA + page);
@@ -363,16 +482,104 @@ void sys_exit(void) {
         }
     }
 
-    /* === STEP 5: Return master task_struct to free queue === */
-    list_add_tail(&master->list, &freequeue);
-
     /* Clean up keyboard handler if registered */
     cleanup_kbd_handler(current_task);
+    kbd_ring_release(master);
+    kbd_state_unmap(master);
+    vdso_unmap(master);
+    screen_release(master);
+
+    fpu_release(master);
+    edf_release(master);
+
+    /* === STEP 4: Turn the master into a zombie or free it === */
+    /* The master may still be queued if another thread called exit */
+    if (master->status != ST_RUN) {
+        list_del(&master->list);
+    }
+    master->exit_code = status;
+
+    if (parent != NULL && parent != idle_task) {
+        /* Keep the task_struct in the parent's children list until reaped */
+        master->status = ST_ZOMBIE;
+        master->wait_pid = 0;
+
+        /* Wake the parent directly if it is blocked waiting for us */
+        if (parent->status == ST_BLOCKED &&
+            (parent->wait_pid == -1 || parent->wait_pid == master->PID)) {
+            update_process_state_rr(parent, &readyqueue);
+        }
+    } else {
+        /* Nobody will wait for this process: release it now */
+        if (parent != NULL) {
+            list_del(&master->child_list);
+        }
+        id_hash_del(master);
+        list_add_tail(&master->list, &freequeue);
+    }
 
-    /* === STEP 6: Schedule new process (will go to idle if no processes left) === */
+    /* === STEP 5: Schedule new process (will go to idle if no processes left) === */
     sched_next_rr();
 }
 
+int sys_waitpid(int pid, int *status, int options) {
+    /* Cannot wait from keyboard handler context */
+    if (in_keyboard_context()) {
+        return -EINPROGRESS;
+    }
+
+    if (pid == 0 || pid < -1) return -EINVAL;
+    if (options & ~WNOHANG) return -EINVAL;
+    if (status != NULL && !access_ok(VERIFY_WRITE, status, sizeof(int))) return -EFAULT;
+
+    while (1) {
+        struct list_head *pos;
+        struct task_struct *zombie = NULL;
+        int found = 0;
+
+        if (pid != -1) {
+            /* Direct lookup: the process must be a child of this thread */
+            struct task_struct *child = find_task_by_pid(pid);
+            if (child != NULL && child->parent == current_task) {
+                found = 1;
+                if (child->status == ST_ZOMBIE) zombie = child;
+            }
+        } else {
+            /* Search for any child, preferring one that already exited */
+            list_for_each(pos, &current_task->children) {
+                struct task_struct *child = list_entry(pos, struct task_struct, child_list);
+                found = 1;
+                if (child->status == ST_ZOMBIE) {
+                    zombie = child;
+                    break;
+                }
+            }
+        }
+
+        if (!found) return -ECHILD;
+
+        if (zombie != NULL) {
+            int child_pid = zombie->PID;
+            int code = zombie->exit_code;
+
+            release_zombie(zombie);
+
+            if (status != NULL) {
+                copy_to_user(&code, status, sizeof(int));
+            }
+            return child_pid;
+        }
+
+        if (options & WNOHANG) return 0;
+
+        /* Block until a matching child exits; sys_exit wakes us directly */
+        current_task->wait_pid = pid;
+        update_process_state_rr(current_task, &blockedqueue);
+        sched_next_rr();
+        current_task->wait_pid = 0;
+    }
+}
+
 int sys_block(void) {
     /* Cannot block from keyboard handler context */
     if (in_keyboard_context()) {
@@ -402,28 +609,85 @@ int sys_waitfortick(void) {
     return 0;
 }
 
+int sys_yield(void) {
+    /* Cannot yield from keyboard handler context */
+    if (in_keyboard_context()) {
+        return -EINPROGRESS;
+    }
+
+    /* Give up the CPU only if someone else can use it: a round robin thread or a due EDF job */
+    if (!list_empty(&readyqueue) || edf_needs_preempt()) {
+        update_process_state_rr(current_task, &readyqueue);
+        sched_next_rr();
+    }
+    return 0;
+}
+
+int sys_sched_setdeadline(int period, int runtime, int deadline) {
+    /* Cannot change scheduling class from keyboard handler context */
+    if (in_keyboard_context()) {
+        return -EINPROGRESS;
+    }
+
+    return edf_set_params(period, runtime, deadline);
+}
+
+int sys_sched_waitperiod(void) {
+    /* Cannot block from keyboard handler context */
+    if (in_keyboard_context()) {
+        return -EINPROGRESS;
+    }
+
+    return edf_wait_period();
+}
+
+int sys_sched_getstats(int tid, struct sched_stats *stats) {
+    if (in_keyboard_context()) {
+        return -EINPROGRESS;
+    }
+
+    if (!access_ok(VERIFY_WRITE, stats, sizeof(struct sched_stats))) return -EFAULT;
+
+    /* TID 0 means the calling thread; others must belong to the same process */
+    struct task_struct *task = (tid == 0) ? current_task : find_task_by_tid(tid);
+    if (task == NULL || task->PID != current_task->PID) return -ESRCH;
+
+    struct sched_stats kstats;
+    edf_get_stats(task, &kstats);
+    copy_to_user(&kstats, stats, sizeof(struct sched_stats));
+    return 0;
+}
+
+/* 1 if task sleeps in block(), not in waitpid, WaitForTick or an EDF period */
+static int blocked_in_block(struct task_struct *task) {
+    if (task->status != ST_BLOCKED || task->wait_pid != 0) return 0;
+
+    struct list_head *pos;
+    list_for_each(pos, &blockedqueue) {
+        if (list_head_to_task_struct(pos) == task) return 1;
+    }
+    return 0;
+}
+
 int sys_unblock(int pid) {
     /* Cannot unblock from keyboard handler context */
     if (in_keyboard_context()) {
         return -EINPROGRESS;
     }
 
-    struct list_head *pos;
+    /* Look the PID up directly; it must be a child of this thread */
+    struct task_struct *child = find_task_by_pid(pid);
+    if (child == NULL || child->parent != current_task) {
+        return -ESRCH;
+    }
 
-    /* Search for child with given PID */
-    list_for_each(pos, &current_task->children) {
-        struct task_struct *child = list_entry(pos, struct task_struct, child_list);
-        if (child->PID == pid) {
-            if (child->status == ST_BLOCKED) {
-                update_process_state_rr(child, &readyqueue);
-                return 0;
-            } else {
-                child->pending_unblocks++;
-                return 0;
-            }
-        }
+    /* Other sleeps end on their own event: the unblock is kept for the next block() */
+    if (blocked_in_block(child)) {
+        update_process_state_rr(child, &readyqueue);
+    } else {
+        child->pending_unblocks++;
     }
-    return -ESRCH;
+    return 0;
 }
 
 int sys_create_thread(void (*function)(void *), void *parameter, void (*wrapper)(void)) {
@@ -477,6 +741,8 @@ int sys_create_thread(void (*function)(void *), void *parameter, void (*wrapper)
     new_thread->quantum = DEFAULT_QUANTUM;
     new_thread->status = ST_READY;
     new_thread->pending_unblocks = 0;
+    new_thread->exit_code = 0;
+    new_thread->wait_pid = 0;
     new_thread->user_stack_ptr = NULL;
     new_thread->user_stack_frames = 0;
     new_thread->user_stack_region_start = 0;
@@ -487,6 +753,14 @@ int sys_create_thread(void (*function)(void *), void *parameter, void (*wrapper)
     /* Initialize keyboard fields - threads share master's keyboard handler */
     init_keyboard_fields(new_thread);
 
+    /* New threads start with a clean FPU state */
+    fpu_init_task(new_thread);
+    new_thread->in_preempt_point = 0;
+    new_thread->uring = NULL;
+
+    /* New threads start in the round robin class */
+    edf_init_task(new_thread);
+
     int region_start = find_free_stack_region(master);
     if (region_start < 0) {
         free_tid(master, new_tid);
@@ -553,8 +827,10 @@ int sys_create_thread(void (*function)(void *), void *parameter, void (*wrapper)
 
     master->thread_count++;
     list_add_tail(&new_thread->thread_list, &master->threads);
+    id_hash_add(new_thread);
 
     list_add_tail(&new_thread->list, &readyqueue);
+    trace_event(TRACE_CAT_PROC, TRACE_THREAD_CREATE, new_thread->TID, 0);
 
 #if DEBUG_INFO_THREAD_CREATE
     printk_color_fmt(INFO_COLOR, "DEBUG->[THREAD_CREATE] PID %d created TID %d\n", new_thread->PID,
@@ -568,6 +844,8 @@ void sys_exit_thread(void) {
     struct task_struct *thread = current_task;
     struct task_struct *master = thread->master_thread;
 
+    trace_event(TRACE_CAT_PROC, TRACE_THREAD_EXIT, thread->TID, 0);
+
 #if DEBUG_INFO_THREAD_EXIT
     printk_color_fmt(INFO_COLOR,
                      "DEBUG->[THREAD_EXIT] PID %d TID %d exiting (master has %d threads)\n",
@@ -576,14 +854,17 @@ void sys_exit_thread(void) {
 
     /* If this is the only thread, terminate the whole process (including init) */
     if (master->thread_count == 1) {
-        sys_exit();
+        sys_exit(0);
         return; /* Normally not reached */
     }
 
     release_thread_stack(thread);
+    fpu_release(thread);
+    edf_release(thread);
 
     /* Free TID slot */
     free_tid(master, thread->TID);
+    id_hash_del(thread);
 
     /* Decrement thread count */
     master->thread_count--;
@@ -593,6 +874,8 @@ void sys_exit_thread(void) {
 
     /* If we are exiting a non-master thread, just free it */
     if (thread != master) {
+        /* Children forked by this thread now belong to the master */
+        reparent_children(thread, master);
         list_add_tail(&thread->list, &freequeue);
         sched_next_rr();
         return;
@@ -612,21 +895,32 @@ void sys_exit_thread(void) {
 
     if (new_master == NULL) {
         /* Fallback: no other thread found, destroy process */
-        sys_exit();
+        sys_exit(0);
         return;
     }
 
     /* Transfer master role to new_master */
     new_master->master_thread = new_master;
     new_master->thread_count = master->thread_count;
+    new_master->kbd_ring = master->kbd_ring;
+    new_master->uring = master->uring;
 
-    /* Copy TID slots to new master (array size is MAX_TIDS_PER_PROCESS: indices 0-9) */
-    for (int i = 0; i < MAX_TIDS_PER_PROCESS; i++) {
-        new_master->tid_slots[i] = master->tid_slots[i];
+    /* Copy the TID bitmap to new master (the old master's TID was freed above) */
+    for (int i = 0; i < TID_BITMAP_WORDS; i++) {
+        new_master->tid_bitmap[i] = master->tid_bitmap[i];
     }
 
-    /* Free old master TID slot (TID = PID*10 + slot) */
-    free_tid(new_master, master->TID);
+    /* The PID now resolves to the new master */
+    id_hash_del(new_master);
+    id_hash_add(new_master);
+
+    /* Hand the process hierarchy over to the new master */
+    new_master->parent = master->parent;
+    if (master->parent != NULL) {
+        list_del(&master->child_list);
+        list_add_tail(&new_master->child_list, &master->parent->children);
+    }
+    reparent_children(master, new_master);
 
     /* Remove new_master from thread list and rebuild as master */
     list_del(&new_master->thread_list);
@@ -651,7 +945,126 @@ void sys_exit_thread(void) {
     sched_next_rr();
 }
 
-int sys_keyboard_event(void (*func)(char key, int pressed), void (*wrapper)(void)) {
+int sys_read_keys(struct kbd_event *buf, int n, int timeout) {
+    /* Cannot block from keyboard handler context */
+    if (in_keyboard_context()) {
+        return -EINPROGRESS;
+    }
+
+    if (n < 0 || timeout < KBD_WAIT_FOREVER) return -EINVAL;
+    /* The ring never holds more; a larger n could also wrap the size checked */
+    if (n > KBD_RING_SIZE) n = KBD_RING_SIZE;
+    if (!access_ok(VERIFY_WRITE, buf, n * sizeof(struct kbd_event))) return -EFAULT;
+
+    return kbd_read_events(buf, n, timeout);
+}
+
+int sys_ring_setup(struct uring *ring) {
+    if (in_keyboard_context()) {
+        return -EINPROGRESS;
+    }
+
+    return uring_setup(ring);
+}
+
+int sys_ring_enter(int to_submit) {
+    /* Operations may block: not from keyboard handler context */
+    if (in_keyboard_context()) {
+        return -EINPROGRESS;
+    }
+
+    return uring_enter(to_submit);
+}
+
+int sys_get_syscall_stats(int nr, int pid, struct syscall_stats *stats) {
+    if (in_keyboard_context()) {
+        return -EINPROGRESS;
+    }
+
+    if (nr < 0 || nr >= NR_SYSCALLS || pid < 0) return -EINVAL;
+    if (!access_ok(VERIFY_WRITE, stats, sizeof(struct syscall_stats))) return -EFAULT;
+
+    struct syscall_stats kstats;
+    int ret = syscall_stats_get(nr, pid, &kstats);
+    if (ret < 0) return ret;
+
+    copy_to_user(&kstats, stats, sizeof(struct syscall_stats));
+    return 0;
+}
+
+int sys_prof_start(int period) {
+    if (in_keyboard_context()) {
+        return -EINPROGRESS;
+    }
+
+    return prof_start(period);
+}
+
+int sys_prof_stop(void) {
+    if (in_keyboard_context()) {
+        return -EINPROGRESS;
+    }
+
+    return prof_stop();
+}
+
+int sys_prof_read(struct prof_sample *buf, int n) {
+    if (in_keyboard_context()) {
+        return -EINPROGRESS;
+    }
+
+    if (n < 0) return -EINVAL;
+    /* The rings never hold more; a larger n could also wrap the size checked */
+    if (n > PROF_RING_SIZE * nr_cpus) n = PROF_RING_SIZE * nr_cpus;
+    if (!access_ok(VERIFY_WRITE, buf, n * sizeof(struct prof_sample))) return -EFAULT;
+
+    return prof_read(buf, n);
+}
+
+int sys_trace_ctl(int mask) {
+    if (in_keyboard_context()) {
+        return -EINPROGRESS;
+    }
+
+    return trace_ctl(mask);
+}
+
+int sys_trace_read(struct trace_record *buf, int n) {
+    if (in_keyboard_context()) {
+        return -EINPROGRESS;
+    }
+
+    if (n < 0) return -EINVAL;
+    /* The ring never holds more; a larger n could also wrap the size checked */
+    if (n > TRACE_RING_SIZE) n = TRACE_RING_SIZE;
+    if (!access_ok(VERIFY_WRITE, buf, n * sizeof(struct trace_record))) return -EFAULT;
+
+    return trace_read(buf, n);
+}
+
+int sys_irqsoff_read(struct irqsoff_stats *stats, int reset) {
+    if (in_keyboard_context()) {
+        return -EINPROGRESS;
+    }
+
+    if (!access_ok(VERIFY_WRITE, stats, sizeof(struct irqsoff_stats))) return -EFAULT;
+
+    struct irqsoff_stats kstats;
+    irqsoff_get(&kstats, reset);
+    copy_to_user(&kstats, stats, sizeof(struct irqsoff_stats));
+    return 0;
+}
+
+int sys_keyboard_state(void) {
+    if (in_keyboard_context()) {
+        return -EINPROGRESS;
+    }
+
+    return kbd_state_map();
+}
+
+/* Register func as the keyboard handler of the current thread */
+static int register_kbd_handler(void *func, void (*wrapper)(void), int batch) {
     struct task_struct *task = current_task;
 
     /* Cannot register handler from within keyboard handler */
@@ -681,10 +1094,22 @@ int sys_keyboard_event(void (*func)(char key, int pressed), void (*wrapper)(void
         return ret;
     }
 
-    /* Register the handler and wrapper */
+    /* Register the handler and wrapper; events of the previous handler are dropped */
     task->kbd_handler = func;
     task->kbd_wrapper = wrapper;
+    task->kbd_batch = batch;
+    task->kbd_queued = 0;
     task->in_kbd_context = 0;
 
     return 0;
 }
+
+int sys_keyboard_event(void (*func)(char key, int pressed), void (*wrapper)(void)) {
+    return register_kbd_handler(func, wrapper, 0);
+}
+
+int sys_keyboard_event_batch(void (*func)(struct kbd_event *events, int count),
+                             void (*wrapper)(void)) {
+    /* The wrapper passes its two arguments through, so it calls func(events, count) */
+    return register_kbd_handler(func, wrapper, 1);
+}
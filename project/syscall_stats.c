@@ -0,0 +1,111 @@
+/**
+ * @file syscall_stats.c
+ * @brief Per-syscall counters and latency histograms for ZeOS.
+ *
+ * This file implements the instrumented syscall dispatch and the
+ * queries behind the get_syscall_stats system call.
+ */
+
+#include <errno.h>
+#include <sched.h>
+#include <syscall_stats.h>
+#include <trace.h>
+#include <utils.h>
+
+typedef int (*syscall_fn)(unsigned long, unsigned long, unsigned long, unsigned long,
+                          unsigned long);
+
+extern syscall_fn sys_call_table[];
+
+/* Per thread slot figures (no histogram) */
+struct syscall_counter {
+    unsigned int calls;
+    unsigned int max_cycles;
+    unsigned long long cycles;
+};
+
+/* System-wide figures */
+static struct syscall_stats sc_global[NR_SYSCALLS];
+
+/* Figures of each task slot and the PID they belong to (0 if unused) */
+static struct syscall_counter sc_task[NR_TASKS][NR_SYSCALLS];
+static int sc_task_pid[NR_TASKS];
+
+static inline unsigned long long read_tsc(void) {
+    unsigned int low, high;
+    rdtsc(low, high);
+    return ((unsigned long long)high << 32) | low;
+}
+
+/* Index of the highest set bit (0 for 0 and 1) */
+static int log2_bucket(unsigned int cycles) {
+    return cycles ? 31 - __builtin_clz(cycles) : 0;
+}
+
+int syscall_dispatch(unsigned long ebx, unsigned long ecx, unsigned long edx, unsigned long esi,
+                     unsigned long edi, unsigned long ebp, int nr) {
+    (void)ebp;
+
+    /* A reused task slot starts counting again for its new process */
+    int slot = get_task_index(current_task);
+    if (sc_task_pid[slot] != current_task->PID) {
+        for (int i = 0; i < NR_SYSCALLS; i++) {
+            sc_task[slot][i].calls = 0;
+            sc_task[slot][i].max_cycles = 0;
+            sc_task[slot][i].cycles = 0;
+        }
+        sc_task_pid[slot] = current_task->PID;
+    }
+
+    /* Count at entry: exit never returns here */
+    if (nr < NR_SYSCALLS) {
+        sc_global[nr].calls++;
+        sc_task[slot][nr].calls++;
+    }
+
+    trace_event(TRACE_CAT_SYSCALL, TRACE_SYSCALL_ENTRY, nr, ebx);
+    unsigned long long start = read_tsc();
+    int ret = sys_call_table[nr](ebx, ecx, edx, esi, edi);
+    unsigned long long elapsed = read_tsc() - start;
+    trace_event(TRACE_CAT_SYSCALL, TRACE_SYSCALL_EXIT, nr, ret);
+
+    if (nr < NR_SYSCALLS) {
+        unsigned int cycles = (elapsed >> 32) ? 0xFFFFFFFFu : (unsigned int)elapsed;
+
+        sc_global[nr].cycles += elapsed;
+        sc_global[nr].hist[log2_bucket(cycles)]++;
+        if (cycles > sc_global[nr].max_cycles) sc_global[nr].max_cycles = cycles;
+
+        sc_task[slot][nr].cycles += elapsed;
+        if (cycles > sc_task[slot][nr].max_cycles) sc_task[slot][nr].max_cycles = cycles;
+    }
+
+    return ret;
+}
+
+int syscall_stats_get(int nr, int pid, struct syscall_stats *stats) {
+    if (pid == 0) {
+        *stats = sc_global[nr];
+        return 0;
+    }
+
+    int found = 0;
+    stats->calls = 0;
+    stats->cycles = 0;
+    stats->max_cycles = 0;
+    for (int b = 0; b < SYSCALL_HIST_BUCKETS; b++) {
+        stats->hist[b] = 0;
+    }
+
+    for (int slot = 0; slot < NR_TASKS; slot++) {
+        if (sc_task_pid[slot] != pid) continue;
+        found = 1;
+        stats->calls += sc_task[slot][nr].calls;
+        stats->cycles += sc_task[slot][nr].cycles;
+        if (sc_task[slot][nr].max_cycles > stats->max_cycles) {
+            stats->max_cycles = sc_task[slot][nr].max_cycles;
+        }
+    }
+
+    return found ? 0 : -ESRCH;
+}
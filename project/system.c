@@ -7,16 +7,23 @@
  * the transition to user mode execution.
  */
 
+#include <boot_profile.h>
+#include <clock.h>
+#include <fpu.h>
 #include <hardware.h>
 #include <interrupt.h>
 #include <io.h>
 #include <keyboard.h>
+#include <klog.h>
 #include <mm.h>
 #include <sched.h>
+#include <smp.h>
 #include <segment.h>
+#include <serial.h>
 #include <system.h>
 #include <types.h>
 #include <utils.h>
+#include <vdso.h>
 
 int (*usr_main)(void) = (void *)(PAG_LOG_INIT_CODE * PAGE_SIZE);
 unsigned int *p_sys_size = (unsigned int *)KERNEL_START;
@@ -37,28 +44,69 @@ __attribute__((__section__(".text.main"))) int main(void) {
 
     /*** DO *NOT* ADD ANY CODE IN THIS ROUTINE BEFORE THIS POINT ***/
 
+    boot_stage("firmware+loader");
+
+    /* printk output is queued in the kernel log from here on */
+    init_klog();
+
+    /* Calibrate the TSC and set the tick rate before anything waits on time */
+    init_clock();
+    boot_stage("clock");
+
     print_splash_screen();
+    boot_stage("splash");
 
     /* Initialize hardware data */
     setGdt(); /* Definition of the memory segments table */
     setIdt(); /* Definition of the interrupt vector */
     setTSS(); /* Definition of the TSS */
+    boot_stage("gdt/idt/tss");
+
+    /* Debug output goes to COM1 from here on, if there is one */
+    init_serial();
+    boot_stage("serial");
 
     /* Initialize Memory */
     init_mm();
+    boot_stage("mm");
+
+    /* Initialize lazy FPU/SSE management */
+    init_fpu();
+    boot_stage("fpu");
+
+    /* Clear the page shared with user space */
+    init_vdso();
+    boot_stage("vdso");
+
+    /* Detect processors (scheduling stays on the bootstrap CPU) */
+    init_smp();
+    boot_stage("smp");
+
+    /* Drive the tick with the local APIC timer if there is one */
+    clock_start_oneshot();
+    boot_stage("apic timer");
 
     /* Initialize Scheduling */
     init_sched();
+    boot_stage("sched");
 
     /* Initialize idle task data */
     init_idle();
+    boot_stage("idle");
     /* Initialize task 1 data */
     init_task1();
+    boot_stage("task1");
 
     /* Keyboard support is initialized per-task in init_task1/init_idle */
 
-    /* Move user code/data now (after the page table initialization) */
+    /* Move user code/data now (after the page table initialization); the code is read-only */
+    clear_wp_flag();
     copy_data((void *)KERNEL_START + *p_sys_size, (void *)L_USER_START, *p_usr_size);
+    set_wp_flag();
+    boot_stage("user image");
+
+    /* Before enabling interrupts, so the clock cannot preempt the print */
+    boot_profile_dump();
 
     printk("Entering user mode...\n\n");
 
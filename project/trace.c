@@ -0,0 +1,76 @@
+/**
+ * @file trace.c
+ * @brief Lock-free binary event ring for kernel tracepoints.
+ *
+ * This file implements the trace ring written by the tracepoints and
+ * the operations behind the trace_ctl and trace_read system calls.
+ */
+
+#include <errno.h>
+#include <sched.h>
+#include <trace.h>
+#include <utils.h>
+
+/* Keep the compiler from moving the record stores past the publication */
+#define barrier() __asm__ __volatile__("" : : : "memory")
+
+unsigned int trace_mask = 0;
+
+static struct trace_record trace_ring[TRACE_RING_SIZE];
+static volatile unsigned int trace_head = 0; /* Next record to read */
+static volatile unsigned int trace_tail = 0; /* Next slot to reserve */
+static unsigned int trace_lost = 0;          /* Drops not reported yet */
+
+void trace_record(int event, unsigned int arg0, unsigned int arg1) {
+    unsigned int slot;
+
+    /* Reserve a slot; an interrupt tracing meanwhile makes the CAS retry */
+    do {
+        slot = trace_tail;
+        if (slot - trace_head >= TRACE_RING_SIZE) {
+            __sync_fetch_and_add(&trace_lost, 1);
+            return;
+        }
+    } while (!__sync_bool_compare_and_swap(&trace_tail, slot, slot + 1));
+
+    struct trace_record *r = &trace_ring[slot % TRACE_RING_SIZE];
+    unsigned int low, high;
+    rdtsc(low, high);
+
+    unsigned int lost = __sync_lock_test_and_set(&trace_lost, 0);
+    r->tsc = ((unsigned long long)high << 32) | low;
+    r->lost = (lost > 0xFFFF) ? 0xFFFF : lost;
+    r->pid = current_task->PID;
+    r->tid = current_task->TID;
+    r->args[0] = arg0;
+    r->args[1] = arg1;
+
+    /* Publish: the reader stops at a slot whose type is still 0 */
+    barrier();
+    r->event = event;
+}
+
+int trace_ctl(int mask) {
+    if (mask & ~TRACE_CAT_ALL) return -EINVAL;
+
+    int old = trace_mask;
+    trace_mask = mask;
+    return old;
+}
+
+int trace_read(struct trace_record *buf, int n) {
+    int copied = 0;
+
+    while (copied < n && trace_head != trace_tail) {
+        struct trace_record *r = &trace_ring[trace_head % TRACE_RING_SIZE];
+        if (r->event == 0) break; /* Reserved but not published yet */
+
+        copy_to_user(r, &buf[copied], sizeof(struct trace_record));
+        r->event = 0;
+        barrier();
+        trace_head++;
+        copied++;
+    }
+
+    return copied;
+}
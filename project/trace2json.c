@@ -0,0 +1,171 @@
+/**
+ * @file trace2json.c
+ * @brief Host tool that converts ZeOS kernel traces to Chrome trace JSON.
+ *
+ * Reads the "@trace" lines written by trace_dump() to the debug port
+ * (COM1, or the Bochs port 0xe9) and writes a JSON trace viewable in
+ * chrome://tracing or Perfetto: system calls and interrupts become
+ * duration slices on the thread they ran on, the other records become
+ * instant events.
+ *
+ * Usage: ./trace2json < serial.out > trace.json (or the Bochs output without a UART)
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+/* Record types, as in include/trace_data.h */
+#define TRACE_SWITCH 1
+#define TRACE_WAKEUP 2
+#define TRACE_FORK 3
+#define TRACE_THREAD_CREATE 4
+#define TRACE_THREAD_EXIT 5
+#define TRACE_EXIT 6
+#define TRACE_PAGE_FAULT 7
+#define TRACE_IRQ_ENTRY 8
+#define TRACE_IRQ_EXIT 9
+#define TRACE_SYSCALL_ENTRY 10
+#define TRACE_SYSCALL_EXIT 11
+
+/* System call names, as in sys_call_table.S */
+static const char *syscall_names[] = {
+    [1] = "exit",           [2] = "fork",           [4] = "write",
+    [5] = "exit_thread",    [6] = "create_thread",  [7] = "waitpid",
+    [10] = "gettime",       [12] = "block",         [13] = "unblock",
+    [20] = "getpid",        [21] = "gettid",        [22] = "keyboard_event",
+    [23] = "waitfortick",   [24] = "yield",         [25] = "sched_setdeadline",
+    [26] = "sched_waitperiod", [27] = "sched_getstats", [28] = "read_keys",
+    [29] = "keyboard_event_batch", [30] = "keyboard_state", [31] = "ring_setup",
+    [32] = "ring_enter",    [33] = "get_syscall_stats", [34] = "prof_start",
+    [35] = "prof_stop",     [36] = "prof_read",     [37] = "trace_ctl",
+    [38] = "trace_read",    [39] = "irqsoff_read",
+    [40] = "clock_gettime", [41] = "set_tick_rate", [42] = "clock_getstats",
+    [43] = "get_cpu_stats", [44] = "serial_read",  [45] = "dmesg",
+    [46] = "set_present_mode",
+};
+
+static const char *irq_names[] = {"clock", "keyboard"};
+
+static const char *syscall_name(unsigned int nr) {
+    if (nr < sizeof(syscall_names) / sizeof(syscall_names[0]) && syscall_names[nr])
+        return syscall_names[nr];
+    return "syscall";
+}
+
+static const char *irq_name(unsigned int irq) {
+    return irq < sizeof(irq_names) / sizeof(irq_names[0]) ? irq_names[irq] : "irq";
+}
+
+static int first_event = 1;
+
+/* Start a JSON event object; the caller adds "args" and closes it */
+static void begin_event(const char *name, const char *ph, double ts, int pid, int tid) {
+    printf("%s\n  {\"name\": \"%s\", \"ph\": \"%s\", \"ts\": %.3f, \"pid\": %d, \"tid\": %d",
+           first_event ? "" : ",", name, ph, ts, pid, tid);
+    first_event = 0;
+}
+
+int main(void) {
+    char line[256];
+    double cycles_per_us = 0;
+    unsigned long long base = 0;
+    int have_base = 0, records = 0, lost = 0;
+
+    printf("{\"displayTimeUnit\": \"ns\", \"traceEvents\": [");
+
+    while (fgets(line, sizeof(line), stdin)) {
+        char *rec;
+        unsigned int tsc_per_tick;
+        int ticks_per_second;
+
+        if ((rec = strstr(line, "@trace-clock ")) != NULL) {
+            if (sscanf(rec, "@trace-clock %u %d", &tsc_per_tick, &ticks_per_second) == 2 &&
+                tsc_per_tick != 0)
+                cycles_per_us = (double)tsc_per_tick * ticks_per_second / 1e6;
+            continue;
+        }
+
+        unsigned int high, low, a0, a1;
+        int event, rec_lost, pid, tid;
+        if ((rec = strstr(line, "@trace ")) == NULL ||
+            sscanf(rec, "@trace %u %u %d %d %d %d %u %u", &high, &low, &event, &rec_lost, &pid,
+                   &tid, &a0, &a1) != 8)
+            continue;
+
+        /* Without calibration, show cycles as if they were microseconds */
+        unsigned long long tsc = ((unsigned long long)high << 32) | low;
+        if (!have_base) {
+            base = tsc;
+            have_base = 1;
+        }
+        double ts = (double)(tsc - base) / (cycles_per_us > 0 ? cycles_per_us : 1);
+
+        records++;
+        if (rec_lost) {
+            lost += rec_lost;
+            begin_event("records lost", "i", ts, pid, tid);
+            printf(", \"s\": \"g\", \"args\": {\"count\": %d}}", rec_lost);
+        }
+
+        switch (event) {
+        case TRACE_SYSCALL_ENTRY:
+            begin_event(syscall_name(a0), "B", ts, pid, tid);
+            printf(", \"cat\": \"syscall\", \"args\": {\"nr\": %u, \"arg0\": %u}}", a0, a1);
+            break;
+        case TRACE_SYSCALL_EXIT:
+            begin_event(syscall_name(a0), "E", ts, pid, tid);
+            printf(", \"cat\": \"syscall\", \"args\": {\"ret\": %d}}", (int)a1);
+            break;
+        case TRACE_IRQ_ENTRY:
+        case TRACE_IRQ_EXIT:
+            begin_event(irq_name(a0), event == TRACE_IRQ_ENTRY ? "B" : "E", ts, pid, tid);
+            printf(", \"cat\": \"irq\"}");
+            break;
+        case TRACE_SWITCH:
+            begin_event("switch", "i", ts, pid, tid);
+            printf(", \"cat\": \"sched\", \"s\": \"t\", \"args\": {\"next_pid\": %u, "
+                   "\"next_tid\": %u}}",
+                   a0, a1);
+            break;
+        case TRACE_WAKEUP:
+            begin_event("wakeup", "i", ts, pid, tid);
+            printf(", \"cat\": \"sched\", \"s\": \"t\", \"args\": {\"pid\": %u, \"tid\": %u}}", a0,
+                   a1);
+            break;
+        case TRACE_FORK:
+            begin_event("fork", "i", ts, pid, tid);
+            printf(", \"cat\": \"proc\", \"s\": \"t\", \"args\": {\"child_pid\": %u, "
+                   "\"child_tid\": %u}}",
+                   a0, a1);
+            break;
+        case TRACE_THREAD_CREATE:
+            begin_event("thread_create", "i", ts, pid, tid);
+            printf(", \"cat\": \"proc\", \"s\": \"t\", \"args\": {\"tid\": %u}}", a0);
+            break;
+        case TRACE_THREAD_EXIT:
+            begin_event("thread_exit", "i", ts, pid, tid);
+            printf(", \"cat\": \"proc\", \"s\": \"t\"}");
+            break;
+        case TRACE_EXIT:
+            begin_event("exit", "i", ts, pid, tid);
+            printf(", \"cat\": \"proc\", \"s\": \"p\", \"args\": {\"status\": %d}}", (int)a0);
+            break;
+        case TRACE_PAGE_FAULT:
+            begin_event("page_fault", "i", ts, pid, tid);
+            printf(", \"cat\": \"fault\", \"s\": \"t\", \"args\": {\"eip\": \"0x%x\", "
+                   "\"addr\": \"0x%x\"}}",
+                   a0, a1);
+            break;
+        default:
+            begin_event("unknown", "i", ts, pid, tid);
+            printf(", \"s\": \"t\", \"args\": {\"type\": %d}}", event);
+            break;
+        }
+    }
+
+    printf("\n]}\n");
+
+    fprintf(stderr, "trace2json: %d records, %d lost%s\n", records, lost,
+            cycles_per_us > 0 ? "" : ", no @trace-clock line: timestamps are TSC cycles");
+    return records ? 0 : 1;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file uring.c
+ * @brief Batched submission/completion rings for ZeOS.
+ *
+ * This file implements ring registration and the processing of queued
+ * operations for the ring_setup/ring_enter system calls.
+ */
+
+#include <errno.h>
+#include <sys.h>
+#include <uring.h>
+#include <utils.h>
+
+/* Run one submission and return what the equivalent syscall returns */
+static int uring_run(struct uring_sqe *sqe) {
+    switch (sqe->opcode) {
+    case URING_OP_NOP:
+        return 0;
+    case URING_OP_WRITE:
+        return sys_write(sqe->fd, sqe->buf, sqe->len);
+    case URING_OP_GETTIME:
+        return sys_gettime();
+    case URING_OP_WAITFORTICK:
+        return sys_waitfortick();
+    case URING_OP_SLEEP:
+        if (sqe->len < 0) return -EINVAL;
+        for (int i = 0; i < sqe->len; i++) {
+            sys_waitfortick();
+        }
+        return 0;
+    default:
+        return -EINVAL;
+    }
+}
+
+int uring_setup(struct uring *ring) {
+    if (ring != NULL && !access_ok(VERIFY_WRITE, ring, sizeof(struct uring))) return -EFAULT;
+
+    current_task->master_thread->uring = ring;
+    return 0;
+}
+
+int uring_enter(int to_submit) {
+    struct uring *ring = current_task->master_thread->uring;
+    int done = 0;
+
+    if (to_submit < 0) return -EINVAL;
+    if (ring == NULL) return -ENXIO;
+
+    while (done < to_submit && ring->sq_head != ring->sq_tail &&
+           ring->cq_tail - ring->cq_head < URING_ENTRIES) {
+        struct uring_sqe sqe;
+        struct uring_cqe cqe;
+
+        /* Snapshot the entry: user space may rewrite it once sq_head moves */
+        copy_from_user(&ring->sqes[ring->sq_head % URING_ENTRIES], &sqe, sizeof(sqe));
+        ring->sq_head++;
+
+        cqe.user_data = sqe.user_data;
+        cqe.res = uring_run(&sqe);
+
+        copy_to_user(&cqe, &ring->cqes[ring->cq_tail % URING_ENTRIES], sizeof(cqe));
+        ring->cq_tail++;
+        done++;
+    }
+
+    return done;
+}
@@ -6,6 +6,7 @@
  * memory operations, copying routines, and system helper functions.
  */
 
+#include <clock.h>
 #include <io.h>
 #include <mm_address.h>
 #include <times.h>
@@ -68,6 +69,13 @@ int access_ok(int type, const void *addr, unsigned long size) {
 
     unsigned long max_user_page = TOTAL_PAGES;
 
+    /* The local APIC registers are mapped in every address space */
+    if (addr_ini <= LAPIC_PAGE && addr_fin >= LAPIC_PAGE) return 0;
+
+    /* The keyboard state and vDSO pages are shared by all processes and read-only for them */
+    if (addr_ini <= KBD_STATE_PAGE && addr_fin >= KBD_STATE_PAGE) return 0;
+    if (addr_ini <= VDSO_PAGE && addr_fin >= VDSO_PAGE) return 0;
+
     switch (type) {
     case VERIFY_WRITE:
         if ((addr_ini >= USER_FIRST_PAGE) && (addr_fin < max_user_page)) return 1;
@@ -85,8 +93,11 @@ unsigned long get_ticks(void) {
 
     rdtsc(eax, edx);
 
+    unsigned long long per_tick = (unsigned long long)tsc_khz * 1000;
+    do_div(per_tick, TICKS_PER_SECOND);
+
     ticks = ((unsigned long long)edx << 32) + eax;
-    do_div(ticks, CYCLESPERTICK);
+    do_div(ticks, per_tick);
 
     return ticks;
 }
@@ -0,0 +1,73 @@
+/**
+ * @file vdso.c
+ * @brief Kernel-updated page read by libc without system calls.
+ *
+ * This file maintains the struct vdso_data published to user space:
+ * the tick counter and TSC calibration from the clock interrupt, and
+ * the running thread's IDs from the context switch.
+ */
+
+#include <clock.h>
+#include <interrupt.h>
+#include <mm.h>
+#include <utils.h>
+#include <vdso.h>
+
+union vdso_page vdso_page;
+
+/* Keep the compiler from reordering the stores around the sequence counter */
+#define barrier() __asm__ __volatile__("" : : : "memory")
+
+void init_vdso(void) {
+    for (int i = 0; i < PAGE_SIZE; i++) {
+        vdso_page.bytes[i] = 0;
+    }
+    vdso_clock_update();
+}
+
+void vdso_clock_update(void) {
+    vdso_page.data.tsc_khz = tsc_khz;
+    vdso_page.data.ticks_per_second = ticks_per_second();
+    /* A new tick length restarts the running average */
+    vdso_page.data.tsc_per_tick = 0;
+}
+
+void vdso_map(struct task_struct *task) {
+    /* The kernel is identity mapped: the page's address gives its frame */
+    set_user_ro_pag(get_PT(task), VDSO_PAGE, (unsigned long)&vdso_page >> 12);
+}
+
+void vdso_unmap(struct task_struct *master) {
+    /* The frame belongs to the kernel: only drop the mapping */
+    del_ss_pag(get_PT(master), VDSO_PAGE);
+}
+
+void vdso_tick(void) {
+    struct vdso_data *data = &vdso_page.data;
+    unsigned int low, high;
+
+    rdtsc(low, high);
+    (void)high;
+
+    data->seq++;
+    barrier();
+
+    /* Smooth the cycles-per-tick estimate over the last ticks (several if the tick stopped) */
+    if (data->tsc_last_tick != 0 && zeos_ticks != (int)data->ticks) {
+        unsigned int delta = (low - data->tsc_last_tick) / (zeos_ticks - data->ticks);
+        if (data->tsc_per_tick == 0)
+            data->tsc_per_tick = delta;
+        else
+            data->tsc_per_tick = data->tsc_per_tick - data->tsc_per_tick / 8 + delta / 8;
+    }
+    data->tsc_last_tick = low;
+    data->ticks = zeos_ticks;
+
+    barrier();
+    data->seq++;
+}
+
+void vdso_switch_to(struct task_struct *next) {
+    vdso_page.data.pid = next->PID;
+    vdso_page.data.tid = next->TID;
+}
@@ -108,7 +108,7 @@ void test_basic_process_operations(void) {
             write_current_pid();
             msg = "I have been unblocked! Exiting...\n";
             write(1, msg, strlen(msg));
-            exit();
+            exit(0);
         }
 
     } else if (pid > 0) {
@@ -187,6 +187,11 @@ void execute_zeos_tests(void) {
     RESET_ERRNO();
 #endif
 
+#if WAITPID_TEST
+    test_waitpid_syscall();
+    RESET_ERRNO();
+#endif
+
 #if PAGEFAULT_TEST
     msg = "\n--- Testing: PAGE FAULT EXCEPTION ---\n";
     write(1, msg, strlen(msg));
@@ -199,10 +204,14 @@ void execute_zeos_tests(void) {
     // Wait for all child processes to complete before showing summary
     work(3000); // Wait 3 seconds
 
+    // Reap every child that already exited so its task_struct is released
+    while (waitpid(-1, (int *)0, WNOHANG) > 0) {
+    }
+
     print_final_summary();
 
     // Exit the init process (PID 1) after printing summary
-    exit();
+    exit(0);
 }
 
 /****************************************/
@@ -472,7 +481,7 @@ void test_fork_syscall(void) {
         write(1, msg, strlen(msg));
 
         // Child terminates here to avoid interfering with parent summary
-        exit();
+        exit(0);
 
     } else {
         // ======= PARENT PROCESS TESTS =======
@@ -551,7 +560,7 @@ void test_fork_syscall(void) {
             write(1, msg, strlen(msg));
 
             // Second child terminates
-            exit();
+            exit(0);
         } else {
             // Parent - second child created successfully
             write_current_pid();
@@ -605,7 +614,7 @@ void test_exit_syscall(void) {
         write_current_pid();
         msg = "Child process about to exit\n";
         write(1, msg, strlen(msg));
-        exit();
+        exit(0);
         // This should never be reached
         write_current_pid();
         msg = "ERROR: Code after exit() executed!\n";
@@ -652,7 +661,7 @@ void test_block_unblock_syscalls(void) {
 
         // Wait a bit to ensure parent sees the result, then exit
         work(200);
-        exit();
+        exit(0);
     } else if (pid1 > 0) {
         // Parent process
         work(200); // Wait for child to block
@@ -709,7 +718,7 @@ void test_block_unblock_syscalls(void) {
         write_current_pid();
         msg = "Child finishing\n";
         write(1, msg, strlen(msg));
-        exit();
+        exit(0);
     } else if (pid3 > 0) {
         // Parent process
         work(100); // Wait a bit for child to start
@@ -756,6 +765,80 @@ void test_block_unblock_syscalls(void) {
     print_test_result("block/unblock syscalls", passed);
 }
 
+void test_waitpid_syscall(void) {
+    print_test_header("WAITPID SYSCALL");
+
+    subtests_run = 0;
+    subtests_passed = 0;
+    int status;
+
+    // Subtest 1: waitpid for a PID that is not a child must fail with ECHILD
+    msg = "[TEST 1] waitpid() on a non-child PID...\n";
+    write(1, msg, strlen(msg));
+    subtests_run++;
+    RESET_ERRNO();
+    if (waitpid(9999, &status, 0) == -1 && errno == ECHILD) {
+        subtests_passed++;
+        msg = "[TEST 1] PASSED: ECHILD returned\n";
+    } else {
+        msg = "[TEST 1] FAILED: expected ECHILD\n";
+    }
+    write(1, msg, strlen(msg));
+
+    // Subtest 2: blocking waitpid collects the exit code of a child
+    msg = "[TEST 2] Blocking waitpid() collects exit code...\n";
+    write(1, msg, strlen(msg));
+    subtests_run++;
+    int pid = fork();
+    if (pid == 0) {
+        exit(42);
+    }
+    status = -1;
+    if (pid > 0 && waitpid(pid, &status, 0) == pid && status == 42) {
+        subtests_passed++;
+        msg = "[TEST 2] PASSED: child reaped with status 42\n";
+    } else {
+        msg = "[TEST 2] FAILED: wrong PID or status\n";
+    }
+    write(1, msg, strlen(msg));
+
+    // Subtest 3: WNOHANG returns 0 while the child is still running
+    msg = "[TEST 3] WNOHANG on a running child...\n";
+    write(1, msg, strlen(msg));
+    subtests_run++;
+    pid = fork();
+    if (pid == 0) {
+        work(200);
+        exit(7);
+    }
+    int early = waitpid(pid, &status, WNOHANG);
+    status = -1;
+    int reaped = waitpid(pid, &status, 0);
+    if (pid > 0 && early == 0 && reaped == pid && status == 7) {
+        subtests_passed++;
+        msg = "[TEST 3] PASSED: WNOHANG returned 0, then child reaped with status 7\n";
+    } else {
+        msg = "[TEST 3] FAILED: unexpected WNOHANG or reap result\n";
+    }
+    write(1, msg, strlen(msg));
+
+    // Subtest 4: a reaped child cannot be waited for twice
+    msg = "[TEST 4] waitpid() on an already reaped child...\n";
+    write(1, msg, strlen(msg));
+    subtests_run++;
+    RESET_ERRNO();
+    if (waitpid(pid, &status, WNOHANG) == -1 && errno == ECHILD) {
+        subtests_passed++;
+        msg = "[TEST 4] PASSED: ECHILD returned\n";
+    } else {
+        msg = "[TEST 4] FAILED: expected ECHILD\n";
+    }
+    write(1, msg, strlen(msg));
+
+    int passed = (subtests_passed == subtests_run);
+    print_test_result("waitpid() syscall", passed);
+}
+
 /****************************************/
 /**    Helper Functions                **/
 /****************************************/
@@ -901,6 +984,17 @@ void print_final_summary(void) {
     write(1, msg, strlen(msg));
 #endif
 
+#if WAITPID_TEST
+    if (current_test < tests_run) {
+        msg = (current_test < tests_passed) ? "WAITPID_TEST            : PASSED\n"
+                                            : "WAITPID_TEST            : FAILED\n";
+        current_test++;
+    } else {
+        msg = "WAITPID_TEST            : SKIPPED\n";
+    }
+    write(1, msg, strlen(msg));
+#endif
+
 #if PAGEFAULT_TEST
     msg = "PAGEFAULT_TEST          : SKIPPED\n";
     write(1, msg, strlen(msg));